@@ -0,0 +1,20 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace Common {
+    namespace Delta {
+        // Equal bytes shorter than this are kept inside the changed run,
+        // splitting it would cost more than the bytes themselves
+        const size_t MinimumUnchangedRun = 4;
+
+        // Encodes the XOR of two buffers of the same length as a sequence of
+        // (unchanged length, changed length, changed bytes XOR) records with
+        // LEB128 lengths. Buffers that barely differ encode to a few bytes.
+        void encode(const uint8_t *previous, const uint8_t *current, size_t length, std::vector<uint8_t> &output);
+        // XORs an encoded delta back into data, which turns either of the
+        // two original buffers into the other one
+        bool apply(const std::vector<uint8_t> &delta, uint8_t *data, size_t length);
+    };
+};
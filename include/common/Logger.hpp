@@ -14,6 +14,12 @@ namespace Common {
 
         Level levelWithValue(std::string value);
 
+#ifdef TRACE
+        constexpr bool TraceEnabled = true;
+#else
+        constexpr bool TraceEnabled = false;
+#endif
+
         const uint32_t BUFFER_SIZE_LIMIT = 8192;
         const std::filesystem::path filePath = std::filesystem::current_path() / "shinobu.log";
 
@@ -27,6 +33,13 @@ namespace Common {
             Level logLevel();
             void logDebug(const char *fmt, ...) const;
             void logMessage(const char *fmt, ...) const;
+            // Hot path messages, only compiled in builds with the TRACE option
+            template<typename... Args>
+            void logTrace(const char *fmt, Args... args) const {
+                if constexpr (TraceEnabled) {
+                    logMessage(fmt, args...);
+                }
+            };
             void logWarning(const char *fmt, ...) const;
             void logError(const char *fmt, ...) const;
             void flush() const;
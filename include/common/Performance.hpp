@@ -6,6 +6,9 @@ namespace Common {
         struct Frame {
             float averageFrameTime;
             float elapsedTime;
+            float framesPerSecond;
+            float millionInstructionsPerSecond;
+            float audioFillLevel;
         };
     };
 };
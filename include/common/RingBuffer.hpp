@@ -0,0 +1,67 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+namespace Common {
+    namespace Concurrency {
+        // Lock-free ring of trivially copyable elements for exactly one
+        // producer and one consumer thread, moving elements in bulk.
+        template<typename T, size_t Capacity>
+        class RingBuffer {
+            static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+            std::array<T, Capacity> elements;
+            // Written by the consumer only
+            alignas(64) std::atomic<size_t> head;
+            // Written by the producer only
+            alignas(64) std::atomic<size_t> tail;
+
+            void copyIn(size_t position, const T *source, size_t count) {
+                size_t index = position & (Capacity - 1);
+                size_t first = std::min(count, Capacity - index);
+                memcpy(&elements[index], source, first * sizeof(T));
+                memcpy(&elements[0], source + first, (count - first) * sizeof(T));
+            }
+
+            void copyOut(size_t position, T *destination, size_t count) const {
+                size_t index = position & (Capacity - 1);
+                size_t first = std::min(count, Capacity - index);
+                memcpy(destination, &elements[index], first * sizeof(T));
+                memcpy(destination + first, &elements[0], (count - first) * sizeof(T));
+            }
+        public:
+            RingBuffer() : elements(), head(0), tail(0) {}
+
+            // Producer: returns how many elements fit, the rest are dropped
+            size_t write(const T *source, size_t count) {
+                size_t currentTail = tail.load(std::memory_order_relaxed);
+                size_t available = Capacity - (currentTail - head.load(std::memory_order_acquire));
+                count = std::min(count, available);
+                copyIn(currentTail, source, count);
+                tail.store(currentTail + count, std::memory_order_release);
+                return count;
+            }
+
+            // Consumer: returns how many elements were available
+            size_t read(T *destination, size_t count) {
+                size_t currentHead = head.load(std::memory_order_relaxed);
+                size_t available = tail.load(std::memory_order_acquire) - currentHead;
+                count = std::min(count, available);
+                copyOut(currentHead, destination, count);
+                head.store(currentHead + count, std::memory_order_release);
+                return count;
+            }
+
+            size_t size() const {
+                return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+            }
+
+            constexpr size_t capacity() const {
+                return Capacity;
+            }
+        };
+    };
+};
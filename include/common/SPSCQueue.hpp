@@ -0,0 +1,74 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace Common {
+    namespace Concurrency {
+        // Bounded lock-free queue for exactly one producer and one consumer
+        // thread. Elements are written and read in place, so large elements
+        // are never copied in and out of a temporary.
+        template<typename T, size_t Capacity>
+        class SPSCQueue {
+            std::array<T, Capacity> slots;
+            // Written by the consumer only
+            alignas(64) std::atomic<size_t> head;
+            // Written by the producer only
+            alignas(64) std::atomic<size_t> tail;
+        public:
+            SPSCQueue() : slots(), head(0), tail(0) {}
+
+            // Producer: slot to fill next, nullptr when the queue is full
+            T *writeSlot() {
+                size_t currentTail = tail.load(std::memory_order_relaxed);
+                if (currentTail - head.load(std::memory_order_acquire) >= Capacity) {
+                    return nullptr;
+                }
+                return &slots[currentTail % Capacity];
+            }
+
+            // Producer: publishes the slot returned by writeSlot
+            void commitWrite() {
+                tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            bool push(const T &value) {
+                T *slot = writeSlot();
+                if (slot == nullptr) {
+                    return false;
+                }
+                *slot = value;
+                commitWrite();
+                return true;
+            }
+
+            // Consumer: oldest published slot, nullptr when the queue is empty
+            T *readSlot() {
+                size_t currentHead = head.load(std::memory_order_relaxed);
+                if (currentHead == tail.load(std::memory_order_acquire)) {
+                    return nullptr;
+                }
+                return &slots[currentHead % Capacity];
+            }
+
+            // Consumer: releases the slot returned by readSlot
+            void commitRead() {
+                head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            bool pop(T &value) {
+                T *slot = readSlot();
+                if (slot == nullptr) {
+                    return false;
+                }
+                value = *slot;
+                commitRead();
+                return true;
+            }
+
+            size_t size() const {
+                return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+            }
+        };
+    };
+};
@@ -10,8 +10,15 @@ const int TileMapResolution = VRAMTileDataSide * VRAMTileBackgroundMapSide;
 const int HorizontalResolution = 160;
 const int VerticalResolution = 144;
 const int NumberOfSpritesInOAM = 40;
+const int MaximumSpritesPerScanline = 10;
+const int LinePaletteSize = 64;
 const int SampleRate = 44100;
 const int AudioBufferSize = 2048;
+const int AudioRingBufferSize = 8192;
+const int AudioCallbackFrames = 512;
+const double MaximumAudioRateDelta = 0.005;
 const int PerformancePlotPoints = 20;
 const int ClockDataSize = 48;
 const int WRAMBankSize = 0x1000;
+const int MemoryPageSize = 0x100;
+const int MemoryPageCount = 0x100;
@@ -0,0 +1,55 @@
+#pragma once
+#include <cstddef>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Common {
+    namespace Concurrency {
+        // Fixed pool of workers, each with its own deque of jobs. Workers
+        // take their newest job first and steal the oldest job of another
+        // worker once their own deque is empty, which keeps every core busy
+        // when job durations are uneven. Meant for coarse jobs, the deques
+        // are guarded by a mutex each.
+        class ThreadPool {
+            struct Worker {
+                std::mutex mutex;
+                std::deque<std::function<void()>> jobs;
+            };
+
+            std::vector<std::unique_ptr<Worker>> workers;
+            std::vector<std::thread> threads;
+            std::atomic<size_t> nextWorker;
+
+            // Guards the counters below
+            std::mutex stateMutex;
+            std::condition_variable jobAvailable;
+            std::condition_variable jobsFinished;
+            size_t queuedJobs;
+            size_t pendingJobs;
+            bool stopping;
+            // First exception thrown by a job since the last wait()
+            std::exception_ptr error;
+
+            bool popJob(size_t index, std::function<void()> &job);
+            void run(size_t index, bool pinned);
+        public:
+            // Pinning binds worker N to core N, it's a no-op on platforms
+            // without thread affinity support
+            ThreadPool(size_t workerCount, bool pinWorkers);
+            ~ThreadPool();
+
+            void submit(std::function<void()> job);
+            // Blocks until every submitted job has finished, then rethrows
+            // the first exception a job threw, if any
+            void wait();
+            size_t size() const;
+        };
+    };
+};
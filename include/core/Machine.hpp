@@ -0,0 +1,118 @@
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+#include "common/Logger.hpp"
+#include "core/cpu/CPU.hpp"
+#include "core/cpu/Disassembler.hpp"
+#include "core/ROM.hpp"
+#include "core/Memory.hpp"
+#include "core/Scheduler.hpp"
+#include "core/TestResult.hpp"
+#include "core/device/PictureProcessingUnit.hpp"
+#include "core/device/Interrupt.hpp"
+#include "core/device/Timer.hpp"
+#include "core/device/JoypadInput.hpp"
+#include "core/device/Sound.hpp"
+#include "core/device/SerialDataTransfer.hpp"
+#include "core/device/DirectMemoryAccess.hpp"
+#include "core/Palette.hpp"
+
+namespace Core {
+    namespace Machine {
+        struct Configuration {
+            Common::Logs::Level CPULogLevel;
+            Common::Logs::Level memoryLogLevel;
+            Common::Logs::Level ROMLogLevel;
+            Common::Logs::Level PPULogLevel;
+            Common::Logs::Level serialLogLevel;
+            Common::Logs::Level disassemblerLogLevel;
+            Common::Logs::Level interruptLogLevel;
+            Common::Logs::Level timerLogLevel;
+            Common::Logs::Level joypadLogLevel;
+            Common::Logs::Level soundLogLevel;
+            Common::Logs::Level DMALogLevel;
+            bool mute;
+            bool nullAudio;
+            bool overrideCGBFlag;
+            bool correctColors;
+            int paletteIndex;
+            std::filesystem::path DMGBootstrapROM;
+            std::filesystem::path CGBBootstrapROM;
+
+            Configuration() : CPULogLevel(Common::Logs::Level::NoLog),
+                              memoryLogLevel(Common::Logs::Level::NoLog),
+                              ROMLogLevel(Common::Logs::Level::NoLog),
+                              PPULogLevel(Common::Logs::Level::NoLog),
+                              serialLogLevel(Common::Logs::Level::NoLog),
+                              disassemblerLogLevel(Common::Logs::Level::NoLog),
+                              interruptLogLevel(Common::Logs::Level::NoLog),
+                              timerLogLevel(Common::Logs::Level::NoLog),
+                              joypadLogLevel(Common::Logs::Level::NoLog),
+                              soundLogLevel(Common::Logs::Level::NoLog),
+                              DMALogLevel(Common::Logs::Level::NoLog),
+                              mute(true),
+                              nullAudio(false),
+                              overrideCGBFlag(false),
+                              correctColors(false),
+                              paletteIndex(0),
+                              DMGBootstrapROM(),
+                              CGBBootstrapROM() {}
+        };
+
+        // Owns every device of the system without any window, OpenGL context or
+        // audio device, so it can be instantiated headless and in bulk.
+        class Machine {
+            Common::Logs::Logger logger;
+
+            Configuration configuration;
+
+            std::unique_ptr<Core::Palette::Selector> paletteSelector;
+            std::unique_ptr<Core::Scheduler::Scheduler> scheduler;
+            std::unique_ptr<Core::Device::Interrupt::Controller> interrupt;
+            std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> DMA;
+            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> PPU;
+            std::unique_ptr<Core::Device::Sound::Controller> sound;
+            std::unique_ptr<Core::Device::Timer::Controller> timer;
+            std::unique_ptr<Core::Device::JoypadInput::Controller> joypad;
+            std::unique_ptr<Core::Device::SerialDataTransfer::Controller> serial;
+            std::unique_ptr<Core::ROM::Cartridge> cartridge;
+            std::unique_ptr<Core::ROM::BOOT::ROM> bootROM;
+            std::unique_ptr<Core::Memory::Controller> memoryController;
+            std::unique_ptr<Core::CPU::Processor> processor;
+            std::unique_ptr<Core::CPU::Disassembler::Disassembler> disassembler;
+
+            uint32_t frameCycles;
+            uint64_t executedInstructions;
+
+            void endFrame();
+            void saveDevices(Core::SaveState::Writer &writer) const;
+            void loadDevices(Core::SaveState::Reader &reader);
+            void validateDevices(Core::SaveState::Reader &reader) const;
+        public:
+            Machine(Configuration configuration);
+            ~Machine();
+
+            void load(std::filesystem::path ROMFilePath, bool skipBootROM);
+            uint8_t step();
+            void runFrame();
+            Core::TestResult::Result runTest(uint64_t cycleBudget, uint64_t &elapsedCycles);
+            Core::TestResult::Result testResult() const;
+            void saveState(std::vector<uint8_t> &state) const;
+            bool loadState(const std::vector<uint8_t> &state);
+            std::unique_ptr<Machine> fork();
+
+            std::unique_ptr<Core::Palette::Selector> &getPaletteSelector();
+            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &getPPU();
+            std::unique_ptr<Core::Device::Sound::Controller> &getSound();
+            std::unique_ptr<Core::Device::JoypadInput::Controller> &getJoypad();
+            std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &getSerial();
+            std::unique_ptr<Core::ROM::Cartridge> &getCartridge();
+            std::unique_ptr<Core::Memory::Controller> &getMemoryController();
+            std::unique_ptr<Core::CPU::Processor> &getProcessor();
+            std::unique_ptr<Core::CPU::Disassembler::Disassembler> &getDisassembler();
+            uint64_t getExecutedInstructions() const;
+        };
+    };
+};
@@ -4,8 +4,12 @@
 #include <filesystem>
 #include <optional>
 #include <vector>
+#include <array>
 #include <common/Logger.hpp>
 #include <chrono>
+#include "common/System.hpp"
+#include "core/SaveState.hpp"
+#include "core/PagedBuffer.hpp"
 
 namespace Core {
     namespace Device {
@@ -31,6 +35,10 @@ namespace Core {
             class Controller;
         };
     }
+    namespace Scheduler {
+        class Scheduler;
+        struct Event;
+    };
     namespace ROM {
         class Cartridge;
         namespace BOOT {
@@ -101,18 +109,60 @@ namespace Core {
 
         const Core::Memory::Range SVBKRegisterRange = Core::Memory::Range(0xFF70, 0x1);
 
+        enum IORegisterHandler : uint8_t {
+            UnhandledRegister,
+            JoypadRegister,
+            SerialRegister,
+            LCDRegister,
+            VBKRegister,
+            HDMARegister,
+            ColorPaletteRegister,
+            BootROMLockRegister,
+            InterruptFlagRegister,
+            TimerRegister,
+            SoundRegister,
+            SVBKRegister,
+            KEY1Register,
+        };
+
+        struct IORegister {
+            IORegisterHandler handler;
+            uint8_t offset;
+
+            IORegister() : handler(IORegisterHandler::UnhandledRegister), offset() {}
+            IORegister(IORegisterHandler handler, uint8_t offset) : handler(handler), offset(offset) {}
+        };
+
+        // Backing storage for a mapped page, version is bumped on every store
+        // and is nullptr for read only memory.
+        struct MemoryPage {
+            const uint8_t *data;
+            const uint32_t *version;
+        };
+
+        enum BankControllerType : uint8_t {
+            ROMBankController,
+            MBC1BankController,
+            MBC3BankController,
+            MBC5BankController,
+        };
+
+        // Bank controllers aren't dispatched through virtual functions, the
+        // slow path switches on the type so each MBC implementation gets
+        // inlined into the memory controller.
         class BankController {
         protected:
             Common::Logs::Logger logger;
 
+            const BankControllerType type;
             std::unique_ptr<Core::ROM::Cartridge> &cartridge;
             std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM;
-            std::vector<uint8_t> WRAMBank;
-            std::unique_ptr<Core::Device::SerialDataTransfer::Controller> serialCommController;
+            PagedBuffer WRAMBank;
+            std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController;
             std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU;
             std::unique_ptr<Core::Device::Sound::Controller> &sound;
             std::array<uint8_t, 0x7F> HRAM;
-            std::vector<uint8_t> externalRAM;
+            PagedBuffer externalRAM;
             std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt;
             std::unique_ptr<Core::Device::Timer::Controller> &timer;
             std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad;
@@ -122,43 +172,97 @@ namespace Core {
 
             SpeedSwitch::KEY1 _KEY1;
 
+            // One entry per high address byte, nullptr entries go through
+            // loadSlow/storeSlow (banking registers, VRAM, OAM and I/O).
+            std::array<const uint8_t *, MemoryPageCount> loadPages;
+            std::array<uint8_t *, MemoryPageCount> storePages;
+            std::array<const uint32_t *, MemoryPageCount> loadVersions;
+            std::array<uint32_t *, MemoryPageCount> storeVersions;
+            std::vector<uint32_t> WRAMVersions;
+            std::vector<uint32_t> externalRAMVersions;
+            std::array<IORegister, 0x80> IORegisters;
+            bool bootROMMapped;
+
+            void mapPages(uint16_t address, uint16_t length, const uint8_t *source);
+            void mapPages(uint16_t address, uint16_t length, PagedBuffer &buffer, uint32_t physicalAddress, uint32_t *versions);
+            void unmapPages(uint16_t address, uint16_t length);
+            void mapROMPages(uint16_t address, uint32_t physicalAddress);
+            void mapExternalRAMPages(bool loadEnabled, bool storeEnabled, uint32_t physicalAddress);
+            void mapWRAMPages();
+            uint8_t *writablePage(PagedBuffer &buffer, uint32_t physicalAddress, uint32_t *versions);
+            void remapPage(const uint32_t *version, uint8_t *page);
+            void updateBankedPages();
+            void storeWRAM(uint32_t physicalAddress, uint8_t value);
+            void storeExternalRAM(uint32_t physicalAddress, uint8_t value);
+            uint8_t loadIORegister(uint16_t address) const;
+            void storeIORegister(uint16_t address, uint8_t value);
             uint8_t loadInternal(uint16_t address) const;
             void storeInternal(uint16_t address, uint8_t value);
+            uint8_t loadSlow(uint16_t address) const;
+            void storeSlow(uint16_t address, uint8_t value);
         public:
             BankController(Common::Logs::Level logLevel,
+                           BankControllerType type,
                            std::unique_ptr<Core::ROM::Cartridge> &cartridge,
                            std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                           std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                            std::unique_ptr<Core::Device::Sound::Controller> &sound,
                            std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                            std::unique_ptr<Core::Device::Timer::Controller> &timer,
                            std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
                            std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA);
-            ~BankController();
+            virtual ~BankController();
 
             void loadExternalRAMFromSaveFile();
             void saveExternalRAM();
-            virtual uint8_t load(uint16_t address) const = 0;
-            virtual void store(uint16_t address, uint8_t value) = 0;
+            uint8_t load(uint16_t address) const {
+                const uint8_t *page = loadPages[address >> 8];
+                if (page != nullptr) {
+                    return page[address & 0xFF];
+                }
+                return loadSlow(address);
+            }
+            void store(uint16_t address, uint8_t value) {
+                uint8_t *page = storePages[address >> 8];
+                if (page != nullptr) {
+                    page[address & 0xFF] = value;
+                    (*storeVersions[address >> 8])++;
+                    return;
+                }
+                storeSlow(address, value);
+            }
+            MemoryPage loadPage(uint16_t address) const {
+                return { loadPages[address >> 8], loadVersions[address >> 8] };
+            }
+            bool isBootROMMapped() const { return bootROMMapped; }
             void handleSpeedSwitch();
             SpeedSwitch::Speed currentSpeed() const;
+            void saveState(Core::SaveState::Writer &writer) const;
+            void loadState(Core::SaveState::Reader &reader);
+            void validateState(Core::SaveState::Reader &reader) const;
+            void copyState(const BankController &other);
+            void shareMemory(BankController &other);
         };
 
         namespace ROM {
             const Range ROMRange = Range(0x0, 0x8000);
-            class Controller : public BankController {
+            class Controller final : public BankController {
+                void updateROMPages();
             public:
                 Controller(Common::Logs::Level logLevel,
                            std::unique_ptr<Core::ROM::Cartridge> &cartridge,
                            std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                           std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                            std::unique_ptr<Core::Device::Sound::Controller> &sound,
                            std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                            std::unique_ptr<Core::Device::Timer::Controller> &timer,
                            std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
-                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : BankController(logLevel, cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA) {};
-                uint8_t load(uint16_t address) const override;
-                void store(uint16_t address, uint8_t value) override;
+                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : BankController(logLevel, BankControllerType::ROMBankController, cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA) { updateROMPages(); };
+                uint8_t loadBanked(uint16_t address) const;
+                void storeBanked(uint16_t address, uint8_t value);
+                void updatePages();
             };
         };
 
@@ -209,23 +313,32 @@ namespace Core {
                 Mode() : _value() {}
             };
 
-            class Controller : public BankController {
+            class Controller final : public BankController {
                 RAMG _RAMG;
                 BANK1 _BANK1;
                 BANK2 _BANK2;
                 Mode mode;
+
+                void updateROMPages();
+                void updateExternalRAMPages();
             public:
                 Controller(Common::Logs::Level logLevel,
                            std::unique_ptr<Core::ROM::Cartridge> &cartridge,
                            std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                           std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                            std::unique_ptr<Core::Device::Sound::Controller> &sound,
                            std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                            std::unique_ptr<Core::Device::Timer::Controller> &timer,
                            std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
-                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : BankController(logLevel, cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA) {};
-                uint8_t load(uint16_t address) const override;
-                void store(uint16_t address, uint8_t value) override;
+                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : BankController(logLevel, BankControllerType::MBC1BankController, cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA) { updateROMPages(); updateExternalRAMPages(); };
+                uint8_t loadBanked(uint16_t address) const;
+                void storeBanked(uint16_t address, uint8_t value);
+                void updatePages();
+                void saveBankingState(Core::SaveState::Writer &writer) const;
+                void loadBankingState(Core::SaveState::Reader &reader);
+                void validateBankingState(Core::SaveState::Reader &reader) const;
+                void copyBankingState(const Controller &other);
             };
         };
 
@@ -268,7 +381,7 @@ namespace Core {
                 RTCDH() : _value() {}
             };
 
-            class Controller : public BankController {
+            class Controller final : public BankController {
                 MBC1::RAMG _RAMG;
                 ROMBANK _ROMBANK;
                 RAMBANK _RAMBANK_RTCRegister;
@@ -283,23 +396,31 @@ namespace Core {
                 bool hasRTC;
 
                 void calculateTime(bool overrideHalt = false);
+                void updateROMPages();
+                void updateExternalRAMPages();
             public:
                 Controller(Common::Logs::Level logLevel,
                            std::unique_ptr<Core::ROM::Cartridge> &cartridge,
                            std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                           std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                            std::unique_ptr<Core::Device::Sound::Controller> &sound,
                            std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                            std::unique_ptr<Core::Device::Timer::Controller> &timer,
                            std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
-                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA, bool hasRTC) : BankController(logLevel, cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA),
-                            _RAMG(), _ROMBANK(), _RAMBANK_RTCRegister(), latchClockData(), _RTCS(), _RTCM(), _RTCH(), _RTCDL(), _RTCDH(), lastTimePoint(std::chrono::system_clock::now()), calculationRemainder(), hasRTC(hasRTC) {};
-                uint8_t load(uint16_t address) const override;
-                void store(uint16_t address, uint8_t value) override;
+                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA, bool hasRTC) : BankController(logLevel, BankControllerType::MBC3BankController, cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA),
+                            _RAMG(), _ROMBANK(), _RAMBANK_RTCRegister(), latchClockData(), _RTCS(), _RTCM(), _RTCH(), _RTCDL(), _RTCDH(), lastTimePoint(std::chrono::system_clock::now()), calculationRemainder(), hasRTC(hasRTC) { updateROMPages(); updateExternalRAMPages(); };
+                uint8_t loadBanked(uint16_t address) const;
+                void storeBanked(uint16_t address, uint8_t value);
+                void updatePages();
 
                 // http://bgb.bircd.org/rtcsave.html
                 std::vector<uint8_t> clockData();
                 void loadClockData(std::vector<uint8_t> clockData);
+                void saveBankingState(Core::SaveState::Writer &writer) const;
+                void loadBankingState(Core::SaveState::Reader &reader);
+                void validateBankingState(Core::SaveState::Reader &reader) const;
+                void copyBankingState(const Controller &other);
             };
         };
 
@@ -329,23 +450,32 @@ namespace Core {
                 RAMB() : _value() {}
             };
 
-            class Controller : public BankController {
+            class Controller final : public BankController {
                 uint8_t RAMG;
                 uint8_t ROMB0;
                 ROMB1 _ROMB1;
                 RAMB _RAMB;
+
+                void updateROMPages();
+                void updateExternalRAMPages();
             public:
                 Controller(Common::Logs::Level logLevel,
                            std::unique_ptr<Core::ROM::Cartridge> &cartridge,
                            std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                           std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                            std::unique_ptr<Core::Device::Sound::Controller> &sound,
                            std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                            std::unique_ptr<Core::Device::Timer::Controller> &timer,
                            std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
-                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : BankController(logLevel, cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA), RAMG(), ROMB0(0x1), _ROMB1() {};
-                uint8_t load(uint16_t address) const override;
-                void store(uint16_t address, uint8_t value) override;
+                           std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : BankController(logLevel, BankControllerType::MBC5BankController, cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA), RAMG(), ROMB0(0x1), _ROMB1(), _RAMB() { updateROMPages(); updateExternalRAMPages(); };
+                uint8_t loadBanked(uint16_t address) const;
+                void storeBanked(uint16_t address, uint8_t value);
+                void updatePages();
+                void saveBankingState(Core::SaveState::Writer &writer) const;
+                void loadBankingState(Core::SaveState::Reader &reader);
+                void validateBankingState(Core::SaveState::Reader &reader) const;
+                void copyBankingState(const Controller &other);
             };
         };
 
@@ -354,37 +484,51 @@ namespace Core {
 
             std::unique_ptr<Core::ROM::Cartridge> &cartridge;
             std::unique_ptr<BankController> bankController;
-            std::unique_ptr<Core::ROM::BOOT::ROM> bootROM;
+            std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM;
+            std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController;
             std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU;
             std::unique_ptr<Core::Device::Sound::Controller> &sound;
             std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt;
             std::unique_ptr<Core::Device::Timer::Controller> &timer;
             std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad;
             std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA;
+            std::unique_ptr<Core::Scheduler::Scheduler> &scheduler;
 
             uint8_t cyclesCurrentInstruction;
+
+            void handleEvent(Core::Scheduler::Event event);
+            void createBankController();
         public:
             Controller(Common::Logs::Level logLevel,
                        std::unique_ptr<Core::ROM::Cartridge> &cartridge,
+                       std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                       std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                        std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                        std::unique_ptr<Core::Device::Sound::Controller> &sound,
                        std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                        std::unique_ptr<Core::Device::Timer::Controller> &timer,
                        std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
-                       std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA);
+                       std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA,
+                       std::unique_ptr<Core::Scheduler::Scheduler> &scheduler);
             ~Controller();
 
             void initialize(bool skipBootROM);
+            void shareMemory(Controller &other);
             bool hasBootROM() const;
             void saveExternalRAM() const;
             uint8_t load(uint16_t address, bool shouldStep = true, bool hasPriority = false);
             void store(uint16_t address, uint8_t value, bool shouldStep = true, bool hasPriority = false);
             uint16_t loadDoubleWord(uint16_t address, bool shouldStep = true);
             void storeDoubleWord(uint16_t address, uint16_t value, bool shouldStep = true);
+            MemoryPage instructionPage(uint16_t address) const;
             void beginCurrentInstruction();
             void step(uint8_t cycles);
             uint8_t elapsedCycles() const;
             void handleSpeedSwitch();
+            void saveState(Core::SaveState::Writer &writer) const;
+            void loadState(Core::SaveState::Reader &reader);
+            void validateState(Core::SaveState::Reader &reader) const;
+            void copyState(const Controller &other);
         };
     };
 };
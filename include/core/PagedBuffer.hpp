@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <memory>
+#include <vector>
+#include "common/System.hpp"
+#include "core/SaveState.hpp"
+
+namespace Core {
+    namespace Memory {
+        typedef std::array<uint8_t, MemoryPageSize> Page;
+
+        // Guest memory split in pages which copies of the buffer share until
+        // one of them writes, the writer then gets a private copy of the page.
+        // Untouched pages share a single zeroed page, so allocating a buffer
+        // only allocates its page table. Pages of a buffer must only be
+        // written from the thread that owns it.
+        class PagedBuffer {
+            std::vector<std::shared_ptr<Page>> pages;
+            std::vector<uint8_t *> pageData;
+        public:
+            PagedBuffer();
+            PagedBuffer(size_t length);
+            ~PagedBuffer();
+
+            void resize(size_t length);
+            size_t size() const { return pages.size() * MemoryPageSize; }
+            uint8_t operator[](size_t offset) const { return pageData[offset / MemoryPageSize][offset % MemoryPageSize]; }
+            const uint8_t *page(size_t index) const { return pageData[index]; }
+            bool isShared(size_t index) const { return pages[index].use_count() > 1; }
+            // Copies the page first when it's shared, which moves its data
+            uint8_t *writablePage(size_t index);
+            void store(size_t offset, uint8_t value) { writablePage(offset / MemoryPageSize)[offset % MemoryPageSize] = value; }
+            void read(uint8_t *destination, size_t length) const;
+            void write(const uint8_t *source, size_t length);
+            void saveState(Core::SaveState::Writer &writer) const;
+            void loadState(Core::SaveState::Reader &reader);
+            void validateState(Core::SaveState::Reader &reader) const;
+        };
+    };
+};
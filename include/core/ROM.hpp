@@ -4,8 +4,10 @@
 #include <fstream>
 #include <vector>
 #include <array>
+#include <memory>
 #include "core/Memory.hpp"
 #include "common/Logger.hpp"
+#include "core/SaveState.hpp"
 
 namespace Core {
     const uint16_t HEADER_START_ADDRESS = 0x100;
@@ -36,8 +38,10 @@ namespace Core {
                 Lock lockRegister;
                 std::vector<uint8_t> data;
                 bool initialized;
+                std::filesystem::path DMGBootstrapROMFilePath;
+                std::filesystem::path CGBBootstrapROMFilePath;
             public:
-                ROM(Common::Logs::Level logLevel);
+                ROM(Common::Logs::Level logLevel, std::filesystem::path DMGBootstrapROMFilePath, std::filesystem::path CGBBootstrapROMFilePath);
                 ~ROM();
 
                 void initialize(bool skip, Core::ROM::CGBFlag cgbFlag);
@@ -46,6 +50,10 @@ namespace Core {
                 bool hasBootROM() const;
                 uint8_t loadLockRegister() const;
                 void storeLockRegister(uint8_t value);
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void share(const ROM &other);
             };
         };
 
@@ -159,7 +167,8 @@ namespace Core {
             Common::Logs::Logger logger;
 
             std::filesystem::path filePath;
-            std::vector<uint8_t> memory;
+            // Immutable once opened, forked machines share it
+            std::shared_ptr<const std::vector<uint8_t>> memory;
             Header header;
             bool shouldOverrideCGBFlag;
         public:
@@ -167,17 +176,21 @@ namespace Core {
             ~Cartridge();
 
             void open(std::filesystem::path &filePath);
+            void share(const Cartridge &other);
             bool isOpen() const;
             bool hasBattery() const;
             bool hasRTC() const;
             bool hasRAM() const;
             std::filesystem::path saveFilePath() const;
             std::filesystem::path disassemblyFilePath() const;
+            std::filesystem::path saveStateFilePath() const;
             uint8_t load(uint32_t address) const;
+            const uint8_t *pageAt(uint32_t address) const;
             uint32_t RAMSize() const;
             uint32_t ROMSize() const;
             Type type() const;
             CGBFlag cgbFlag() const;
+            const Header &getHeader() const;
         };
     }
 }
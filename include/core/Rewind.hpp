@@ -0,0 +1,45 @@
+#pragma once
+#include <cstdint>
+#include <deque>
+#include <vector>
+#include "common/Logger.hpp"
+#include "core/Machine.hpp"
+
+namespace Core {
+    namespace Rewind {
+        // Older state, stored as its delta against the next newer one
+        struct Snapshot {
+            std::vector<uint8_t> delta;
+            uint32_t size;
+        };
+
+        // Keeps the newest save state in full and every older one as a delta
+        // against its successor, so the oldest snapshots can be dropped first
+        // when the memory budget is exceeded.
+        class Buffer {
+            Common::Logs::Logger logger;
+
+            uint32_t interval;
+            size_t capacity;
+            uint32_t frames;
+            std::vector<uint8_t> current;
+            std::vector<uint8_t> captured;
+            std::vector<uint8_t> encoded;
+            std::deque<Snapshot> snapshots;
+            size_t memoryUsage;
+
+            void capture(Core::Machine::Machine &machine);
+        public:
+            Buffer(Common::Logs::Level logLevel, uint32_t interval, size_t capacity);
+            ~Buffer();
+
+            // Called once per emulated frame, snapshots every interval frames
+            void frame(Core::Machine::Machine &machine);
+            // Loads the newest snapshot and drops it, false when none is left
+            bool rewind(Core::Machine::Machine &machine);
+            void clear();
+            size_t size() const;
+            size_t usedMemory() const;
+        };
+    };
+};
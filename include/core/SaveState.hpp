@@ -0,0 +1,96 @@
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <array>
+#include <stdexcept>
+#include <type_traits>
+
+namespace Core {
+    namespace SaveState {
+        // "SHST"
+        const uint32_t Magic = 0x54534853;
+        // Bumped on every change to the layout of any device state
+        const uint16_t Version = 3;
+
+        struct Header {
+            uint32_t magic;
+            uint16_t version;
+            uint8_t cgbFlag;
+            uint8_t title[0x10];
+            uint8_t globalChecksum[2];
+            uint32_t size;
+        };
+
+        // Device state is appended as raw memory, it's only meant to be
+        // loaded back by the same build on the same host.
+        class Writer {
+            std::vector<uint8_t> &buffer;
+        public:
+            Writer(std::vector<uint8_t> &buffer) : buffer(buffer) {}
+
+            void writeBytes(const void *source, size_t size) {
+                size_t position = buffer.size();
+                buffer.resize(position + size);
+                memcpy(buffer.data() + position, source, size);
+            }
+
+            template<typename T>
+            void write(const T &value) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable state can be written");
+                writeBytes(&value, sizeof(T));
+            }
+
+            size_t size() const { return buffer.size(); }
+        };
+
+        class Reader {
+            const uint8_t *data;
+            size_t size;
+            size_t position;
+        public:
+            Reader(const std::vector<uint8_t> &buffer) : data(buffer.data()), size(buffer.size()), position(0) {}
+
+            void readBytes(void *destination, size_t length) {
+                if ((position + length) > size) {
+                    throw std::runtime_error("Truncated save state");
+                }
+                memcpy(destination, data + position, length);
+                position += length;
+            }
+
+            // Validation passes only check that the state is long enough
+            void skipBytes(size_t length) {
+                if ((position + length) > size) {
+                    throw std::runtime_error("Truncated save state");
+                }
+                position += length;
+            }
+
+            template<typename T>
+            void read(T &value) {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable state can be read");
+                readBytes(&value, sizeof(T));
+            }
+
+            template<typename T>
+            T read() {
+                T value;
+                read(value);
+                return value;
+            }
+
+            // Element counts come from the file, a count that can't fit in
+            // what's left is rejected before anything gets allocated
+            uint32_t readCount(size_t elementSize) {
+                uint32_t count = read<uint32_t>();
+                if (count > (remaining() / elementSize)) {
+                    throw std::runtime_error("Corrupted save state");
+                }
+                return count;
+            }
+
+            size_t remaining() const { return size - position; }
+        };
+    };
+};
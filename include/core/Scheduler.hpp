@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "common/Logger.hpp"
+#include "core/SaveState.hpp"
+
+namespace Core {
+    namespace Scheduler {
+        enum EventType : uint8_t {
+            TimerOverflow,
+            DMATransfer,
+        };
+
+        struct Event {
+            uint64_t timestamp;
+            EventType type;
+        };
+
+        // Keeps the emulated clock and a min-heap of device events ordered by
+        // timestamp, so devices only run when something observable happens.
+        class Scheduler {
+            Common::Logs::Logger logger;
+
+            uint64_t timestamp;
+            std::vector<Event> events;
+        public:
+            Scheduler(Common::Logs::Level logLevel);
+            ~Scheduler();
+
+            uint64_t currentTimestamp() const { return timestamp; };
+            void advance(uint8_t cycles) { timestamp += cycles; };
+            bool hasPendingEvent() const { return !events.empty() && events.front().timestamp <= timestamp; };
+            Event popEvent();
+            void schedule(EventType type, uint64_t eventTimestamp);
+            void cancel(EventType type);
+            void saveState(Core::SaveState::Writer &writer) const;
+            void loadState(Core::SaveState::Reader &reader);
+            void validateState(Core::SaveState::Reader &reader) const;
+            void copyState(const Scheduler &other);
+        };
+    };
+};
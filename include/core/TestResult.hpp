@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+namespace Core {
+    namespace TestResult {
+        // Outcome reported by a test ROM, Blargg's through the serial port
+        // and Mooneye's through the registers after LD B,B
+        enum Result : uint8_t {
+            Running = 0,
+            Passed = 1,
+            Failed = 2,
+            Timeout = 3,
+        };
+    };
+};
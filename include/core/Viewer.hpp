@@ -0,0 +1,16 @@
+#pragma once
+#include "core/Palette.hpp"
+
+namespace Core {
+    namespace Viewer {
+        // Colored points the debug viewers are drawn from
+        struct Point {
+            float x, y;
+        };
+
+        struct Vertex {
+            Point position;
+            Core::Palette::Color color;
+        };
+    };
+};
@@ -1,13 +1,15 @@
 #pragma once
 #include <cstdint>
-#include <functional>
 #include <memory>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 #include "core/Memory.hpp"
 #include "core/cpu/Instructions.hpp"
 #include "common/Logger.hpp"
 #include "core/device/Interrupt.hpp"
+#include "core/SaveState.hpp"
+#include "core/TestResult.hpp"
 
 namespace Core {
     namespace CPU {
@@ -90,6 +92,18 @@ namespace Core {
             Registers() : _value16() {} ;
         };
 
+        // Straight-line code pre-decoded from a single memory page. Blocks are
+        // keyed by the address of their first opcode in the backing storage,
+        // so switching banks never aliases and RAM mirrors share entries.
+        struct Block {
+            const uint8_t *page;
+            const uint32_t *version;
+            uint32_t decodedVersion;
+            std::vector<Instructions::DecodedInstruction> instructions;
+
+            bool isValid() const { return version == nullptr || *version == decodedVersion; }
+        };
+
         class Processor {
             friend class Disassembler::Disassembler;
 
@@ -101,153 +115,301 @@ namespace Core {
 
             bool shouldSetIME;
             bool halted;
+            Core::TestResult::Result result;
+
+            std::unordered_map<const uint8_t *, Block> blocks;
+            Block *currentBlock;
+            uint16_t currentBlockIndex;
+            Instructions::DecodedInstruction uncachedInstruction;
+
             void setIME(bool value);
+            void checkTestResult();
 
             void pushIntoStack(uint16_t value);
             uint16_t popFromStack();
             void advanceProgramCounter(Instructions::Instruction instruction);
+            Block &findBlock(Memory::MemoryPage page, uint8_t offset);
+            void decodeBlock(Block &block, Memory::MemoryPage page, uint8_t offset) const;
+            const Instructions::DecodedInstruction &fetchUncachedInstruction();
+            template<uint8_t Opcode, bool Prefixed = false>
+            void advanceProgramCounter();
 
             std::string disassembleArithmetic(Instructions::Instruction instruction, std::string operation);
-            uint8_t executeArithmetic(Instructions::Instruction instruction, std::function<std::tuple<uint8_t, Flag>(uint8_t,uint8_t)> operation, bool useAccumulator = true);
+            template<uint8_t Opcode, bool UseAccumulator = true, typename Operation>
+            void executeArithmetic(Operation operation);
 
             template<typename T>
-            friend T CPU::Instructions::NOP(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::NOP(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::JP_U16(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::JP_U16(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::DI(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::DI(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_RR_NN(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_RR_NN(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RST_N(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RST_N(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::INC_R(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::INC_R(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RET(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RET(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_NN_A(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_NN_A(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_U8(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_U8(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LDH_N_A(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LDH_N_A(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::DEC_RR(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::DEC_RR(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::CALL_NN(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::CALL_NN(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_R_R(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_R_R(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::JR_I8(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::JR_I8(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_INDIRECT(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_INDIRECT(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::PUSH_RR(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::PUSH_RR(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::POP_RR(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::POP_RR(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::INC_RR(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::INC_RR(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::EI(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::EI(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::OR(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::OR(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::JR_CC_I8(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::JR_CC_I8(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::STOP(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::STOP(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::CALL_CC_NN(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::CALL_CC_NN(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::ADD(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::ADD(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_NN_SP(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_NN_SP(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RLCA(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RLCA(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_A_NN(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_A_NN(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SBC_A(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SBC_A(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::DEC_R(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::DEC_R(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::XOR_A(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::XOR_A(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::ADC_A(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::ADC_A(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::JP_HL(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::JP_HL(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RRA(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RRA(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RET_CC(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RET_CC(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RLC(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RLC(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::CP_A(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::CP_A(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LDH_A_N(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LDH_A_N(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::BIT(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::BIT(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LDH_C_A(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LDH_C_A(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LDH_A_C(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LDH_A_C(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RL(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RL(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RLA(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RLA(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SUB(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SUB(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::AND(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::AND(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SET(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SET(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::ADD_HL_RR(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::ADD_HL_RR(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RES(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RES(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SRA(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SRA(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SWAP(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SWAP(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::JP_CC_NN(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::JP_CC_NN(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_HL_SP_I8(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_HL_SP_I8(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SLA(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SLA(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RR(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RR(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RRC(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RRC(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::LD_SP_HL(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::LD_SP_HL(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::ADD_SP_I8(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::ADD_SP_I8(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RETI(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RETI(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::DAA(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::DAA(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::CPL(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::CPL(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SCF(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SCF(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::CCF(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::CCF(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::RRCA(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::RRCA(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::SRL(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::SRL(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::HALT(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::HALT(Processor &processor, Instructions::Instruction instruction);
             template<typename T>
-            friend T CPU::Instructions::HALTED(std::unique_ptr<Processor> &processor, Instructions::Instruction instruction);
+            friend T CPU::Instructions::HALTED(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::NOP(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::JP_U16(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::DI(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_RR_NN(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RST_N(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::INC_R(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RET(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_NN_A(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_U8(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LDH_N_A(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::DEC_RR(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::CALL_NN(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_R_R(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::JR_I8(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_INDIRECT(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::PUSH_RR(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::POP_RR(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::INC_RR(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::EI(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::OR(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::JR_CC_I8(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::STOP(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::CALL_CC_NN(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::ADD(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_NN_SP(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RLCA(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_A_NN(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SBC_A(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::DEC_R(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::XOR_A(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::ADC_A(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::JP_HL(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RRA(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RET_CC(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RLC(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::CP_A(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LDH_A_N(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::BIT(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LDH_C_A(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LDH_A_C(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RL(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RLA(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SUB(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::AND(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SET(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::ADD_HL_RR(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RES(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SRA(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SWAP(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::JP_CC_NN(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_HL_SP_I8(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SLA(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RR(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RRC(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::LD_SP_HL(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::ADD_SP_I8(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RETI(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::DAA(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::CPL(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SCF(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::CCF(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::RRCA(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::SRL(Processor &processor, Instructions::Instruction instruction);
+            template<uint8_t Opcode>
+            friend void CPU::Instructions::HALT(Processor &processor, Instructions::Instruction instruction);
         public:
             Processor(Common::Logs::Level logLevel, std::unique_ptr<Memory::Controller> &memory, std::unique_ptr<Device::Interrupt::Controller> &interrupt);
             ~Processor();
 
             void initialize();
             Instructions::Instruction fetchInstruction() const;
+            const Instructions::DecodedInstruction &fetchDecodedInstruction();
             void checkPendingInterrupts(Instructions::Instruction lastInstruction);
             void executeInterrupt(Device::Interrupt::Interrupt interrupt);
+            void saveState(Core::SaveState::Writer &writer) const;
+            void loadState(Core::SaveState::Reader &reader);
+            void validateState(Core::SaveState::Reader &reader) const;
+            void copyState(const Processor &other);
+            Core::TestResult::Result testResult() const;
 
             template<typename T>
             Instructions::InstructionHandler<T> decodeInstruction(Instructions::Instruction instruction) const;
@@ -1,227 +1,274 @@
 #pragma once
 #include "core/cpu/CPU.hpp"
 #include "core/cpu/Decoding.hpp"
-#include <bitset>
 
 using namespace Core::CPU;
 
-template<>
-void Instructions::NOP(std::unique_ptr<Core::CPU::Processor> &processor, Instruction instruction) {
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode, bool Prefixed>
+void Processor::advanceProgramCounter() {
+    if constexpr (Prefixed) {
+        registers.pc += 2;
+    } else {
+        static_assert(Instructions::InstructionSizeTable[Opcode] != 0, "Invalid instruction length");
+        registers.pc += Instructions::InstructionSizeTable[Opcode];
+    }
 }
 
-template<>
-void Instructions::JP_U16(std::unique_ptr<Processor> &processor, Instruction instruction) {
+template<uint8_t Opcode, bool UseAccumulator, typename Operation>
+void Processor::executeArithmetic(Operation operation) {
+    using Code = Instructions::StaticCode<Opcode>;
+    static_assert(Code::x == 2 || Code::x == 3, "Invalid instruction decoding");
+    advanceProgramCounter<Opcode>();
+    uint8_t operand;
+    if constexpr (Code::x == 2) {
+        constexpr uint8_t R = Instructions::RTable[Code::z];
+        if constexpr (R != 0xFF) {
+            operand = registers._value8[R];
+        } else {
+            operand = memory->load(registers.hl);
+        }
+    } else {
+        operand = memory->load(registers.pc - 1); // PC is already at next instruction
+    }
+    uint8_t result;
+    Flag flags;
+    std::tie(result, flags) = operation(registers.a, operand);
+    if constexpr (UseAccumulator) {
+        registers.a = result;
+    }
+    registers.flag = flags;
+}
+
+template<uint8_t Opcode>
+void Instructions::NOP(Core::CPU::Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t destinaton = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    processor->memory->step(4);
-    processor->registers.pc = destinaton;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::DI(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->setIME(false);
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::JP_U16(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t destinaton = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    processor.memory->step(4);
+    processor.registers.pc = destinaton;
 }
 
-template<>
-void Instructions::LD_RR_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t RR = Instructions::RPTable[instruction.code.p];
-    uint16_t value = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    processor->registers._value16[RR] = value;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::DI(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.setIME(false);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::RST_N(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t N = instruction.code.y * 8;
-    processor->memory->step(4);
-    processor->pushIntoStack(processor->registers.pc + 1);
-    processor->registers.pc = N;
+template<uint8_t Opcode>
+void Instructions::LD_RR_NN(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t RR = Instructions::RPTable[StaticCode<Opcode>::p];
+    uint16_t value = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    processor.registers._value16[RR] = value;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::INC_R(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.y];
+template<uint8_t Opcode>
+void Instructions::RST_N(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t N = StaticCode<Opcode>::y * 8;
+    processor.memory->step(4);
+    processor.pushIntoStack(processor.registers.pc + 1);
+    processor.registers.pc = N;
+}
+
+template<uint8_t Opcode>
+void Instructions::INC_R(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::y];
     uint8_t augend;
     uint8_t addend = 1;
     uint8_t result;
-    if (R != 0xFF) {
-        augend = processor->registers._value8[R];
+    if constexpr (R != 0xFF) {
+        augend = processor.registers._value8[R];
     } else {
-        augend = processor->memory->load(processor->registers.hl);
+        augend = processor.memory->load(processor.registers.hl);
     }
     result = augend + addend;
-    processor->registers.flag.calculateZero(result);
-    processor->registers.flag.n = 0;
-    processor->registers.flag.calculateAdditionHalfCarry(augend, addend, 0x0);
-    if (R != 0xFF) {
-        processor->registers._value8[R] = result;
+    processor.registers.flag.calculateZero(result);
+    processor.registers.flag.n = 0;
+    processor.registers.flag.calculateAdditionHalfCarry(augend, addend, 0x0);
+    if constexpr (R != 0xFF) {
+        processor.registers._value8[R] = result;
     } else {
-        processor->memory->store(processor->registers.hl, result);
+        processor.memory->store(processor.registers.hl, result);
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::RET(std::unique_ptr<Processor> &processor, Instruction instruction) {
+template<uint8_t Opcode>
+void Instructions::RET(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t address = processor->popFromStack();
-    processor->memory->step(4);
-    processor->registers.pc = address;
+    uint16_t address = processor.popFromStack();
+    processor.memory->step(4);
+    processor.registers.pc = address;
 }
 
-template<>
-void Instructions::LD_NN_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    processor->memory->store(address, processor->registers.a);
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::LD_NN_A(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    processor.memory->store(address, processor.registers.a);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::LD_U8(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.y];
-    uint8_t value = processor->memory->load(processor->registers.pc + 1);
-    if (R != 0xFF) {
-        processor->registers._value8[R] = value;
+template<uint8_t Opcode>
+void Instructions::LD_U8(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::y];
+    uint8_t value = processor.memory->load(processor.registers.pc + 1);
+    if constexpr (R != 0xFF) {
+        processor.registers._value8[R] = value;
     } else {
-        processor->memory->store(processor->registers.hl, value);
+        processor.memory->store(processor.registers.hl, value);
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::LDH_N_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t value = processor->memory->load(processor->registers.pc + 1);
+template<uint8_t Opcode>
+void Instructions::LDH_N_A(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t value = processor.memory->load(processor.registers.pc + 1);
     uint16_t address = 0xFF00 | value;
-    processor->memory->store(address, processor->registers.a);
-    processor->advanceProgramCounter(instruction);
+    processor.memory->store(address, processor.registers.a);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::DEC_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->memory->step(4);
-    uint8_t RR = RPTable[instruction.code.p];
-    processor->registers._value16[RR]--;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::DEC_RR(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.memory->step(4);
+    constexpr uint8_t RR = RPTable[StaticCode<Opcode>::p];
+    processor.registers._value16[RR]--;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::CALL_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    processor->advanceProgramCounter(instruction);
-    processor->memory->step(4);
-    processor->pushIntoStack(processor->registers.pc);
-    processor->registers.pc = address;
+template<uint8_t Opcode>
+void Instructions::CALL_NN(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    processor.advanceProgramCounter<Opcode>();
+    processor.memory->step(4);
+    processor.pushIntoStack(processor.registers.pc);
+    processor.registers.pc = address;
 }
 
-template<>
-void Instructions::LD_R_R(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = RTable[instruction.code.y];
-    uint8_t R2 = RTable[instruction.code.z];
-    if (R != 0xFF) {
-        if (R2 != 0xFF) {
-            processor->registers._value8[R] = processor->registers._value8[R2];
+template<uint8_t Opcode>
+void Instructions::LD_R_R(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = RTable[StaticCode<Opcode>::y];
+    constexpr uint8_t R2 = RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        if constexpr (R2 != 0xFF) {
+            processor.registers._value8[R] = processor.registers._value8[R2];
+            // LD B,B is the software breakpoint used by test ROMs
+            if constexpr (Opcode == 0x40) {
+                processor.checkTestResult();
+            }
         } else {
-            uint8_t value = processor->memory->load(processor->registers.hl);
-            processor->registers._value8[R] = value;
+            uint8_t value = processor.memory->load(processor.registers.hl);
+            processor.registers._value8[R] = value;
         }
     } else {
-        uint8_t value = processor->registers._value8[R2];
-        processor->memory->store(processor->registers.hl, value);
+        uint8_t value = processor.registers._value8[R2];
+        processor.memory->store(processor.registers.hl, value);
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::JR_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    int8_t value = processor->memory->load(processor->registers.pc + 1);
-    processor->memory->step(4);
-    processor->advanceProgramCounter(instruction);
-    processor->registers.pc += value;
+template<uint8_t Opcode>
+void Instructions::JR_I8(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    int8_t value = processor.memory->load(processor.registers.pc + 1);
+    processor.memory->step(4);
+    processor.advanceProgramCounter<Opcode>();
+    processor.registers.pc += value;
 }
 
-template<>
-void Instructions::LD_INDIRECT(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    if (instruction.code.q) {
-        switch (instruction.code.p) {
-        case 0:
-            processor->registers.a = processor->memory->load(processor->registers.bc);
-            break;
-        case 1:
-            processor->registers.a = processor->memory->load(processor->registers.de);
-            break;
-        case 2:
-            processor->registers.a = processor->memory->load(processor->registers.hl);
-            processor->registers.hl++;
-            break;
-        case 3:
-            processor->registers.a = processor->memory->load(processor->registers.hl);
-            processor->registers.hl--;
-            break;
+template<uint8_t Opcode>
+void Instructions::LD_INDIRECT(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t P = StaticCode<Opcode>::p;
+    if constexpr (StaticCode<Opcode>::q) {
+        if constexpr (P == 0) {
+            processor.registers.a = processor.memory->load(processor.registers.bc);
+        } else if constexpr (P == 1) {
+            processor.registers.a = processor.memory->load(processor.registers.de);
+        } else if constexpr (P == 2) {
+            processor.registers.a = processor.memory->load(processor.registers.hl);
+            processor.registers.hl++;
+        } else {
+            processor.registers.a = processor.memory->load(processor.registers.hl);
+            processor.registers.hl--;
         }
     } else {
-        switch (instruction.code.p) {
-        case 0:
-            processor->memory->store(processor->registers.bc, processor->registers.a);
-            break;
-        case 1:
-            processor->memory->store(processor->registers.de, processor->registers.a);
-            break;
-        case 2:
-            processor->memory->store(processor->registers.hl, processor->registers.a);
-            processor->registers.hl++;
-            break;
-        case 3:
-            processor->memory->store(processor->registers.hl, processor->registers.a);
-            processor->registers.hl--;
-            break;
+        if constexpr (P == 0) {
+            processor.memory->store(processor.registers.bc, processor.registers.a);
+        } else if constexpr (P == 1) {
+            processor.memory->store(processor.registers.de, processor.registers.a);
+        } else if constexpr (P == 2) {
+            processor.memory->store(processor.registers.hl, processor.registers.a);
+            processor.registers.hl++;
+        } else {
+            processor.memory->store(processor.registers.hl, processor.registers.a);
+            processor.registers.hl--;
         }
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::PUSH_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t RR = Instructions::RP2Table[instruction.code.p];
-    processor->memory->step(4);
-    processor->pushIntoStack(processor->registers._value16[RR]);
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::PUSH_RR(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t RR = Instructions::RP2Table[StaticCode<Opcode>::p];
+    processor.memory->step(4);
+    processor.pushIntoStack(processor.registers._value16[RR]);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::POP_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t RR = RP2Table[instruction.code.p];
-    uint16_t value = processor->popFromStack();
-    if (RR == 0x0) {
-        processor->registers.a = (value & 0xFF00) >> 8;
-        processor->registers.flag.zero = (value & 0xFF) & 0x80 ? 1 : 0;
-        processor->registers.flag.n = (value & 0xFF) & 0x40 ? 1 : 0;
-        processor->registers.flag.halfcarry = (value & 0xFF) & 0x20 ? 1 : 0;
-        processor->registers.flag.carry = (value & 0xFF) & 0x10 ? 1 : 0;
+template<uint8_t Opcode>
+void Instructions::POP_RR(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t RR = RP2Table[StaticCode<Opcode>::p];
+    uint16_t value = processor.popFromStack();
+    if constexpr (RR == 0x0) {
+        processor.registers.a = (value & 0xFF00) >> 8;
+        processor.registers.flag.zero = (value & 0xFF) & 0x80 ? 1 : 0;
+        processor.registers.flag.n = (value & 0xFF) & 0x40 ? 1 : 0;
+        processor.registers.flag.halfcarry = (value & 0xFF) & 0x20 ? 1 : 0;
+        processor.registers.flag.carry = (value & 0xFF) & 0x10 ? 1 : 0;
     } else {
-        processor->registers._value16[RR] = value;
+        processor.registers._value16[RR] = value;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::INC_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->memory->step(4);
-    uint8_t RR = RPTable[instruction.code.p];
-    processor->registers._value16[RR]++;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::INC_RR(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.memory->step(4);
+    constexpr uint8_t RR = RPTable[StaticCode<Opcode>::p];
+    processor.registers._value16[RR]++;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::EI(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->shouldSetIME = true;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::EI(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.shouldSetIME = true;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::OR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->executeArithmetic(instruction, [](uint8_t operand1, uint8_t operand2) {
+template<uint8_t Opcode>
+void Instructions::OR(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.executeArithmetic<Opcode>([](uint8_t operand1, uint8_t operand2) {
         uint8_t result = operand1 | operand2;
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -232,38 +279,40 @@ void Instructions::OR(std::unique_ptr<Processor> &processor, Instruction instruc
     });
 }
 
-template<>
-void Instructions::JR_CC_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    std::function<bool(Flag&)> compare = CCTable[instruction.code.y - 4];
-    int8_t value = processor->memory->load(processor->registers.pc + 1);
-    processor->advanceProgramCounter(instruction);
-    if (compare(processor->registers.flag)) {
-        processor->memory->step(4);
-        processor->registers.pc += value;
+template<uint8_t Opcode>
+void Instructions::JR_CC_I8(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    int8_t value = processor.memory->load(processor.registers.pc + 1);
+    processor.advanceProgramCounter<Opcode>();
+    if (checkCondition<StaticCode<Opcode>::y - 4>(processor.registers.flag)) {
+        processor.memory->step(4);
+        processor.registers.pc += value;
     }
 }
 
-template<>
-void Instructions::STOP(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->advanceProgramCounter(instruction);
-    processor->memory->handleSpeedSwitch();
+template<uint8_t Opcode>
+void Instructions::STOP(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.advanceProgramCounter<Opcode>();
+    processor.memory->handleSpeedSwitch();
 }
 
-template<>
-void Instructions::CALL_CC_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    std::function<bool(Flag&)> compare = CCTable[instruction.code.y];
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    processor->advanceProgramCounter(instruction);
-    if (compare(processor->registers.flag)) {
-        processor->memory->step(4);
-        processor->pushIntoStack(processor->registers.pc);
-        processor->registers.pc = address;
+template<uint8_t Opcode>
+void Instructions::CALL_CC_NN(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    processor.advanceProgramCounter<Opcode>();
+    if (checkCondition<StaticCode<Opcode>::y>(processor.registers.flag)) {
+        processor.memory->step(4);
+        processor.pushIntoStack(processor.registers.pc);
+        processor.registers.pc = address;
     }
 }
 
-template<>
-void Instructions::ADD(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->executeArithmetic(instruction, [](uint8_t operand1, uint8_t operand2) {
+template<uint8_t Opcode>
+void Instructions::ADD(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.executeArithmetic<Opcode>([](uint8_t operand1, uint8_t operand2) {
         uint8_t result = operand1 + operand2;
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -274,38 +323,41 @@ void Instructions::ADD(std::unique_ptr<Processor> &processor, Instruction instru
     });
 }
 
-template<>
-void Instructions::LD_NN_SP(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    processor->advanceProgramCounter(instruction);
-    processor->memory->storeDoubleWord(address, processor->registers.sp);
-}
-
-template<>
-void Instructions::RLCA(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t result = (processor->registers.a & 0x80) >> 7;
-    processor->registers.flag.zero = 0;
-    processor->registers.flag.n = 0;
-    processor->registers.flag.halfcarry = 0;
-    processor->registers.flag.carry = result;
-    processor->registers.a <<= 1;
-    processor->registers.a |= result;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::LD_NN_SP(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    processor.advanceProgramCounter<Opcode>();
+    processor.memory->storeDoubleWord(address, processor.registers.sp);
 }
 
-template<>
-void Instructions::LD_A_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
+template<uint8_t Opcode>
+void Instructions::RLCA(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t result = (processor.registers.a & 0x80) >> 7;
+    processor.registers.flag.zero = 0;
+    processor.registers.flag.n = 0;
+    processor.registers.flag.halfcarry = 0;
+    processor.registers.flag.carry = result;
+    processor.registers.a <<= 1;
+    processor.registers.a |= result;
+    processor.advanceProgramCounter<Opcode>();
+}
+
+template<uint8_t Opcode>
+void Instructions::LD_A_NN(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    uint8_t value = processor->memory->load(address);
-    processor->registers.a = value;
-    processor->advanceProgramCounter(instruction);
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    uint8_t value = processor.memory->load(address);
+    processor.registers.a = value;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::SBC_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t carry = processor->registers.flag.carry;
-    processor->executeArithmetic(instruction, [carry](uint8_t minuend, uint8_t subtrahend) {
+template<uint8_t Opcode>
+void Instructions::SBC_A(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t carry = processor.registers.flag.carry;
+    processor.executeArithmetic<Opcode>([carry](uint8_t minuend, uint8_t subtrahend) {
         uint8_t result = minuend - (subtrahend + carry);
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -316,32 +368,34 @@ void Instructions::SBC_A(std::unique_ptr<Processor> &processor, Instruction inst
     });
 }
 
-template<>
-void Instructions::DEC_R(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.y];
+template<uint8_t Opcode>
+void Instructions::DEC_R(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::y];
     uint8_t minuend;
     uint8_t subtrahend = 1;
     uint8_t result;
-    if (R != 0xFF) {
-        minuend = processor->registers._value8[R];
+    if constexpr (R != 0xFF) {
+        minuend = processor.registers._value8[R];
     } else {
-        minuend = processor->memory->load(processor->registers.hl);
+        minuend = processor.memory->load(processor.registers.hl);
     }
     result = minuend - subtrahend;
-    processor->registers.flag.calculateZero(result);
-    processor->registers.flag.n = 1;
-    processor->registers.flag.calculateSubtractionHalfCarry(minuend, subtrahend, 0x0);
-    if (R != 0xFF) {
-        processor->registers._value8[R] = result;
+    processor.registers.flag.calculateZero(result);
+    processor.registers.flag.n = 1;
+    processor.registers.flag.calculateSubtractionHalfCarry(minuend, subtrahend, 0x0);
+    if constexpr (R != 0xFF) {
+        processor.registers._value8[R] = result;
     } else {
-        processor->memory->store(processor->registers.hl, result);
+        processor.memory->store(processor.registers.hl, result);
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::XOR_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->executeArithmetic(instruction, [](uint8_t operand1, uint8_t operand2) {
+template<uint8_t Opcode>
+void Instructions::XOR_A(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.executeArithmetic<Opcode>([](uint8_t operand1, uint8_t operand2) {
         uint8_t result = operand1 ^ operand2;
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -352,10 +406,11 @@ void Instructions::XOR_A(std::unique_ptr<Processor> &processor, Instruction inst
     });
 }
 
-template<>
-void Instructions::ADC_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t carry = processor->registers.flag.carry;
-    processor->executeArithmetic(instruction, [carry](uint8_t operand1, uint8_t operand2) {
+template<uint8_t Opcode>
+void Instructions::ADC_A(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t carry = processor.registers.flag.carry;
+    processor.executeArithmetic<Opcode>([carry](uint8_t operand1, uint8_t operand2) {
         uint8_t result = operand1 + operand2 + carry;
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -366,67 +421,70 @@ void Instructions::ADC_A(std::unique_ptr<Processor> &processor, Instruction inst
     });
 }
 
-template<>
-void Instructions::JP_HL(std::unique_ptr<Processor> &processor, Instruction instruction) {
+template<uint8_t Opcode>
+void Instructions::JP_HL(Processor &processor, Instruction instruction) {
     (void)instruction;
-    processor->registers.pc = processor->registers.hl;
+    processor.registers.pc = processor.registers.hl;
 }
 
-template<>
-void Instructions::RRA(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t carry = processor->registers.flag.carry;
+template<uint8_t Opcode>
+void Instructions::RRA(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t carry = processor.registers.flag.carry;
     carry <<= 7;
-    uint8_t result = processor->registers.a & 0x1;
-    processor->registers.flag.zero = 0;
-    processor->registers.flag.n = 0;
-    processor->registers.flag.halfcarry = 0;
-    processor->registers.flag.carry = result;
-    processor->registers.a >>= 1;
-    processor->registers.a |= carry;
-    processor->advanceProgramCounter(instruction);
-}
-
-template<>
-void Instructions::RET_CC(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    std::function<bool(Flag&)> compare = CCTable[instruction.code.y];
-    processor->memory->step(4);
-    if (compare(processor->registers.flag)) {
-        uint16_t address = processor->popFromStack();
-        processor->memory->step(4);
-        processor->registers.pc = address;
+    uint8_t result = processor.registers.a & 0x1;
+    processor.registers.flag.zero = 0;
+    processor.registers.flag.n = 0;
+    processor.registers.flag.halfcarry = 0;
+    processor.registers.flag.carry = result;
+    processor.registers.a >>= 1;
+    processor.registers.a |= carry;
+    processor.advanceProgramCounter<Opcode>();
+}
+
+template<uint8_t Opcode>
+void Instructions::RET_CC(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.memory->step(4);
+    if (checkCondition<StaticCode<Opcode>::y>(processor.registers.flag)) {
+        uint16_t address = processor.popFromStack();
+        processor.memory->step(4);
+        processor.registers.pc = address;
         return;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::RLC(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t lastBit = (processor->registers._value8[R] & 0x80) >> 7;
-        processor->registers._value8[R] <<= 1;
-        processor->registers._value8[R] |= lastBit;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = lastBit;
+template<uint8_t Opcode>
+void Instructions::RLC(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t lastBit = (processor.registers._value8[R] & 0x80) >> 7;
+        processor.registers._value8[R] <<= 1;
+        processor.registers._value8[R] |= lastBit;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = lastBit;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t lastBit = (value & 0x80) >> 7;
         value <<= 1;
         value |= lastBit;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = lastBit;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = lastBit;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::CP_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->executeArithmetic(instruction, [](uint8_t operand1, uint8_t operand2) {
+template<uint8_t Opcode>
+void Instructions::CP_A(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.executeArithmetic<Opcode, false>([](uint8_t operand1, uint8_t operand2) {
         uint8_t result = operand1 - operand2;
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -434,94 +492,100 @@ void Instructions::CP_A(std::unique_ptr<Processor> &processor, Instruction instr
         flags.calculateSubtractionHalfCarry(operand1, operand2, 0x0);
         flags.calculateSubtractionCarry(operand1, operand2, 0x0);
         return std::tuple(result, flags);
-    }, false);
+    });
 }
 
-template<>
-void Instructions::LDH_A_N(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t value = processor->memory->load(processor->registers.pc + 1);
+template<uint8_t Opcode>
+void Instructions::LDH_A_N(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t value = processor.memory->load(processor.registers.pc + 1);
     uint16_t address = 0xFF00 | value;
-    processor->registers.a = processor->memory->load(address);
-    processor->advanceProgramCounter(instruction);
+    processor.registers.a = processor.memory->load(address);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::BIT(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = RTable[instruction.code.z];
-    if (R != 0xFF) {
-        std::bitset<8> bits = std::bitset<8>(processor->registers._value8[R]);
-        bool isSet = bits.test(instruction.code.y);
-        processor->registers.flag.zero = isSet ? 0 : 1;
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 1;
+template<uint8_t Opcode>
+void Instructions::BIT(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = RTable[StaticCode<Opcode>::z];
+    constexpr uint8_t mask = 1 << StaticCode<Opcode>::y;
+    if constexpr (R != 0xFF) {
+        bool isSet = (processor.registers._value8[R] & mask) != 0;
+        processor.registers.flag.zero = isSet ? 0 : 1;
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 1;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
-        std::bitset<8> bits = std::bitset<8>(value);
-        bool isSet = bits.test(instruction.code.y);
-        processor->registers.flag.zero = isSet ? 0 : 1;
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 1;
+        uint8_t value = processor.memory->load(processor.registers.hl);
+        bool isSet = (value & mask) != 0;
+        processor.registers.flag.zero = isSet ? 0 : 1;
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 1;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::LDH_C_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint16_t address = 0xFF00 | processor->registers.c;
-    processor->memory->store(address, processor->registers.a);
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::LDH_C_A(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t address = 0xFF00 | processor.registers.c;
+    processor.memory->store(address, processor.registers.a);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::LDH_A_C(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint16_t address = 0xFF00 | processor->registers.c;
-    processor->registers.a = processor->memory->load(address);
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::LDH_A_C(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t address = 0xFF00 | processor.registers.c;
+    processor.registers.a = processor.memory->load(address);
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::RL(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t lastBit = (processor->registers._value8[R] & 0x80) >> 7;
-        uint8_t carry = processor->registers.flag.carry;
-        processor->registers._value8[R] <<= 1;
-        processor->registers._value8[R] |= carry;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = lastBit;
+template<uint8_t Opcode>
+void Instructions::RL(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t lastBit = (processor.registers._value8[R] & 0x80) >> 7;
+        uint8_t carry = processor.registers.flag.carry;
+        processor.registers._value8[R] <<= 1;
+        processor.registers._value8[R] |= carry;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = lastBit;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t lastBit = (value & 0x80) >> 7;
-        uint8_t carry = processor->registers.flag.carry;
+        uint8_t carry = processor.registers.flag.carry;
         value <<= 1;
         value |= carry;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = lastBit;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = lastBit;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::RLA(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t result = (processor->registers.a & 0x80) >> 7;
-    uint8_t carry = processor->registers.flag.carry;
-    processor->registers.flag.zero = 0;
-    processor->registers.flag.n = 0;
-    processor->registers.flag.halfcarry = 0;
-    processor->registers.flag.carry = result;
-    processor->registers.a <<= 1;
-    processor->registers.a |= carry;
-    processor->advanceProgramCounter(instruction);
-}
-
-template<>
-void Instructions::SUB(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->executeArithmetic(instruction, [](uint8_t operand1, uint8_t operand2) {
+template<uint8_t Opcode>
+void Instructions::RLA(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t result = (processor.registers.a & 0x80) >> 7;
+    uint8_t carry = processor.registers.flag.carry;
+    processor.registers.flag.zero = 0;
+    processor.registers.flag.n = 0;
+    processor.registers.flag.halfcarry = 0;
+    processor.registers.flag.carry = result;
+    processor.registers.a <<= 1;
+    processor.registers.a |= carry;
+    processor.advanceProgramCounter<Opcode>();
+}
+
+template<uint8_t Opcode>
+void Instructions::SUB(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.executeArithmetic<Opcode>([](uint8_t operand1, uint8_t operand2) {
         uint8_t result = operand1 - operand2;
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -532,9 +596,10 @@ void Instructions::SUB(std::unique_ptr<Processor> &processor, Instruction instru
     });
 }
 
-template<>
-void Instructions::AND(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->executeArithmetic(instruction, [](uint8_t operand1, uint8_t operand2) {
+template<uint8_t Opcode>
+void Instructions::AND(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.executeArithmetic<Opcode>([](uint8_t operand1, uint8_t operand2) {
         uint8_t result = operand1 & operand2;
         Flag flags = Flag();
         flags.calculateZero(result);
@@ -545,339 +610,351 @@ void Instructions::AND(std::unique_ptr<Processor> &processor, Instruction instru
     });
 }
 
-template<>
-void Instructions::SET(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = RTable[instruction.code.z];
-    if (R != 0xFF) {
-        std::bitset<8> bits = std::bitset<8>(processor->registers._value8[R]);
-        bits.set(instruction.code.y);
-        processor->registers._value8[R] = bits.to_ulong();
+template<uint8_t Opcode>
+void Instructions::SET(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = RTable[StaticCode<Opcode>::z];
+    constexpr uint8_t mask = 1 << StaticCode<Opcode>::y;
+    if constexpr (R != 0xFF) {
+        processor.registers._value8[R] |= mask;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
-        std::bitset<8> bits = std::bitset<8>(value);
-        bits.set(instruction.code.y);
-        processor->memory->store(processor->registers.hl, bits.to_ulong());
+        uint8_t value = processor.memory->load(processor.registers.hl);
+        processor.memory->store(processor.registers.hl, value | mask);
     }
-    processor->advanceProgramCounter(instruction);
-}
-
-template<>
-void Instructions::ADD_HL_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->memory->step(4);
-    uint8_t RR = Instructions::RPTable[instruction.code.p];
-    uint16_t augend = processor->registers.hl;
-    uint16_t addend = processor->registers._value16[RR];
-    processor->registers.hl += processor->registers._value16[RR];
-    processor->registers.flag.n = 0;
-    processor->registers.flag.halfcarry = ((((uint32_t)augend & 0xFFF) + ((uint32_t)addend & 0xFFF)) & 0x1000) == 0x1000;
-    processor->registers.flag.carry = ((((uint32_t)augend & 0xFFFF) + ((uint32_t)addend & 0xFFFF)) & 0x10000) == 0x10000;
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::RES(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = RTable[instruction.code.z];
-    if (R != 0xFF) {
-        std::bitset<8> bits = std::bitset<8>(processor->registers._value8[R]);
-        bits.reset(instruction.code.y);
-        processor->registers._value8[R] = bits.to_ulong();
+template<uint8_t Opcode>
+void Instructions::ADD_HL_RR(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.memory->step(4);
+    constexpr uint8_t RR = Instructions::RPTable[StaticCode<Opcode>::p];
+    uint16_t augend = processor.registers.hl;
+    uint16_t addend = processor.registers._value16[RR];
+    processor.registers.hl += processor.registers._value16[RR];
+    processor.registers.flag.n = 0;
+    processor.registers.flag.halfcarry = ((((uint32_t)augend & 0xFFF) + ((uint32_t)addend & 0xFFF)) & 0x1000) == 0x1000;
+    processor.registers.flag.carry = ((((uint32_t)augend & 0xFFFF) + ((uint32_t)addend & 0xFFFF)) & 0x10000) == 0x10000;
+    processor.advanceProgramCounter<Opcode>();
+}
+
+template<uint8_t Opcode>
+void Instructions::RES(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = RTable[StaticCode<Opcode>::z];
+    constexpr uint8_t mask = (uint8_t)~(1 << StaticCode<Opcode>::y);
+    if constexpr (R != 0xFF) {
+        processor.registers._value8[R] &= mask;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
-        std::bitset<8> bits = std::bitset<8>(value);
-        bits.reset(instruction.code.y);
-        processor->memory->store(processor->registers.hl, bits.to_ulong());
+        uint8_t value = processor.memory->load(processor.registers.hl);
+        processor.memory->store(processor.registers.hl, value & mask);
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::SRA(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t lastBitMask = processor->registers._value8[R] & 0x80;
-        uint8_t firstBit = (processor->registers._value8[R] & 0x1);
-        processor->registers._value8[R] >>= 1;
-        processor->registers._value8[R] |= lastBitMask;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+template<uint8_t Opcode>
+void Instructions::SRA(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t lastBitMask = processor.registers._value8[R] & 0x80;
+        uint8_t firstBit = (processor.registers._value8[R] & 0x1);
+        processor.registers._value8[R] >>= 1;
+        processor.registers._value8[R] |= lastBitMask;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t lastBitMask = value & 0x80;
         uint8_t firstBit = (value & 0x1);
         value >>= 1;
         value |= lastBitMask;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::SWAP(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t lsb = (processor->registers._value8[R] & 0x0F);
+template<uint8_t Opcode>
+void Instructions::SWAP(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t lsb = (processor.registers._value8[R] & 0x0F);
         lsb <<= 4;
-        uint8_t msb = (processor->registers._value8[R] & 0xF0);
+        uint8_t msb = (processor.registers._value8[R] & 0xF0);
         msb >>= 4;
-        processor->registers._value8[R] = msb | lsb;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = 0;
+        processor.registers._value8[R] = msb | lsb;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = 0;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t lsb = (value & 0x0F);
         lsb <<= 4;
         uint8_t msb = (value & 0xF0);
         msb >>= 4;
         value = msb | lsb;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = 0;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = 0;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::JP_CC_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    std::function<bool(Flag&)> compare = CCTable[instruction.code.y];
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1);
-    processor->advanceProgramCounter(instruction);
-    if (compare(processor->registers.flag)) {
-        processor->memory->step(4);
-        processor->registers.pc = address;
+template<uint8_t Opcode>
+void Instructions::JP_CC_NN(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1);
+    processor.advanceProgramCounter<Opcode>();
+    if (checkCondition<StaticCode<Opcode>::y>(processor.registers.flag)) {
+        processor.memory->step(4);
+        processor.registers.pc = address;
         return;
     }
 }
 
-template<>
-void Instructions::LD_HL_SP_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    int8_t value = processor->memory->load(processor->registers.pc + 1);
-    processor->memory->step(4);
-    processor->advanceProgramCounter(instruction);
-    uint16_t result = processor->registers.sp + value;
-    processor->registers.flag.zero = 0;
-    processor->registers.flag.n = 0;
+template<uint8_t Opcode>
+void Instructions::LD_HL_SP_I8(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    int8_t value = processor.memory->load(processor.registers.pc + 1);
+    processor.memory->step(4);
+    processor.advanceProgramCounter<Opcode>();
+    uint16_t result = processor.registers.sp + value;
+    processor.registers.flag.zero = 0;
+    processor.registers.flag.n = 0;
     if (value >= 0) {
-        processor->registers.flag.calculateAdditionHalfCarry(processor->registers.sp, value, 0x0);
-        processor->registers.flag.calculateAdditionCarry(processor->registers.sp, value, 0x0);
+        processor.registers.flag.calculateAdditionHalfCarry(processor.registers.sp, value, 0x0);
+        processor.registers.flag.calculateAdditionCarry(processor.registers.sp, value, 0x0);
     } else {
-        processor->registers.flag.calculateSubtractionHalfCarry(result, processor->registers.sp, 0x0);
-        processor->registers.flag.calculateSubtractionCarry(result, processor->registers.sp, 0x0);
+        processor.registers.flag.calculateSubtractionHalfCarry(result, processor.registers.sp, 0x0);
+        processor.registers.flag.calculateSubtractionCarry(result, processor.registers.sp, 0x0);
     }
-    processor->registers.hl = result;
+    processor.registers.hl = result;
 }
 
-template<>
-void Instructions::SLA(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t lastBit = (processor->registers._value8[R] & 0x80) >> 7;
-        processor->registers._value8[R] <<= 1;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = lastBit;
+template<uint8_t Opcode>
+void Instructions::SLA(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t lastBit = (processor.registers._value8[R] & 0x80) >> 7;
+        processor.registers._value8[R] <<= 1;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = lastBit;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t lastBit = (value & 0x80) >> 7;
         value <<= 1;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = lastBit;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = lastBit;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t firstBit = (processor->registers._value8[R] & 0x1);
-        uint8_t carryMask = processor->registers.flag.carry << 7;
-        processor->registers._value8[R] >>= 1;
-        processor->registers._value8[R] |= carryMask;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+template<uint8_t Opcode>
+void Instructions::RR(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t firstBit = (processor.registers._value8[R] & 0x1);
+        uint8_t carryMask = processor.registers.flag.carry << 7;
+        processor.registers._value8[R] >>= 1;
+        processor.registers._value8[R] |= carryMask;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t firstBit = (value & 0x1);
-        uint8_t carryMask = processor->registers.flag.carry << 7;
+        uint8_t carryMask = processor.registers.flag.carry << 7;
         value >>= 1;
         value |= carryMask;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::RRC(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t firstBit = (processor->registers._value8[R] & 0x1);
+template<uint8_t Opcode>
+void Instructions::RRC(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t firstBit = (processor.registers._value8[R] & 0x1);
         uint8_t firstBitMask = firstBit << 7;
-        processor->registers._value8[R] >>= 1;
-        processor->registers._value8[R] |= firstBitMask;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+        processor.registers._value8[R] >>= 1;
+        processor.registers._value8[R] |= firstBitMask;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t firstBit = (value & 0x1);
         uint8_t firstBitMask = firstBit << 7;
         value >>= 1;
         value |= firstBitMask;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::LD_SP_HL(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->memory->step(4);
-    processor->advanceProgramCounter(instruction);
-    processor->registers.sp = processor->registers.hl;
+template<uint8_t Opcode>
+void Instructions::LD_SP_HL(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.memory->step(4);
+    processor.advanceProgramCounter<Opcode>();
+    processor.registers.sp = processor.registers.hl;
 }
 
-template<>
-void Instructions::ADD_SP_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    int8_t value = processor->memory->load(processor->registers.pc + 1);
-    processor->memory->step(8);
-    processor->advanceProgramCounter(instruction);
-    uint16_t result = processor->registers.sp + value;
-    processor->registers.flag.zero = 0;
-    processor->registers.flag.n = 0;
+template<uint8_t Opcode>
+void Instructions::ADD_SP_I8(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    int8_t value = processor.memory->load(processor.registers.pc + 1);
+    processor.memory->step(8);
+    processor.advanceProgramCounter<Opcode>();
+    uint16_t result = processor.registers.sp + value;
+    processor.registers.flag.zero = 0;
+    processor.registers.flag.n = 0;
     if (value >= 0) {
-        processor->registers.flag.calculateAdditionHalfCarry(processor->registers.sp, value, 0x0);
-        processor->registers.flag.calculateAdditionCarry(processor->registers.sp, value, 0x0);
+        processor.registers.flag.calculateAdditionHalfCarry(processor.registers.sp, value, 0x0);
+        processor.registers.flag.calculateAdditionCarry(processor.registers.sp, value, 0x0);
     } else {
-        processor->registers.flag.calculateSubtractionHalfCarry(result, processor->registers.sp, 0x0);
-        processor->registers.flag.calculateSubtractionCarry(result, processor->registers.sp, 0x0);
+        processor.registers.flag.calculateSubtractionHalfCarry(result, processor.registers.sp, 0x0);
+        processor.registers.flag.calculateSubtractionCarry(result, processor.registers.sp, 0x0);
     }
-    processor->registers.sp = result;
+    processor.registers.sp = result;
 }
 
-template<>
-void Instructions::RETI(std::unique_ptr<Processor> &processor, Instruction instruction) {
+template<uint8_t Opcode>
+void Instructions::RETI(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t address = processor->popFromStack();
-    processor->memory->step(4);
-    processor->registers.pc = address;
-    processor->setIME(true);
+    uint16_t address = processor.popFromStack();
+    processor.memory->step(4);
+    processor.registers.pc = address;
+    processor.setIME(true);
 }
 
-template<>
-void Instructions::DAA(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    if (!processor->registers.flag.n) {
-        if (processor->registers.flag.carry || processor->registers.a > 0x99) {
-            processor->registers.a += 0x60;
-            processor->registers.flag.carry = 1;
+template<uint8_t Opcode>
+void Instructions::DAA(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    if (!processor.registers.flag.n) {
+        if (processor.registers.flag.carry || processor.registers.a > 0x99) {
+            processor.registers.a += 0x60;
+            processor.registers.flag.carry = 1;
         }
-        if (processor->registers.flag.halfcarry || (processor->registers.a & 0x0f) > 0x09) {
-            processor->registers.a += 0x6;
+        if (processor.registers.flag.halfcarry || (processor.registers.a & 0x0f) > 0x09) {
+            processor.registers.a += 0x6;
         }
     } else {
-        if (processor->registers.flag.carry) {
-            processor->registers.a -= 0x60;
+        if (processor.registers.flag.carry) {
+            processor.registers.a -= 0x60;
         }
-        if (processor->registers.flag.halfcarry) {
-            processor->registers.a -= 0x6;
+        if (processor.registers.flag.halfcarry) {
+            processor.registers.a -= 0x6;
         }
     }
-    processor->registers.flag.calculateZero(processor->registers.a);
-    processor->registers.flag.halfcarry = 0;
-    processor->advanceProgramCounter(instruction);
+    processor.registers.flag.calculateZero(processor.registers.a);
+    processor.registers.flag.halfcarry = 0;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::CPL(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->registers.a = ~processor->registers.a;
-    processor->registers.flag.n = 1;
-    processor->registers.flag.halfcarry = 1;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::CPL(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.registers.a = ~processor.registers.a;
+    processor.registers.flag.n = 1;
+    processor.registers.flag.halfcarry = 1;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::SCF(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->registers.flag.n = 0;
-    processor->registers.flag.halfcarry = 0;
-    processor->registers.flag.carry = 1;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::SCF(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.registers.flag.n = 0;
+    processor.registers.flag.halfcarry = 0;
+    processor.registers.flag.carry = 1;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::CCF(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->registers.flag.n = 0;
-    processor->registers.flag.halfcarry = 0;
-    processor->registers.flag.carry = !processor->registers.flag.carry;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::CCF(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.registers.flag.n = 0;
+    processor.registers.flag.halfcarry = 0;
+    processor.registers.flag.carry = !processor.registers.flag.carry;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::RRCA(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t lastBit = processor->registers.a & 0x1;
+template<uint8_t Opcode>
+void Instructions::RRCA(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    uint8_t lastBit = processor.registers.a & 0x1;
     uint8_t lastBitMask = lastBit << 7;
-    processor->registers.a >>= 1;
-    processor->registers.a |= lastBitMask;
-    processor->registers.flag.zero = 0;
-    processor->registers.flag.n = 0;
-    processor->registers.flag.halfcarry = 0;
-    processor->registers.flag.carry = lastBit;
-    processor->advanceProgramCounter(instruction);
+    processor.registers.a >>= 1;
+    processor.registers.a |= lastBitMask;
+    processor.registers.flag.zero = 0;
+    processor.registers.flag.n = 0;
+    processor.registers.flag.halfcarry = 0;
+    processor.registers.flag.carry = lastBit;
+    processor.advanceProgramCounter<Opcode>();
 }
 
-template<>
-void Instructions::SRL(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    uint8_t R = Instructions::RTable[instruction.code.z];
-    if (R != 0xFF) {
-        uint8_t firstBit = (processor->registers._value8[R] & 0x1);
-        processor->registers._value8[R] >>= 1;
-        processor->registers.flag.calculateZero(processor->registers._value8[R]);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+template<uint8_t Opcode>
+void Instructions::SRL(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    constexpr uint8_t R = Instructions::RTable[StaticCode<Opcode>::z];
+    if constexpr (R != 0xFF) {
+        uint8_t firstBit = (processor.registers._value8[R] & 0x1);
+        processor.registers._value8[R] >>= 1;
+        processor.registers.flag.calculateZero(processor.registers._value8[R]);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     } else {
-        uint8_t value = processor->memory->load(processor->registers.hl);
+        uint8_t value = processor.memory->load(processor.registers.hl);
         uint8_t firstBit = (value & 0x1);
         value >>= 1;
-        processor->memory->store(processor->registers.hl, value);
-        processor->registers.flag.calculateZero(value);
-        processor->registers.flag.n = 0;
-        processor->registers.flag.halfcarry = 0;
-        processor->registers.flag.carry = firstBit;
+        processor.memory->store(processor.registers.hl, value);
+        processor.registers.flag.calculateZero(value);
+        processor.registers.flag.n = 0;
+        processor.registers.flag.halfcarry = 0;
+        processor.registers.flag.carry = firstBit;
     }
-    processor->advanceProgramCounter(instruction);
+    processor.advanceProgramCounter<Opcode, true>();
 }
 
-template<>
-void Instructions::HALT(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    processor->halted = true;
-    processor->advanceProgramCounter(instruction);
+template<uint8_t Opcode>
+void Instructions::HALT(Processor &processor, Instruction instruction) {
+    (void)instruction;
+    processor.halted = true;
+    processor.advanceProgramCounter<Opcode>();
 }
 
 template<>
-void Instructions::HALTED(std::unique_ptr<Processor> &processor, Instruction instruction) {
+void Instructions::HALTED(Processor &processor, Instruction instruction) {
     (void)instruction;
-    processor->memory->step(4);
+    processor.memory->step(4);
 }
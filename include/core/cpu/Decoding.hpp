@@ -1,27 +1,50 @@
 #pragma once
+#include <array>
 #include <vector>
+#include <string>
 #include <cstdint>
 
 namespace Core {
     namespace CPU {
         namespace Instructions {
-            const std::vector<uint8_t> RPTable = { 0x1, 0x2, 0x3, 0x4 };
-            const std::vector<uint8_t> RP2Table = { 0x1, 0x2, 0x3, 0x0 };
-            const std::vector<uint8_t> RTable = { 0x3, 0x2, 0x5, 0x4, 0x7, 0x6, 0xFF, 0x1 };
-            const std::vector<std::function<bool(Flag&)>> CCTable = {
-                [](Flag& flags) {
+            constexpr std::array<uint8_t, 4> RPTable = { 0x1, 0x2, 0x3, 0x4 };
+            constexpr std::array<uint8_t, 4> RP2Table = { 0x1, 0x2, 0x3, 0x0 };
+            constexpr std::array<uint8_t, 8> RTable = { 0x3, 0x2, 0x5, 0x4, 0x7, 0x6, 0xFF, 0x1 };
+
+            template<uint8_t CC>
+            inline bool checkCondition(const Flag &flags) {
+                static_assert(CC < 4, "Invalid condition decoding");
+                if constexpr (CC == 0) {
                     return flags.zero == 0;
-                },
-                [](Flag& flags) {
+                } else if constexpr (CC == 1) {
                     return flags.zero == 1;
-                },
-                [](Flag& flags) {
+                } else if constexpr (CC == 2) {
                     return flags.carry == 0;
-                },
-                [](Flag& flags) {
+                } else {
                     return flags.carry == 1;
-                },
+                }
+            }
+
+            constexpr std::array<uint8_t, 0x100> InstructionSizeTable = {
+            //     +0 +1 +2 +3 +4 +5 +6 +7 +8 +9 +A +B +C +D +E +F
+            /*0+*/ 1, 3, 1, 1, 1, 1, 2, 1, 3, 1, 1, 1, 1, 1, 2, 1,
+            /*1+*/ 2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,
+            /*2+*/ 2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,
+            /*3+*/ 2, 3, 1, 1, 1, 1, 2, 1, 2, 1, 1, 1, 1, 1, 2, 1,
+            /*4+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*5+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*6+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*7+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*8+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*9+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*A+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*B+*/ 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+            /*C+*/ 1, 1, 3, 3, 3, 1, 2, 1, 1, 1, 3, 1, 3, 3, 2, 1,
+            /*D+*/ 1, 1, 3, 0, 3, 1, 2, 1, 1, 1, 3, 0, 3, 0, 2, 1,
+            /*E+*/ 2, 1, 1, 0, 0, 1, 2, 1, 2, 1, 3, 0, 0, 0, 2, 1,
+            /*F+*/ 2, 1, 1, 1, 0, 1, 2, 1, 2, 1, 3, 1, 0, 0, 2, 1,
             };
+
             namespace Disassembler {
                 const std::vector<std::string> RPTable = { "BC", "DE", "HL", "SP" };
                 const std::vector<std::string> RP2Table = { "BC", "DE", "HL", "AF" };
@@ -6,42 +6,42 @@
 using namespace Core::CPU;
 
 template<>
-std::string Instructions::NOP(std::unique_ptr<Core::CPU::Processor> &processor, Instruction instruction) {
+std::string Instructions::NOP(Core::CPU::Processor &processor, Instruction instruction) {
     (void)instruction;
     (void)processor;
     return "NOP";
 }
 
 template<>
-std::string Instructions::JP_U16(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::JP_U16(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t destinaton = processor->memory->loadDoubleWord(processor->registers.pc + 1, false);
+    uint16_t destinaton = processor.memory->loadDoubleWord(processor.registers.pc + 1, false);
     return Common::Formatter::format("JP $%04x", destinaton);
 }
 
 template<>
-std::string Instructions::DI(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::DI(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "DI";
 }
 
 template<>
-std::string Instructions::LD_RR_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_RR_NN(Processor &processor, Instruction instruction) {
     std::string RR = Disassembler::RPTable[instruction.code.p];
-    uint16_t value = processor->memory->loadDoubleWord(processor->registers.pc + 1,false);
+    uint16_t value = processor.memory->loadDoubleWord(processor.registers.pc + 1,false);
     return Common::Formatter::format("LD %s,$%04x", RR.c_str(), value);
 }
 
 template<>
-std::string Instructions::RST_N(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RST_N(Processor &processor, Instruction instruction) {
     (void)processor;
     uint8_t N = instruction.code.y * 8;
     return Common::Formatter::format("RET $%04x", N);
 }
 
 template<>
-std::string Instructions::INC_R(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::INC_R(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     std::string R = Disassembler::RTable[instruction.code.y];
@@ -49,35 +49,35 @@ std::string Instructions::INC_R(std::unique_ptr<Processor> &processor, Instructi
 }
 
 template<>
-std::string Instructions::RET(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RET(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "RET";
 }
 
 template<>
-std::string Instructions::LD_NN_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_NN_A(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1, false);
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1, false);
     return Common::Formatter::format("LD ($%04x),A", address);
 }
 
 template<>
-std::string Instructions::LD_U8(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_U8(Processor &processor, Instruction instruction) {
     std::string R = Disassembler::RTable[instruction.code.y];
-    uint8_t value = processor->memory->load(processor->registers.pc + 1, false);
+    uint8_t value = processor.memory->load(processor.registers.pc + 1, false);
     return Common::Formatter::format("LD %s,$%02x", R.c_str(), value);
 }
 
 template<>
-std::string Instructions::LDH_N_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LDH_N_A(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint8_t value = processor->memory->load(processor->registers.pc + 1, false);
+    uint8_t value = processor.memory->load(processor.registers.pc + 1, false);
     return Common::Formatter::format("LD ($FF00+$%02x),A", value);
 }
 
 template<>
-std::string Instructions::DEC_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::DEC_RR(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     std::string RR = Disassembler::RPTable[instruction.code.p];
@@ -85,14 +85,14 @@ std::string Instructions::DEC_RR(std::unique_ptr<Processor> &processor, Instruct
 }
 
 template<>
-std::string Instructions::CALL_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::CALL_NN(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1, false);
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1, false);
     return Common::Formatter::format("CALL $%04x", address);
 }
 
 template<>
-std::string Instructions::LD_R_R(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_R_R(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.y];
     std::string R2 = Disassembler::RTable[instruction.code.z];
@@ -100,15 +100,15 @@ std::string Instructions::LD_R_R(std::unique_ptr<Processor> &processor, Instruct
 }
 
 template<>
-std::string Instructions::JR_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::JR_I8(Processor &processor, Instruction instruction) {
     (void)instruction;
-    int8_t value = processor->memory->load(processor->registers.pc + 1, false);
-    uint16_t destination = processor->registers.pc + 2 + value;
+    int8_t value = processor.memory->load(processor.registers.pc + 1, false);
+    uint16_t destination = processor.registers.pc + 2 + value;
     return Common::Formatter::format("JR $%04x", destination);
 }
 
 template<>
-std::string Instructions::LD_INDIRECT(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_INDIRECT(Processor &processor, Instruction instruction) {
     (void)processor;
     if (instruction.code.q) {
         switch (instruction.code.p) {
@@ -137,14 +137,14 @@ std::string Instructions::LD_INDIRECT(std::unique_ptr<Processor> &processor, Ins
 }
 
 template<>
-std::string Instructions::PUSH_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::PUSH_RR(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string RR = Disassembler::RP2Table[instruction.code.p];
     return Common::Formatter::format("PUSH %s", RR.c_str());
 }
 
 template<>
-std::string Instructions::POP_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::POP_RR(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     std::string RR = Disassembler::RP2Table[instruction.code.p];
@@ -152,79 +152,79 @@ std::string Instructions::POP_RR(std::unique_ptr<Processor> &processor, Instruct
 }
 
 template<>
-std::string Instructions::INC_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::INC_RR(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string RR = Disassembler::RPTable[instruction.code.p];
     return Common::Formatter::format("INC %s", RR.c_str());
 }
 
 template<>
-std::string Instructions::EI(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::EI(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "EI";
 }
 
 template<>
-std::string Instructions::OR(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "OR");
+std::string Instructions::OR(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "OR");
 }
 
 template<>
-std::string Instructions::JR_CC_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::JR_CC_I8(Processor &processor, Instruction instruction) {
     std::string compare = Disassembler::CCTable[instruction.code.y - 4];
-    int8_t immediate = processor->memory->load(processor->registers.pc + 1, false);
-    uint16_t destinationAddress = processor->registers.pc + immediate + 2;
+    int8_t immediate = processor.memory->load(processor.registers.pc + 1, false);
+    uint16_t destinationAddress = processor.registers.pc + immediate + 2;
     return Common::Formatter::format("JR %s,$%04x", compare.c_str(), destinationAddress);
 }
 
 template<>
-std::string Instructions::STOP(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::STOP(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "STOP";
 }
 
 template<>
-std::string Instructions::CALL_CC_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::CALL_CC_NN(Processor &processor, Instruction instruction) {
     std::string compare = Disassembler::CCTable[instruction.code.y];
-    uint16_t destination = processor->memory->loadDoubleWord(processor->registers.pc + 1, false);
+    uint16_t destination = processor.memory->loadDoubleWord(processor.registers.pc + 1, false);
     return Common::Formatter::format("CALL %s,$%04x", compare.c_str(), destination);
 }
 
 template<>
-std::string Instructions::ADD(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "ADD");
+std::string Instructions::ADD(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "ADD");
 }
 
 template<>
-std::string Instructions::LD_NN_SP(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_NN_SP(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1, false);
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1, false);
     return Common::Formatter::format("LD ($%04x),SP", address);
 }
 
 template<>
-std::string Instructions::RLCA(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RLCA(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "RLCA";
 }
 
 template<>
-std::string Instructions::LD_A_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_A_NN(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint16_t address = processor->memory->loadDoubleWord(processor->registers.pc + 1, false);
+    uint16_t address = processor.memory->loadDoubleWord(processor.registers.pc + 1, false);
     return Common::Formatter::format("LD A,$%04x", address);
 }
 
 template<>
-std::string Instructions::SBC_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "SBC");
+std::string Instructions::SBC_A(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "SBC");
 }
 
 template<>
-std::string Instructions::DEC_R(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::DEC_R(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     std::string R = Disassembler::RTable[instruction.code.y];
@@ -232,242 +232,242 @@ std::string Instructions::DEC_R(std::unique_ptr<Processor> &processor, Instructi
 }
 
 template<>
-std::string Instructions::XOR_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "XOR");
+std::string Instructions::XOR_A(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "XOR");
 }
 
 template<>
-std::string Instructions::ADC_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "ADC");
+std::string Instructions::ADC_A(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "ADC");
 }
 
 template<>
-std::string Instructions::JP_HL(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::JP_HL(Processor &processor, Instruction instruction) {
     (void)instruction;
-    return Common::Formatter::format("JP $%04x", processor->registers.hl);
+    return Common::Formatter::format("JP $%04x", processor.registers.hl);
 }
 
 template<>
-std::string Instructions::RRA(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RRA(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "RRA";
 }
 
 template<>
-std::string Instructions::RET_CC(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RET_CC(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string compare = Disassembler::CCTable[instruction.code.y];
     return Common::Formatter::format("RET %s", compare.c_str());
 }
 
 template<>
-std::string Instructions::RLC(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RLC(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("RLC %s", R.c_str());
 }
 
 template<>
-std::string Instructions::CP_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "CP");
+std::string Instructions::CP_A(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "CP");
 }
 
 template<>
-std::string Instructions::LDH_A_N(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LDH_A_N(Processor &processor, Instruction instruction) {
     (void)instruction;
-    uint8_t value = processor->memory->load(processor->registers.pc + 1, false);
+    uint8_t value = processor.memory->load(processor.registers.pc + 1, false);
     return Common::Formatter::format("LD A,($FF00+$%02x)", value);
 }
 
 template<>
-std::string Instructions::BIT(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::BIT(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("BIT %d,%s", instruction.code.y, R.c_str());
 }
 
 template<>
-std::string Instructions::LDH_C_A(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LDH_C_A(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "LD ($FF00+C),A";
 }
 
 template<>
-std::string Instructions::LDH_A_C(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LDH_A_C(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "LD A,($FF00+C)";
 }
 
 template<>
-std::string Instructions::RL(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RL(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("RL %s", R.c_str());
 }
 
 template<>
-std::string Instructions::RLA(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RLA(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "RLA";
 }
 
 template<>
-std::string Instructions::SUB(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "SUB");
+std::string Instructions::SUB(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "SUB");
 }
 
 template<>
-std::string Instructions::AND(std::unique_ptr<Processor> &processor, Instruction instruction) {
-    return processor->disassembleArithmetic(instruction, "AND");
+std::string Instructions::AND(Processor &processor, Instruction instruction) {
+    return processor.disassembleArithmetic(instruction, "AND");
 }
 
 template<>
-std::string Instructions::SET(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::SET(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("SET %d,%s", instruction.code.y, R.c_str());
 }
 
 template<>
-std::string Instructions::ADD_HL_RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::ADD_HL_RR(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string RR = Disassembler::RPTable[instruction.code.p];
     return Common::Formatter::format("ADD HL,%s", RR.c_str());
 }
 
 template<>
-std::string Instructions::RES(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RES(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("RES %d,%s", instruction.code.y, R.c_str());
 }
 
 template<>
-std::string Instructions::SRA(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::SRA(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("SRA %s", R.c_str());
 }
 
 template<>
-std::string Instructions::SWAP(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::SWAP(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("SWAP %s", R.c_str());
 }
 
 template<>
-std::string Instructions::JP_CC_NN(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::JP_CC_NN(Processor &processor, Instruction instruction) {
     std::string compare = Disassembler::CCTable[instruction.code.y];
-    uint16_t destination = processor->memory->loadDoubleWord(processor->registers.pc + 1, false);
+    uint16_t destination = processor.memory->loadDoubleWord(processor.registers.pc + 1, false);
     return Common::Formatter::format("JP %s,$%04x", compare.c_str(), destination);
 }
 
 template<>
-std::string Instructions::LD_HL_SP_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_HL_SP_I8(Processor &processor, Instruction instruction) {
     (void)instruction;
-    int8_t value = processor->memory->load(processor->registers.pc + 1, false);
-    uint16_t result = processor->registers.sp + value;
+    int8_t value = processor.memory->load(processor.registers.pc + 1, false);
+    uint16_t result = processor.registers.sp + value;
     return Common::Formatter::format("LD HL,$%04x", result);
 }
 
 template<>
-std::string Instructions::SLA(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::SLA(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("SLA %s", R.c_str());
 }
 
 template<>
-std::string Instructions::RR(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RR(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("RR %s", R.c_str());
 }
 
 template<>
-std::string Instructions::RRC(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RRC(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("RRC %s", R.c_str());
 }
 
 template<>
-std::string Instructions::LD_SP_HL(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::LD_SP_HL(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return Common::Formatter::format("LD SP,HL");
 }
 
 template<>
-std::string Instructions::ADD_SP_I8(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::ADD_SP_I8(Processor &processor, Instruction instruction) {
     (void)instruction;
-    int8_t value = processor->memory->load(processor->registers.pc + 1, false);
+    int8_t value = processor.memory->load(processor.registers.pc + 1, false);
     return Common::Formatter::format("ADD SP,$%02x", value);
 }
 
 template<>
-std::string Instructions::RETI(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RETI(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "RETI";
 }
 
 template<>
-std::string Instructions::DAA(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::DAA(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "DAA";
 }
 
 template<>
-std::string Instructions::CPL(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::CPL(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "CPL";
 }
 
 template<>
-std::string Instructions::SCF(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::SCF(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "SCF";
 }
 
 template<>
-std::string Instructions::CCF(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::CCF(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "CCF";
 }
 
 template<>
-std::string Instructions::RRCA(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::RRCA(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "RRCA";
 }
 
 template<>
-std::string Instructions::SRL(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::SRL(Processor &processor, Instruction instruction) {
     (void)processor;
     std::string R = Disassembler::RTable[instruction.code.z];
     return Common::Formatter::format("SRL %s", R.c_str());
 }
 
 template<>
-std::string Instructions::HALT(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::HALT(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "HALT";
 }
 
 template<>
-std::string Instructions::HALTED(std::unique_ptr<Processor> &processor, Instruction instruction) {
+std::string Instructions::HALTED(Processor &processor, Instruction instruction) {
     (void)processor;
     (void)instruction;
     return "HALTED";
@@ -25,6 +25,15 @@ namespace Core {
                 Code(uint8_t value) : _value(value) {}
             };
 
+            template<uint8_t Opcode>
+            struct StaticCode {
+                static constexpr uint8_t x = Opcode >> 6;
+                static constexpr uint8_t y = (Opcode >> 3) & 0x7;
+                static constexpr uint8_t z = Opcode & 0x7;
+                static constexpr uint8_t p = y >> 1;
+                static constexpr uint8_t q = y & 0x1;
+            };
+
             struct Instruction {
                 Code code;
                 bool isPrefixed;
@@ -36,138 +45,273 @@ namespace Core {
             const uint8_t InstructionPrefix = 0xCB;
 
             template<typename T>
-            T NOP(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T NOP(Processor &processor, Instruction instruction);
             template<typename T>
-            T JP_U16(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T JP_U16(Processor &processor, Instruction instruction);
             template<typename T>
-            T DI(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T DI(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_RR_NN(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_RR_NN(Processor &processor, Instruction instruction);
             template<typename T>
-            T RST_N(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RST_N(Processor &processor, Instruction instruction);
             template<typename T>
-            T INC_R(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T INC_R(Processor &processor, Instruction instruction);
             template<typename T>
-            T RET(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RET(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_NN_A(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_NN_A(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_U8(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_U8(Processor &processor, Instruction instruction);
             template<typename T>
-            T LDH_N_A(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LDH_N_A(Processor &processor, Instruction instruction);
             template<typename T>
-            T DEC_RR(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T DEC_RR(Processor &processor, Instruction instruction);
             template<typename T>
-            T CALL_NN(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T CALL_NN(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_R_R(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_R_R(Processor &processor, Instruction instruction);
             template<typename T>
-            T JR_I8(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T JR_I8(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_INDIRECT(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_INDIRECT(Processor &processor, Instruction instruction);
             template<typename T>
-            T PUSH_RR(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T PUSH_RR(Processor &processor, Instruction instruction);
             template<typename T>
-            T POP_RR(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T POP_RR(Processor &processor, Instruction instruction);
             template<typename T>
-            T INC_RR(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T INC_RR(Processor &processor, Instruction instruction);
             template<typename T>
-            T EI(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T EI(Processor &processor, Instruction instruction);
             template<typename T>
-            T OR(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T OR(Processor &processor, Instruction instruction);
             template<typename T>
-            T JR_CC_I8(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T JR_CC_I8(Processor &processor, Instruction instruction);
             template<typename T>
-            T STOP(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T STOP(Processor &processor, Instruction instruction);
             template<typename T>
-            T CALL_CC_NN(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T CALL_CC_NN(Processor &processor, Instruction instruction);
             template<typename T>
-            T ADD(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T ADD(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_NN_SP(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_NN_SP(Processor &processor, Instruction instruction);
             template<typename T>
-            T RLCA(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RLCA(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_A_NN(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_A_NN(Processor &processor, Instruction instruction);
             template<typename T>
-            T SBC_A(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SBC_A(Processor &processor, Instruction instruction);
             template<typename T>
-            T DEC_R(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T DEC_R(Processor &processor, Instruction instruction);
             template<typename T>
-            T XOR_A(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T XOR_A(Processor &processor, Instruction instruction);
             template<typename T>
-            T ADC_A(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T ADC_A(Processor &processor, Instruction instruction);
             template<typename T>
-            T JP_HL(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T JP_HL(Processor &processor, Instruction instruction);
             template<typename T>
-            T RRA(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RRA(Processor &processor, Instruction instruction);
             template<typename T>
-            T RET_CC(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RET_CC(Processor &processor, Instruction instruction);
             template<typename T>
-            T RLC(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RLC(Processor &processor, Instruction instruction);
             template<typename T>
-            T CP_A(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T CP_A(Processor &processor, Instruction instruction);
             template<typename T>
-            T LDH_A_N(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LDH_A_N(Processor &processor, Instruction instruction);
             template<typename T>
-            T BIT(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T BIT(Processor &processor, Instruction instruction);
             template<typename T>
-            T LDH_C_A(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LDH_C_A(Processor &processor, Instruction instruction);
             template<typename T>
-            T LDH_A_C(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LDH_A_C(Processor &processor, Instruction instruction);
             template<typename T>
-            T RL(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RL(Processor &processor, Instruction instruction);
             template<typename T>
-            T RLA(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RLA(Processor &processor, Instruction instruction);
             template<typename T>
-            T SUB(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SUB(Processor &processor, Instruction instruction);
             template<typename T>
-            T AND(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T AND(Processor &processor, Instruction instruction);
             template<typename T>
-            T SET(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SET(Processor &processor, Instruction instruction);
             template<typename T>
-            T ADD_HL_RR(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T ADD_HL_RR(Processor &processor, Instruction instruction);
             template<typename T>
-            T RES(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RES(Processor &processor, Instruction instruction);
             template<typename T>
-            T SRA(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SRA(Processor &processor, Instruction instruction);
             template<typename T>
-            T SWAP(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SWAP(Processor &processor, Instruction instruction);
             template<typename T>
-            T JP_CC_NN(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T JP_CC_NN(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_HL_SP_I8(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_HL_SP_I8(Processor &processor, Instruction instruction);
             template<typename T>
-            T SLA(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SLA(Processor &processor, Instruction instruction);
             template<typename T>
-            T RR(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RR(Processor &processor, Instruction instruction);
             template<typename T>
-            T RRC(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RRC(Processor &processor, Instruction instruction);
             template<typename T>
-            T LD_SP_HL(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T LD_SP_HL(Processor &processor, Instruction instruction);
             template<typename T>
-            T ADD_SP_I8(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T ADD_SP_I8(Processor &processor, Instruction instruction);
             template<typename T>
-            T RETI(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RETI(Processor &processor, Instruction instruction);
             template<typename T>
-            T DAA(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T DAA(Processor &processor, Instruction instruction);
             template<typename T>
-            T CPL(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T CPL(Processor &processor, Instruction instruction);
             template<typename T>
-            T SCF(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SCF(Processor &processor, Instruction instruction);
             template<typename T>
-            T CCF(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T CCF(Processor &processor, Instruction instruction);
             template<typename T>
-            T RRCA(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T RRCA(Processor &processor, Instruction instruction);
             template<typename T>
-            T SRL(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T SRL(Processor &processor, Instruction instruction);
             template<typename T>
-            T HALT(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T HALT(Processor &processor, Instruction instruction);
             template<typename T>
-            T HALTED(std::unique_ptr<Processor> &processor, Instruction instruction);
+            T HALTED(Processor &processor, Instruction instruction);
+
+            template<uint8_t Opcode>
+            void NOP(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void JP_U16(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void DI(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_RR_NN(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RST_N(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void INC_R(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RET(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_NN_A(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_U8(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LDH_N_A(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void DEC_RR(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void CALL_NN(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_R_R(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void JR_I8(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_INDIRECT(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void PUSH_RR(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void POP_RR(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void INC_RR(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void EI(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void OR(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void JR_CC_I8(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void STOP(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void CALL_CC_NN(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void ADD(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_NN_SP(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RLCA(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_A_NN(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SBC_A(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void DEC_R(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void XOR_A(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void ADC_A(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void JP_HL(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RRA(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RET_CC(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RLC(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void CP_A(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LDH_A_N(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void BIT(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LDH_C_A(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LDH_A_C(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RL(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RLA(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SUB(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void AND(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SET(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void ADD_HL_RR(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RES(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SRA(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SWAP(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void JP_CC_NN(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_HL_SP_I8(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SLA(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RR(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RRC(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void LD_SP_HL(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void ADD_SP_I8(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RETI(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void DAA(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void CPL(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SCF(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void CCF(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void RRCA(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void SRL(Processor &processor, Instruction instruction);
+            template<uint8_t Opcode>
+            void HALT(Processor &processor, Instruction instruction);
 
             template<typename T>
-            using InstructionHandler = T (*) (std::unique_ptr<Core::CPU::Processor> &processor, Core::CPU::Instructions::Instruction instruction);
+            using InstructionHandler = T (*) (Core::CPU::Processor &processor, Core::CPU::Instructions::Instruction instruction);
+
+            struct DecodedInstruction {
+                InstructionHandler<void> handler;
+                Instruction instruction;
+                uint8_t offset;
+            };
         };
     };
 };
@@ -1,5 +1,6 @@
 #pragma once
-#include <memory>
+#include <array>
+#include <utility>
 #include "core/cpu/CPU.hpp"
 #include "core/cpu/CPU.tcc"
 #include "core/cpu/Disassembler.tcc"
@@ -8,48 +9,28 @@ namespace Core {
     namespace CPU {
         namespace Instructions {
             template <typename T>
-            const std::vector<InstructionHandler<T>> InstructionHandlerTable = {
-            //    +0         +1        +2           +3      +4          +5       +6      +7      +8           +9         +A           +B      +C          +D          +E      +F
-            /*0+*/ NOP,      LD_RR_NN, LD_INDIRECT, INC_RR, INC_R,      DEC_R,   LD_U8,  RLCA,   LD_NN_SP,    ADD_HL_RR, LD_INDIRECT, DEC_RR, INC_R,      DEC_R,      LD_U8,  RRCA,
-            /*1+*/ STOP,     LD_RR_NN, LD_INDIRECT, INC_RR, INC_R,      DEC_R,   LD_U8,  RLA,    JR_I8,       ADD_HL_RR, LD_INDIRECT, DEC_RR, INC_R,      DEC_R,      LD_U8,  RRA,
-            /*2+*/ JR_CC_I8, LD_RR_NN, LD_INDIRECT, INC_RR, INC_R,      DEC_R,   LD_U8,  DAA,    JR_CC_I8,    ADD_HL_RR, LD_INDIRECT, DEC_RR, INC_R,      DEC_R,      LD_U8,  CPL,
-            /*3+*/ JR_CC_I8, LD_RR_NN, LD_INDIRECT, INC_RR, INC_R,      DEC_R,   LD_U8,  SCF,    JR_CC_I8,    ADD_HL_RR, LD_INDIRECT, DEC_RR, INC_R,      DEC_R,      LD_U8,  CCF,
-            /*4+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,  LD_R_R, LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,     LD_R_R, LD_R_R,
-            /*5+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,  LD_R_R, LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,     LD_R_R, LD_R_R,
-            /*6+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,  LD_R_R, LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,     LD_R_R, LD_R_R,
-            /*7+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,  HALT,   LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R, LD_R_R,     LD_R_R,     LD_R_R, LD_R_R,
-            /*8+*/ ADD,      ADD,      ADD,         ADD,    ADD,        ADD,     ADD,    ADD,    ADC_A,       ADC_A,     ADC_A,       ADC_A,  ADC_A,      ADC_A,      ADC_A,  ADC_A,
-            /*9+*/ SUB,      SUB,      SUB,         SUB,    SUB,        SUB,     SUB,    SUB,    SBC_A,       SBC_A,     SBC_A,       SBC_A,  SBC_A,      SBC_A,      SBC_A,  SBC_A,
-            /*A+*/ AND,      AND,      AND,         AND,    AND,        AND,     AND,    AND,    XOR_A,       XOR_A,     XOR_A,       XOR_A,  XOR_A,      XOR_A,      XOR_A,  XOR_A,
-            /*B+*/ OR,       OR,       OR,          OR,     OR,         OR,      OR,     OR,     CP_A,        CP_A,      CP_A,        CP_A,   CP_A,       CP_A,       CP_A,   CP_A,
-            /*C+*/ RET_CC,   POP_RR,   JP_CC_NN,    JP_U16, CALL_CC_NN, PUSH_RR, ADD,    RST_N,  RET_CC,      RET,       JP_CC_NN,    NULL,   CALL_CC_NN, CALL_NN,    ADC_A,  RST_N,
-            /*D+*/ RET_CC,   POP_RR,   JP_CC_NN,    NULL,   CALL_CC_NN, PUSH_RR, SUB,    RST_N,  RET_CC,      RETI,      JP_CC_NN,    NULL,   CALL_CC_NN, NULL,       SBC_A,  RST_N,
-            /*E+*/ LDH_N_A,  POP_RR,   LDH_C_A,     NULL,   NULL,       PUSH_RR, AND,    RST_N,  ADD_SP_I8,   JP_HL,     LD_NN_A,     NULL,   NULL,       NULL,       XOR_A,  RST_N,
-            /*F+*/ LDH_A_N,  POP_RR,   LDH_A_C,     DI,     NULL,       PUSH_RR, OR,     RST_N,  LD_HL_SP_I8, LD_SP_HL,  LD_A_NN,     EI,     NULL,       NULL,       CP_A,   RST_N,
-            };
-
-            const std::vector<uint8_t> InstructionSizeTable = {
-            //     +0 +1 +2 +3    +4    +5 +6 +7 +8 +9 +A +B     +C    +D    +E +F
-            /*0+*/ 1, 3, 1, 1,    1,    1, 2, 1, 3, 1, 1, 1,     1,    1,    2, 1,
-            /*1+*/ 2, 3, 1, 1,    1,    1, 2, 1, 2, 1, 1, 1,     1,    1,    2, 1,
-            /*2+*/ 2, 3, 1, 1,    1,    1, 2, 1, 2, 1, 1, 1,     1,    1,    2, 1,
-            /*3+*/ 2, 3, 1, 1,    1,    1, 2, 1, 2, 1, 1, 1,     1,    1,    2, 1,
-            /*4+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*5+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*6+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*7+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*8+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*9+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*A+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*B+*/ 1, 1, 1, 1,    1,    1, 1, 1, 1, 1, 1, 1,     1,    1,    1, 1,
-            /*C+*/ 1, 1, 3, 3,    3,    1, 2, 1, 1, 1, 3, 1,     3,    3,    2, 1,
-            /*D+*/ 1, 1, 3, NULL, 3,    1, 2, 1, 1, 1, 3, NULL,  3,    NULL, 2, 1,
-            /*E+*/ 2, 1, 1, NULL, NULL, 1, 2, 1, 2, 1, 3, NULL,  NULL, NULL, 2, 1,
-            /*F+*/ 2, 1, 1, 1,    NULL, 1, 2, 1, 2, 1, 3, 1,     NULL, NULL, 2, 1,
+            constexpr std::array<InstructionHandler<T>, 0x100> InstructionHandlerTable = {
+            //     +0        +1        +2           +3       +4          +5       +6      +7      +8           +9         +A           +B       +C          +D       +E      +F
+            /*0+*/ NOP,      LD_RR_NN, LD_INDIRECT, INC_RR,  INC_R,      DEC_R,   LD_U8,  RLCA,   LD_NN_SP,    ADD_HL_RR, LD_INDIRECT, DEC_RR,  INC_R,      DEC_R,   LD_U8,  RRCA,
+            /*1+*/ STOP,     LD_RR_NN, LD_INDIRECT, INC_RR,  INC_R,      DEC_R,   LD_U8,  RLA,    JR_I8,       ADD_HL_RR, LD_INDIRECT, DEC_RR,  INC_R,      DEC_R,   LD_U8,  RRA,
+            /*2+*/ JR_CC_I8, LD_RR_NN, LD_INDIRECT, INC_RR,  INC_R,      DEC_R,   LD_U8,  DAA,    JR_CC_I8,    ADD_HL_RR, LD_INDIRECT, DEC_RR,  INC_R,      DEC_R,   LD_U8,  CPL,
+            /*3+*/ JR_CC_I8, LD_RR_NN, LD_INDIRECT, INC_RR,  INC_R,      DEC_R,   LD_U8,  SCF,    JR_CC_I8,    ADD_HL_RR, LD_INDIRECT, DEC_RR,  INC_R,      DEC_R,   LD_U8,  CCF,
+            /*4+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  LD_R_R, LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  LD_R_R, LD_R_R,
+            /*5+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  LD_R_R, LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  LD_R_R, LD_R_R,
+            /*6+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  LD_R_R, LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  LD_R_R, LD_R_R,
+            /*7+*/ LD_R_R,   LD_R_R,   LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  HALT,   LD_R_R, LD_R_R,      LD_R_R,    LD_R_R,      LD_R_R,  LD_R_R,     LD_R_R,  LD_R_R, LD_R_R,
+            /*8+*/ ADD,      ADD,      ADD,         ADD,     ADD,        ADD,     ADD,    ADD,    ADC_A,       ADC_A,     ADC_A,       ADC_A,   ADC_A,      ADC_A,   ADC_A,  ADC_A,
+            /*9+*/ SUB,      SUB,      SUB,         SUB,     SUB,        SUB,     SUB,    SUB,    SBC_A,       SBC_A,     SBC_A,       SBC_A,   SBC_A,      SBC_A,   SBC_A,  SBC_A,
+            /*A+*/ AND,      AND,      AND,         AND,     AND,        AND,     AND,    AND,    XOR_A,       XOR_A,     XOR_A,       XOR_A,   XOR_A,      XOR_A,   XOR_A,  XOR_A,
+            /*B+*/ OR,       OR,       OR,          OR,      OR,         OR,      OR,     OR,     CP_A,        CP_A,      CP_A,        CP_A,    CP_A,       CP_A,    CP_A,   CP_A,
+            /*C+*/ RET_CC,   POP_RR,   JP_CC_NN,    JP_U16,  CALL_CC_NN, PUSH_RR, ADD,    RST_N,  RET_CC,      RET,       JP_CC_NN,    nullptr, CALL_CC_NN, CALL_NN, ADC_A,  RST_N,
+            /*D+*/ RET_CC,   POP_RR,   JP_CC_NN,    nullptr, CALL_CC_NN, PUSH_RR, SUB,    RST_N,  RET_CC,      RETI,      JP_CC_NN,    nullptr, CALL_CC_NN, nullptr, SBC_A,  RST_N,
+            /*E+*/ LDH_N_A,  POP_RR,   LDH_C_A,     nullptr, nullptr,    PUSH_RR, AND,    RST_N,  ADD_SP_I8,   JP_HL,     LD_NN_A,     nullptr, nullptr,    nullptr, XOR_A,  RST_N,
+            /*F+*/ LDH_A_N,  POP_RR,   LDH_A_C,     DI,      nullptr,    PUSH_RR, OR,     RST_N,  LD_HL_SP_I8, LD_SP_HL,  LD_A_NN,     EI,      nullptr,    nullptr, CP_A,   RST_N,
             };
 
             template <typename T>
-            const std::vector<InstructionHandler<T>> PrefixedInstructionHandlerTable = {
+            constexpr std::array<InstructionHandler<T>, 0x100> PrefixedInstructionHandlerTable = {
             //    +0    +1    +2    +3    +4    +5    +6    +7    +8    +9    +A    +B    +C    +D    +E    +F
             /*0+*/RLC,  RLC,  RLC,  RLC,  RLC,  RLC,  RLC,  RLC,  RRC,  RRC,  RRC,  RRC,  RRC,  RRC,  RRC,  RRC,
             /*1+*/RL,   RL,   RL,   RL,   RL,   RL,   RL,   RL,   RR,   RR,   RR,   RR,   RR,   RR,   RR,   RR,
@@ -68,6 +49,200 @@ namespace Core {
             /*E+*/SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,
             /*F+*/SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,  SET,
             };
+
+            // Executed instructions are resolved at compile time from the opcode x/y/z/p/q fields, so each handler has its
+            // registers, condition and operation baked in. The generic tables above are still used by the disassembler.
+            template<uint8_t Opcode>
+            constexpr InstructionHandler<void> StaticInstructionHandler() {
+                using Code = StaticCode<Opcode>;
+                if constexpr (Code::x == 0) {
+                    if constexpr (Code::z == 0) {
+                        if constexpr (Code::y == 0) {
+                            return NOP<Opcode>;
+                        } else if constexpr (Code::y == 1) {
+                            return LD_NN_SP<Opcode>;
+                        } else if constexpr (Code::y == 2) {
+                            return STOP<Opcode>;
+                        } else if constexpr (Code::y == 3) {
+                            return JR_I8<Opcode>;
+                        } else {
+                            return JR_CC_I8<Opcode>;
+                        }
+                    } else if constexpr (Code::z == 1) {
+                        if constexpr (Code::q == 0) {
+                            return LD_RR_NN<Opcode>;
+                        } else {
+                            return ADD_HL_RR<Opcode>;
+                        }
+                    } else if constexpr (Code::z == 2) {
+                        return LD_INDIRECT<Opcode>;
+                    } else if constexpr (Code::z == 3) {
+                        if constexpr (Code::q == 0) {
+                            return INC_RR<Opcode>;
+                        } else {
+                            return DEC_RR<Opcode>;
+                        }
+                    } else if constexpr (Code::z == 4) {
+                        return INC_R<Opcode>;
+                    } else if constexpr (Code::z == 5) {
+                        return DEC_R<Opcode>;
+                    } else if constexpr (Code::z == 6) {
+                        return LD_U8<Opcode>;
+                    } else {
+                        if constexpr (Code::y == 0) {
+                            return RLCA<Opcode>;
+                        } else if constexpr (Code::y == 1) {
+                            return RRCA<Opcode>;
+                        } else if constexpr (Code::y == 2) {
+                            return RLA<Opcode>;
+                        } else if constexpr (Code::y == 3) {
+                            return RRA<Opcode>;
+                        } else if constexpr (Code::y == 4) {
+                            return DAA<Opcode>;
+                        } else if constexpr (Code::y == 5) {
+                            return CPL<Opcode>;
+                        } else if constexpr (Code::y == 6) {
+                            return SCF<Opcode>;
+                        } else {
+                            return CCF<Opcode>;
+                        }
+                    }
+                } else if constexpr (Code::x == 1) {
+                    if constexpr (Code::y == 6 && Code::z == 6) {
+                        return HALT<Opcode>;
+                    } else {
+                        return LD_R_R<Opcode>;
+                    }
+                } else if constexpr (Code::x == 2 || (Code::x == 3 && Code::z == 6)) {
+                    if constexpr (Code::y == 0) {
+                        return ADD<Opcode>;
+                    } else if constexpr (Code::y == 1) {
+                        return ADC_A<Opcode>;
+                    } else if constexpr (Code::y == 2) {
+                        return SUB<Opcode>;
+                    } else if constexpr (Code::y == 3) {
+                        return SBC_A<Opcode>;
+                    } else if constexpr (Code::y == 4) {
+                        return AND<Opcode>;
+                    } else if constexpr (Code::y == 5) {
+                        return XOR_A<Opcode>;
+                    } else if constexpr (Code::y == 6) {
+                        return OR<Opcode>;
+                    } else {
+                        return CP_A<Opcode>;
+                    }
+                } else {
+                    if constexpr (Code::z == 0) {
+                        if constexpr (Code::y < 4) {
+                            return RET_CC<Opcode>;
+                        } else if constexpr (Code::y == 4) {
+                            return LDH_N_A<Opcode>;
+                        } else if constexpr (Code::y == 5) {
+                            return ADD_SP_I8<Opcode>;
+                        } else if constexpr (Code::y == 6) {
+                            return LDH_A_N<Opcode>;
+                        } else {
+                            return LD_HL_SP_I8<Opcode>;
+                        }
+                    } else if constexpr (Code::z == 1) {
+                        if constexpr (Code::q == 0) {
+                            return POP_RR<Opcode>;
+                        } else if constexpr (Code::p == 0) {
+                            return RET<Opcode>;
+                        } else if constexpr (Code::p == 1) {
+                            return RETI<Opcode>;
+                        } else if constexpr (Code::p == 2) {
+                            return JP_HL<Opcode>;
+                        } else {
+                            return LD_SP_HL<Opcode>;
+                        }
+                    } else if constexpr (Code::z == 2) {
+                        if constexpr (Code::y < 4) {
+                            return JP_CC_NN<Opcode>;
+                        } else if constexpr (Code::y == 4) {
+                            return LDH_C_A<Opcode>;
+                        } else if constexpr (Code::y == 5) {
+                            return LD_NN_A<Opcode>;
+                        } else if constexpr (Code::y == 6) {
+                            return LDH_A_C<Opcode>;
+                        } else {
+                            return LD_A_NN<Opcode>;
+                        }
+                    } else if constexpr (Code::z == 3) {
+                        if constexpr (Code::y == 0) {
+                            return JP_U16<Opcode>;
+                        } else if constexpr (Code::y == 6) {
+                            return DI<Opcode>;
+                        } else if constexpr (Code::y == 7) {
+                            return EI<Opcode>;
+                        } else {
+                            return nullptr;
+                        }
+                    } else if constexpr (Code::z == 4) {
+                        if constexpr (Code::y < 4) {
+                            return CALL_CC_NN<Opcode>;
+                        } else {
+                            return nullptr;
+                        }
+                    } else if constexpr (Code::z == 5) {
+                        if constexpr (Code::q == 0) {
+                            return PUSH_RR<Opcode>;
+                        } else if constexpr (Code::p == 0) {
+                            return CALL_NN<Opcode>;
+                        } else {
+                            return nullptr;
+                        }
+                    } else {
+                        return RST_N<Opcode>;
+                    }
+                }
+            }
+
+            template<uint8_t Opcode>
+            constexpr InstructionHandler<void> StaticPrefixedInstructionHandler() {
+                using Code = StaticCode<Opcode>;
+                if constexpr (Code::x == 0) {
+                    if constexpr (Code::y == 0) {
+                        return RLC<Opcode>;
+                    } else if constexpr (Code::y == 1) {
+                        return RRC<Opcode>;
+                    } else if constexpr (Code::y == 2) {
+                        return RL<Opcode>;
+                    } else if constexpr (Code::y == 3) {
+                        return RR<Opcode>;
+                    } else if constexpr (Code::y == 4) {
+                        return SLA<Opcode>;
+                    } else if constexpr (Code::y == 5) {
+                        return SRA<Opcode>;
+                    } else if constexpr (Code::y == 6) {
+                        return SWAP<Opcode>;
+                    } else {
+                        return SRL<Opcode>;
+                    }
+                } else if constexpr (Code::x == 1) {
+                    return BIT<Opcode>;
+                } else if constexpr (Code::x == 2) {
+                    return RES<Opcode>;
+                } else {
+                    return SET<Opcode>;
+                }
+            }
+
+            template<size_t... Opcodes>
+            constexpr std::array<InstructionHandler<void>, 0x100> StaticInstructionHandlerTable(std::index_sequence<Opcodes...>) {
+                return { StaticInstructionHandler<Opcodes>()... };
+            }
+
+            template<size_t... Opcodes>
+            constexpr std::array<InstructionHandler<void>, 0x100> StaticPrefixedInstructionHandlerTable(std::index_sequence<Opcodes...>) {
+                return { StaticPrefixedInstructionHandler<Opcodes>()... };
+            }
+
+            template<>
+            constexpr std::array<InstructionHandler<void>, 0x100> InstructionHandlerTable<void> = StaticInstructionHandlerTable(std::make_index_sequence<0x100>());
+
+            template<>
+            constexpr std::array<InstructionHandler<void>, 0x100> PrefixedInstructionHandlerTable<void> = StaticPrefixedInstructionHandlerTable(std::make_index_sequence<0x100>());
         };
     };
 };
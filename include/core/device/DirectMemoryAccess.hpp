@@ -4,6 +4,8 @@
 #include "common/Logger.hpp"
 #include <vector>
 #include "core/ROM.hpp"
+#include "core/Scheduler.hpp"
+#include "core/SaveState.hpp"
 #include <optional>
 
 namespace Core {
@@ -61,6 +63,7 @@ namespace Core {
             class Controller {
                 Common::Logs::Logger logger;
                 Core::Memory::Controller *memoryController;
+                std::unique_ptr<Core::Scheduler::Scheduler> &scheduler;
 
                 std::vector<DMA::Request> requests;
 
@@ -74,18 +77,24 @@ namespace Core {
 
                 Core::ROM::CGBFlag cgbFlag;
 
+                uint64_t lastSynchronization;
+
                 void executeHDMA();
             public:
-                Controller(Common::Logs::Level logLevel);
+                Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Scheduler::Scheduler> &scheduler);
                 ~Controller();
 
                 void setMemoryController(std::unique_ptr<Core::Memory::Controller> &memoryController);
                 void execute(uint8_t value);
-                void step(uint8_t cycles);
+                void handleTransfer();
                 bool isActive() const;
                 uint8_t HDMALoad(uint16_t offset) const;
                 void HDMAStore(uint16_t offset, uint8_t value);
                 void stepHBlank();
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void copyState(const Controller &other);
             };
         };
     };
@@ -3,6 +3,7 @@
 #include "common/Logger.hpp"
 #include <memory>
 #include "core/Memory.hpp"
+#include "core/SaveState.hpp"
 
 namespace Core {
     namespace CPU {
@@ -73,6 +74,10 @@ namespace Core {
                 void storeEnable(uint8_t value);
                 uint8_t loadFlag() const;
                 void storeFlag(uint8_t value);
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void copyState(const Controller &other);
             };
         };
     };
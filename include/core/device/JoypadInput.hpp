@@ -2,7 +2,7 @@
 #include <memory>
 #include "common/Logger.hpp"
 #include "core/Memory.hpp"
-#include "shinobu/frontend/sdl2/GameController.hpp"
+#include "core/SaveState.hpp"
 
 namespace Core {
     namespace Device {
@@ -27,20 +27,43 @@ namespace Core {
 
             const Core::Memory::Range AddressRange = Core::Memory::Range(0xFF00, 0x1);
 
+            enum Button {
+                Up,
+                Down,
+                Left,
+                Right,
+                A,
+                B,
+                Start,
+                Select
+            };
+
+            class InputSource {
+            public:
+                virtual ~InputSource() {};
+                virtual bool isButtonPressed(Button button) const = 0;
+            };
+
             class Controller {
                 Common::Logs::Logger logger;
                 std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt;
 
                 Joypad joypad;
-                Shinobu::Frontend::SDL2::GameController gameController;
+                InputSource *inputSource;
+
+                bool isButtonPressed(Button button) const;
             public:
-                Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt, std::string controllerName);
+                Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt);
                 ~Controller();
 
                 uint8_t load() const;
                 void store(uint8_t value);
                 void updateJoypad();
-                bool hasGameController() const;
+                void setInputSource(InputSource *inputSource);
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void copyState(const Controller &other);
             };
         };
     };
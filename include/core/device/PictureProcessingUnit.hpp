@@ -2,19 +2,19 @@
 #include "core/Memory.hpp"
 #include "common/Logger.hpp"
 #include <vector>
-#include "shinobu/frontend/opengl/Vertex.hpp"
+#include "core/Viewer.hpp"
 #include "core/device/Interrupt.hpp"
 #include <unordered_map>
-#include "shinobu/frontend/Palette.hpp"
+#include "core/Palette.hpp"
 #include "core/ROM.hpp"
 #include "core/device/DirectMemoryAccess.hpp"
 #include "common/System.hpp"
+#include "core/device/TileRow.hpp"
+#include "core/SaveState.hpp"
+#include "core/PagedBuffer.hpp"
 
 namespace Shinobu {
     class Emulator;
-    namespace Frontend {
-        class Renderer;
-    };
 };
 
 namespace Core {
@@ -220,14 +220,82 @@ namespace Core {
                 Middle = 4,
             };
 
+            // Packed RGBA8 with red in the least significant byte, which is what
+            // GL_RGBA with GL_UNSIGNED_INT_8_8_8_8_REV expects on any host
+            typedef uint32_t Pixel;
+            typedef std::array<Pixel, 4> PixelPalette;
+            typedef std::array<Pixel, HorizontalResolution * VerticalResolution> Framebuffer;
+
+            Pixel packColor(Core::Palette::Color color);
+            PixelPalette packPalette(const Core::Palette::palette &colors);
+
+            // Every LCD pixel is stored as an entry of the palette of its line,
+            // colors are only resolved when a frame is presented. On DMG the
+            // entries 0-3, 4-7 and 8-11 hold the shades of BGP, OBP0 and OBP1.
+            // On CGB the entries are the raw 15 bit colors of the 8 background
+            // palettes followed by the 8 object palettes.
+            typedef std::array<uint8_t, HorizontalResolution * VerticalResolution> ColorIndexFramebuffer;
+            typedef std::array<uint16_t, LinePaletteSize> LinePalette;
+            typedef std::array<LinePalette, VerticalResolution> LinePalettes;
+
+            struct LCDOutput {
+                ColorIndexFramebuffer colorIndices;
+                LinePalettes linePalettes;
+            };
+
+            const uint8_t ObjectPaletteEntriesStart = LinePaletteSize / 2;
+            // Outside of the line palette: black while the LCD is off and the
+            // first color of the selected palette for blank pixels
+            const uint8_t BlackColorIndex = LinePaletteSize;
+            const uint8_t BlankColorIndex = LinePaletteSize + 1;
+
+            struct BackgroundScanline {
+                std::array<uint8_t, HorizontalResolution> colorIndices;
+                std::array<BackgroundMapAttributes, HorizontalResolution> attributes;
+            };
+
+            // A scanline touches at most 21 background tiles plus the first
+            // window tile
+            const int MaximumTileRowsPerScanline = 24;
+
+            struct BackgroundTileRows {
+                uint8_t count;
+                std::array<uint8_t, MaximumTileRowsPerScanline> lower;
+                std::array<uint8_t, MaximumTileRowsPerScanline> upper;
+                std::array<uint8_t, MaximumTileRowsPerScanline> firstPixel;
+                std::array<uint8_t, MaximumTileRowsPerScanline> length;
+                std::array<BackgroundMapAttributes, MaximumTileRowsPerScanline> attributes;
+                std::array<uint8_t, MaximumTileRowsPerScanline * VRAMTileDataSide> colorIndices;
+            };
+
+            // Sprites selected by the OAM scan of the current line, in
+            // drawing priority order
+            struct SpriteScanline {
+                uint8_t count;
+                std::array<Sprite, MaximumSpritesPerScanline> sprites;
+            };
+
+            const uint8_t NoSprite = 0xFF;
+
+            struct SpriteLineBuffer {
+                std::array<uint8_t, HorizontalResolution> spriteIndices;
+                std::array<uint8_t, HorizontalResolution> colorIndices;
+            };
+
+            class Renderer {
+            public:
+                virtual ~Renderer() {};
+                virtual void update() = 0;
+            };
+
             class Processor {
                 friend class Shinobu::Emulator;
 
                 Common::Logs::Logger logger;
                 std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt;
-                std::unique_ptr<Shinobu::Frontend::Palette::Selector> &paletteSelector;
+                std::unique_ptr<Core::Palette::Selector> &paletteSelector;
                 std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMAController;
-                std::array<uint8_t, 0x4000> memory;
+                Core::Memory::PagedBuffer memory;
                 std::array<uint8_t, 0xA0> spriteAttributeTable;
                 LCDControl control;
                 LCDStatus status;
@@ -243,10 +311,15 @@ namespace Core {
                 uint8_t windowLineCounter;
                 bool windowYPositionTrigger;
                 uint32_t steps;
+                uint32_t nextModeUpdateSteps;
                 uint8_t interruptConditions;
 
-                Shinobu::Frontend::Renderer *renderer;
-                std::vector<GLfloat> lcdData;
+                Renderer *renderer;
+                // Only allocated once a renderer is attached or the output is
+                // read, until then scanlines aren't drawn at all. This keeps
+                // headless machines and forks small.
+                std::unique_ptr<LCDOutput> lcd;
+                std::unique_ptr<Framebuffer> lcdData;
 
                 Core::Memory::Controller *memoryController;
                 uint8_t DMA;
@@ -262,33 +335,45 @@ namespace Core {
 
                 bool correctColors;
 
+                BackgroundScanline backgroundScanline;
+                BackgroundTileRows backgroundTileRows;
+                TileRow::Decoder tileRowDecoder;
+                SpriteScanline spriteScanline;
+                SpriteLineBuffer spriteLine;
+
                 uint16_t physicalAddressForAddress(uint16_t address) const;
 
                 std::array<uint8_t, 8> getTileRowPixelsColorIndicesWithData(uint8_t lower, uint8_t upper) const;
-                std::vector<Shinobu::Frontend::OpenGL::Vertex> getTileByIndex(uint16_t index, uint8_t bank, Shinobu::Frontend::Palette::palette paletteColors) const;
-                void translateTileOwnCoordinatesToTileDataViewerCoordinates(std::vector<Shinobu::Frontend::OpenGL::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<GLfloat>& data) const;
-                void translateTileOwnCoordinatesToBackgroundMapViewerCoordinates(std::vector<Shinobu::Frontend::OpenGL::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<GLfloat>& data) const;
-                void translateSpriteOwnCoordinatesToSpriteViewerCoordinates(std::vector<Shinobu::Frontend::OpenGL::Vertex> tile, SpriteTilePositionInViewer position, std::vector<GLfloat>& data) const;
+                std::vector<Core::Viewer::Vertex> getTileByIndex(uint16_t index, uint8_t bank, Core::Palette::palette paletteColors) const;
+                void translateTileOwnCoordinatesToTileDataViewerCoordinates(std::vector<Core::Viewer::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<float>& data) const;
+                void translateTileOwnCoordinatesToBackgroundMapViewerCoordinates(std::vector<Core::Viewer::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<float>& data) const;
+                void translateSpriteOwnCoordinatesToSpriteViewerCoordinates(std::vector<Core::Viewer::Vertex> tile, SpriteTilePositionInViewer position, std::vector<float>& data) const;
 
-                std::vector<Sprite> getSpriteData() const;
+                void updateMode();
                 void renderScanline();
-                std::vector<Sprite> getVisibleSprites() const;
+                void scanOAM(SpriteScanline &sprites) const;
+                void rasterizeSprites(const SpriteScanline &sprites, SpriteLineBuffer &line) const;
                 void DMG_renderScanline();
                 void CGB_renderScanline();
-                uint8_t getColorIndexForSpriteAtScreenHorizontalPosition(Sprite sprite, uint16_t screenPositionX) const;
-                std::pair<uint8_t, BackgroundMapAttributes> getColorIndexForBackgroundAtScreenHorizontalPosition(uint16_t screenPositionX) const;
-                std::vector<GLfloat> blankLCDData() const;
+                std::array<uint8_t, 8> getSpriteRowColorIndices(const Sprite &sprite) const;
+                uint16_t tileMapAddressStart(Background_WindowTileMapLocation location) const;
+                void fetchTileRow(uint16_t addressInBackgroundMap, uint8_t yInTile, uint8_t firstPixel, uint8_t length, BackgroundTileRows &tileRows) const;
+                void fetchBackgroundScanline(BackgroundScanline &scanline, BackgroundTileRows &tileRows) const;
+                void captureLinePalette();
+                void allocateLCD();
 
-                Shinobu::Frontend::Palette::palette cgbPaletteAtIndex(uint8_t index, bool isBackground) const;
+                Core::Palette::Color cgbColorForPaletteData(PaletteData paletteData) const;
+                Core::Palette::palette cgbPaletteAtIndex(uint8_t index, bool isBackground) const;
 
-                std::vector<Shinobu::Frontend::OpenGL::Vertex> getBackgroundTileByIndex(uint16_t index, BackgroundMapAttributes attributes) const;
+                std::vector<Core::Viewer::Vertex> getBackgroundTileByIndex(uint16_t index, BackgroundMapAttributes attributes) const;
             public:
-                Processor(Common::Logs::Level logLevel, bool correctColors, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt, std::unique_ptr<Shinobu::Frontend::Palette::Selector> &paletteSelector, std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMAController);
+                Processor(Common::Logs::Level logLevel, bool correctColors, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt, std::unique_ptr<Core::Palette::Selector> &paletteSelector, std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMAController);
                 ~Processor();
 
-                void setRenderer(Shinobu::Frontend::Renderer *renderer);
+                void setRenderer(Renderer *renderer);
                 void setMemoryController(std::unique_ptr<Core::Memory::Controller> &memoryController);
                 void setCGBFlag(Core::ROM::CGBFlag cgbFlag);
+                void shareMemory(const Processor &other);
 
                 uint8_t load(uint16_t offset) const;
                 void store(uint16_t offset, uint8_t value);
@@ -300,12 +385,32 @@ namespace Core {
                 void VBKStore(uint16_t offset, uint8_t value);
                 uint8_t colorPaletteLoad(uint16_t offset) const;
                 void colorPaletteStore(uint16_t offset, uint8_t value);
-                void step(uint8_t cycles);
-                std::vector<GLfloat> getTileData(uint8_t bank) const;
-                std::vector<GLfloat> getBackgroundMapData(BackgroundType type) const;
-                std::vector<Shinobu::Frontend::OpenGL::Vertex> getScrollingViewPort() const;
-                std::vector<GLfloat> getLCDData();
-                std::pair<Sprite, std::vector<GLfloat>> getSpriteAtIndex(uint8_t index) const;
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void copyState(const Processor &other);
+                // Steps within the same mode are only accumulated, the mode,
+                // STAT conditions and scanline are updated when the next
+                // boundary is reached or after a register write.
+                void step(uint8_t cycles) {
+                    if (!control.LCDDisplayEnable) {
+                        return;
+                    }
+                    steps += cycles;
+                    if (steps >= nextModeUpdateSteps) {
+                        updateMode();
+                    }
+                };
+                std::vector<float> getTileData(uint8_t bank) const;
+                std::vector<float> getBackgroundMapData(BackgroundType type) const;
+                std::vector<Core::Viewer::Vertex> getScrollingViewPort() const;
+                const ColorIndexFramebuffer &getLCDColorIndices();
+                const LinePalettes &getLCDLinePalettes();
+                bool usesCGBPalettes() const;
+                bool correctsColors() const;
+                Core::Palette::palette currentPaletteSelection() const;
+                const Framebuffer &getLCDData();
+                std::pair<Sprite, std::vector<float>> getSpriteAtIndex(uint8_t index) const;
                 uint8_t VRAMBank() const;
             };
         };
@@ -2,6 +2,8 @@
 #include <cstdint>
 #include "core/Memory.hpp"
 #include "common/Logger.hpp"
+#include "core/SaveState.hpp"
+#include "core/TestResult.hpp"
 
 namespace Core {
     namespace Device {
@@ -24,14 +26,21 @@ namespace Core {
                 uint8_t data;
                 ControlRegister control;
                 std::string ttyBuffer;
+                Core::TestResult::Result result;
 
                 void checkTTY(char c);
+                void checkTestResult();
             public:
                 Controller(Common::Logs::Level logLevel);
                 ~Controller();
 
                 uint8_t load(uint16_t offset);
                 void store(uint16_t offset, uint8_t value);
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void copyState(const Controller &other);
+                Core::TestResult::Result testResult() const;
             };
         };
     };
@@ -4,6 +4,7 @@
 #include <gb_apu/Multi_Buffer.h>
 #include "common/Logger.hpp"
 #include "core/Memory.hpp"
+#include "core/device/SoundRegisters.hpp"
 
 namespace Core {
     namespace Device {
@@ -15,12 +16,24 @@ namespace Core {
 
                 Gb_Apu apu;
                 Stereo_Buffer buffer;
+                // Cycles since the last Blip frame ended, register accesses
+                // are timestamped with it
                 blip_time_t time;
 
-                blip_time_t clock();
+                void endFrame();
                 bool muted;
+                bool turbo;
+                double rateAdjustment;
+                // Skips Gb_Apu entirely, registers are served by the model
+                bool nullAudio;
+                RegisterModel registers;
+                // Last value written to every register, Gb_Apu has no way to
+                // export its state so save states replay these instead
+                std::array<uint8_t, 0x30> registerFile;
+
+                void replayRegisters(const std::array<uint8_t, 0x30> &values, uint8_t status);
             public:
-                Controller(Common::Logs::Level logLevel, bool mute);
+                Controller(Common::Logs::Level logLevel, bool mute, bool nullAudio);
                 ~Controller();
 
                 uint8_t load(uint16_t address);
@@ -28,9 +41,16 @@ namespace Core {
                 long availableSamples() const;
                 typedef blip_sample_t sample_t;
                 long readSamples(sample_t* out, long count);
+                void discardSamples();
                 blargg_err_t setSampleRate(long rate);
                 void step(uint8_t cycles);
                 void toggleMute();
+                void setTurbo(bool enabled);
+                void setRateAdjustment(double adjustment);
+                void saveState(Core::SaveState::Writer &writer);
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void copyState(Controller &other);
             };
         };
     };
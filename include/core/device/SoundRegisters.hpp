@@ -0,0 +1,52 @@
+#pragma once
+#include <cstdint>
+#include <array>
+#include "core/SaveState.hpp"
+
+namespace Core {
+    namespace Device {
+        namespace Sound {
+            // Read back value of the unused bits of FF10-FF2F
+            const std::array<uint8_t, 0x20> RegisterReadMasks = {
+                0x80, 0x3F, 0x00, 0xFF, 0xBF,
+                0xFF, 0x3F, 0x00, 0xFF, 0xBF,
+                0x7F, 0xFF, 0x9F, 0xFF, 0xBF,
+                0xFF, 0xFF, 0x00, 0x00, 0xBF,
+                0x00, 0x00, 0x70,
+                0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+            };
+            const uint32_t FrameSequencerPeriod = 8192;
+
+            // Register side of the APU without any synthesis: keeps what games
+            // poll (NR52 channel status, length counters, sweep overflow and
+            // power) for runs where the audio output is discarded.
+            class RegisterModel {
+                std::array<uint8_t, 0x30> registers;
+                bool powered;
+                uint8_t enabledChannels;
+                std::array<uint16_t, 4> lengthCounters;
+                uint32_t sequencerCycles;
+                uint8_t sequencerStep;
+                uint16_t shadowFrequency;
+                uint8_t sweepTimer;
+                bool sweepEnabled;
+
+                bool isDACEnabled(uint8_t channel) const;
+                void trigger(uint8_t channel);
+                uint16_t nextSweepFrequency();
+                void clockLengthCounters();
+                void clockSweep();
+            public:
+                RegisterModel();
+                ~RegisterModel();
+
+                uint8_t load(uint16_t address) const;
+                void store(uint16_t address, uint8_t value);
+                void step(uint8_t cycles);
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+            };
+        };
+    };
+};
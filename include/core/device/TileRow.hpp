@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <utility>
+
+namespace Core {
+    namespace Device {
+        namespace PictureProcessingUnit {
+            namespace TileRow {
+                // Decodes count 2bpp tile rows, given by their lower and upper
+                // bit planes, into count * 8 color indices (leftmost pixel first).
+                typedef void (*Decoder)(const uint8_t *lower, const uint8_t *upper, uint8_t count, uint8_t *colorIndices);
+
+                constexpr uint64_t expandBits(uint8_t value) {
+                    uint64_t expanded = 0;
+                    for (uint8_t pixel = 0; pixel < 8; pixel++) {
+                        uint64_t bit = (value >> (7 - pixel)) & 0x1;
+                        expanded |= bit << (pixel * 8);
+                    }
+                    return expanded;
+                }
+
+                constexpr uint8_t reverseBits(uint8_t value) {
+                    uint8_t reversed = 0;
+                    for (uint8_t bit = 0; bit < 8; bit++) {
+                        reversed |= ((value >> bit) & 0x1) << (7 - bit);
+                    }
+                    return reversed;
+                }
+
+                template<size_t... Indices>
+                constexpr std::array<uint64_t, sizeof...(Indices)> generateExpandedBitsTable(std::index_sequence<Indices...>) {
+                    return { expandBits(Indices)... };
+                }
+
+                template<size_t... Indices>
+                constexpr std::array<uint8_t, sizeof...(Indices)> generateReversedBitsTable(std::index_sequence<Indices...>) {
+                    return { reverseBits(Indices)... };
+                }
+
+                // Every bit of a bit plane spread to its own byte, in memory order
+                constexpr std::array<uint64_t, 0x100> ExpandedBitsTable = generateExpandedBitsTable(std::make_index_sequence<0x100>());
+                // Bit planes of horizontally flipped tiles
+                constexpr std::array<uint8_t, 0x100> ReversedBitsTable = generateReversedBitsTable(std::make_index_sequence<0x100>());
+
+                void decodeScalar(const uint8_t *lower, const uint8_t *upper, uint8_t count, uint8_t *colorIndices);
+#if defined(__x86_64__) || defined(__i386__)
+                void decodeSSE2(const uint8_t *lower, const uint8_t *upper, uint8_t count, uint8_t *colorIndices);
+#endif
+#if defined(__aarch64__) || defined(__ARM_NEON)
+                void decodeNEON(const uint8_t *lower, const uint8_t *upper, uint8_t count, uint8_t *colorIndices);
+#endif
+                Decoder selectDecoder();
+            };
+        };
+    };
+};
@@ -3,7 +3,9 @@
 #include <memory>
 #include "core/device/Interrupt.hpp"
 #include "core/Memory.hpp"
+#include "core/Scheduler.hpp"
 #include "common/Timing.hpp"
+#include "core/SaveState.hpp"
 
 namespace Core {
     namespace Device {
@@ -24,6 +26,7 @@ namespace Core {
             class Controller {
                 Common::Logs::Logger logger;
                 std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt;
+                std::unique_ptr<Core::Scheduler::Scheduler> &scheduler;
 
                 uint16_t DIV;
                 uint8_t TIMA;
@@ -32,13 +35,24 @@ namespace Core {
 
                 bool lastResult;
                 bool overflown;
+                uint64_t lastSynchronization;
+
+                bool currentResult() const;
+                uint32_t stepsUntilFallingEdge() const;
+                void tick();
+                void synchronize();
+                void scheduleOverflow();
             public:
-                Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt);
+                Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt, std::unique_ptr<Core::Scheduler::Scheduler> &scheduler);
                 ~Controller();
 
-                uint8_t load(uint16_t offset) const;
+                uint8_t load(uint16_t offset);
                 void store(uint16_t offset, uint8_t value);
-                void step(uint8_t cycles);
+                void handleOverflow();
+                void saveState(Core::SaveState::Writer &writer) const;
+                void loadState(Core::SaveState::Reader &reader);
+                void validateState(Core::SaveState::Reader &reader) const;
+                void copyState(const Controller &other);
             };
         };
     };
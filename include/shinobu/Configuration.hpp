@@ -33,6 +33,8 @@ namespace Shinobu {
             std::string dmgBootstrapROM;
             std::string cgbBootstrapROM;
             bool colorCorrection;
+            int rewindInterval;
+            int rewindBuffer;
             bool screenDoorEffect;
             bool forceIntegerScale;
             std::string sentryDSN;
@@ -63,6 +65,8 @@ namespace Shinobu {
             std::string DMGBootstrapROM() const;
             std::string CGBBootstrapROM() const;
             bool shouldCorrectColors() const;
+            int rewindSnapshotInterval() const;
+            int rewindBufferSize() const;
             bool shouldEmulateScreenDoorEffect() const;
             bool shouldForceIntegerScale() const;
             std::string getSentryDSN() const;
@@ -1,21 +1,14 @@
 #pragma once
 #include <filesystem>
 #include <memory>
-#include "core/cpu/CPU.hpp"
-#include "core/ROM.hpp"
-#include "core/Memory.hpp"
-#include "core/device/PictureProcessingUnit.hpp"
-#include "core/device/Interrupt.hpp"
-#include "core/device/Timer.hpp"
-#include "core/cpu/Disassembler.hpp"
+#include <chrono>
+#include "core/Machine.hpp"
+#include "core/Rewind.hpp"
 #include "shinobu/frontend/sdl2/Window.hpp"
+#include "shinobu/frontend/sdl2/GameController.hpp"
 #include "shinobu/frontend/imgui/Renderer.hpp"
-#include "core/device/JoypadInput.hpp"
-#include "core/device/Sound.hpp"
-#include <gb_apu/Sound_Queue.h>
+#include "shinobu/frontend/sdl2/AudioDevice.hpp"
 #include "common/Logger.hpp"
-#include "shinobu/frontend/Palette.hpp"
-#include "core/device/DirectMemoryAccess.hpp"
 
 namespace Shinobu {
     namespace Program {
@@ -23,6 +16,7 @@ namespace Shinobu {
             std::filesystem::path ROMFilePath;
             bool skipBootROM;
             bool disassemble;
+            bool turbo;
         };
 
         class Emulator {
@@ -30,34 +24,34 @@ namespace Shinobu {
 
             std::unique_ptr<Shinobu::Frontend::SDL2::Window> window;
             std::unique_ptr<Shinobu::Frontend::Renderer> renderer;
-            std::unique_ptr<Shinobu::Frontend::Palette::Selector> paletteSelector;
+            std::unique_ptr<Shinobu::Frontend::SDL2::GameController> gameController;
+            std::unique_ptr<Shinobu::Frontend::SDL2::AudioDevice> audioDevice;
 
-            std::unique_ptr<Core::CPU::Processor> processor;
-            std::unique_ptr<Core::ROM::Cartridge> cartridge;
-            std::unique_ptr<Core::Memory::Controller> memoryController;
-            std::unique_ptr<Core::Device::Sound::Controller> sound;
-            std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> PPU;
-            std::unique_ptr<Core::Device::Interrupt::Controller> interrupt;
-            std::unique_ptr<Core::Device::Timer::Controller> timer;
-            std::unique_ptr<Core::Device::JoypadInput::Controller> joypad;
-            std::unique_ptr<Core::CPU::Disassembler::Disassembler> disassembler;
-            std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> DMA;
+            std::unique_ptr<Core::Machine::Machine> machine;
+            std::unique_ptr<Core::Rewind::Buffer> rewindBuffer;
 
             uint32_t currentFrameCycles;
             uint32_t frameCounter;
             uint32_t frameTime;
             uint32_t frameTimes;
+            uint64_t frameInstructions;
 
-            Sound_Queue soundQueue;
+            std::chrono::steady_clock::time_point nextFrameTime;
             bool isMuted;
+            bool turbo;
+            bool rewinding;
 
             bool stopEmulation;
 
             void setupSDL(bool debug) const;
             void setupOpenGL() const;
             void enqueueSound();
-            void updateCurrentFrameCycles(uint8_t cycles);
+            void waitForNextFrame();
+            bool updateCurrentFrameCycles(uint8_t cycles);
+            void setTurbo(bool enabled);
             void crash() const;
+            void saveState() const;
+            void loadState();
         public:
             Emulator();
             ~Emulator();
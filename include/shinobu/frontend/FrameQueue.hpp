@@ -0,0 +1,23 @@
+#pragma once
+#include "common/SPSCQueue.hpp"
+#include "core/device/PictureProcessingUnit.hpp"
+#include "core/Palette.hpp"
+
+namespace Shinobu {
+    namespace Frontend {
+        // Everything the render thread needs to present a frame without
+        // touching the PPU, which keeps running on the emulation thread.
+        struct LCDFrame {
+            Core::Device::PictureProcessingUnit::ColorIndexFramebuffer colorIndices;
+            Core::Device::PictureProcessingUnit::LinePalettes linePalettes;
+            Core::Palette::palette shades;
+            bool CGBPalettes;
+            bool correctColors;
+        };
+
+        // One frame being presented, one being written and one spare
+        const size_t FrameQueueCapacity = 3;
+
+        typedef Common::Concurrency::SPSCQueue<LCDFrame, FrameQueueCapacity> FrameQueue;
+    };
+};
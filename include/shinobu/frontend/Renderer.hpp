@@ -1,10 +1,7 @@
 #pragma once
 #include <memory>
 #include "shinobu/frontend/sdl2/Window.hpp"
-
-namespace Core::Device::PictureProcessingUnit {
-    class Processor;
-};
+#include "core/device/PictureProcessingUnit.hpp"
 
 namespace Shinobu {
     namespace Frontend {
@@ -15,16 +12,18 @@ namespace Shinobu {
         };
         Kind kindWithValue(std::string value);
 
-        class Renderer {
+        class Renderer : public Core::Device::PictureProcessingUnit::Renderer {
         protected:
             std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window;
             std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU;
+            int defaultSwapInterval;
         public:
             Renderer(std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window, std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU);
             ~Renderer();
-            virtual void update() = 0;
+            virtual void update() override = 0;
             virtual void handleSDLEvent(SDL_Event event) = 0;
             virtual Kind frontendKind() = 0;
+            virtual void setTurbo(bool enabled);
         };
     };
 };
@@ -27,6 +27,7 @@ namespace Shinobu {
                 void addData(T *data, uint32_t dataSize);
                 uint32_t remainingCapacity() const;
                 void draw(GLenum mode);
+                void drawKeepingData(GLenum mode) const;
             };
         };
     };
@@ -7,12 +7,19 @@ namespace Shinobu {
         namespace OpenGL {
             class Texture;
 
+            // Renders into a texture, bind also sets the viewport to the
+            // texture size so the caller has to restore its own afterwards
             class Framebuffer {
                 GLuint object;
+                GLsizei width;
+                GLsizei height;
             public:
                 Framebuffer(Texture &texture);
                 Framebuffer(GLuint texture, GLsizei width, GLsizei height);
                 ~Framebuffer();
+
+                void bind() const;
+                void unbind() const;
             };
         }
     };
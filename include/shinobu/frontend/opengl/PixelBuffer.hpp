@@ -0,0 +1,30 @@
+#pragma once
+#include <glad/glad.h>
+#include <array>
+#include <cstdint>
+
+namespace Shinobu {
+    namespace Frontend {
+        namespace OpenGL {
+            const int PixelBufferCount = 2;
+
+            // Ring of pixel unpack buffers: every frame is written into the
+            // next buffer, so the driver can keep copying the previous one
+            // into its texture without making the caller wait.
+            class PixelBuffer {
+                std::array<GLuint, PixelBufferCount> objects;
+                GLsizeiptr size;
+                uint8_t current;
+            public:
+                PixelBuffer(GLsizeiptr size);
+                ~PixelBuffer();
+
+                // Both leave no buffer bound when they fail, so the caller
+                // can upload from client memory instead
+                uint8_t *map();
+                bool unmap() const;
+                void unbind() const;
+            };
+        };
+    };
+};
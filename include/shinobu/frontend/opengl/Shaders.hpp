@@ -122,6 +122,50 @@ namespace Shinobu {
                 "}\n"
                 "\n";
 
+                const std::string paletteFragment = "\n"
+                "#version 330 core\n"
+                "out vec4 FragColor;\n"
+                "\n"
+                "in vec2 fragmentTexturePosition;\n"
+                "\n"
+                "uniform usampler2D colorIndices;\n"
+                "uniform usampler2D linePalettes;\n"
+                "uniform vec3 shades[4];\n"
+                "uniform int cgbPalettes;\n"
+                "uniform int correctColors;\n"
+                "\n"
+                "#define BLACK_COLOR_INDEX 64u\n"
+                "#define BLANK_COLOR_INDEX 65u\n"
+                "\n"
+                "void main() {\n"
+                "    ivec2 position = ivec2(fragmentTexturePosition * vec2(textureSize(colorIndices, 0)));\n"
+                "    uint index = texelFetch(colorIndices, position, 0).r;\n"
+                "    if (index == BLACK_COLOR_INDEX) {\n"
+                "        FragColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
+                "        return;\n"
+                "    }\n"
+                "    if (index == BLANK_COLOR_INDEX) {\n"
+                "        FragColor = vec4(shades[0], 1.0);\n"
+                "        return;\n"
+                "    }\n"
+                "    uint entry = texelFetch(linePalettes, ivec2(int(index), position.y), 0).r;\n"
+                "    if (cgbPalettes == 0) {\n"
+                "        FragColor = vec4(shades[entry & 3u], 1.0);\n"
+                "        return;\n"
+                "    }\n"
+                "    vec3 color = vec3(float(entry & 31u), float((entry >> 5) & 31u), float((entry >> 10) & 31u));\n"
+                "    if (correctColors == 1) {\n"
+                "        // Taken from: https://byuu.net/video/color-emulation/\n"
+                "        vec3 corrected = vec3(color.r * 26.0 + color.g *  4.0 + color.b *  2.0,\n"
+                "                                               color.g * 24.0 + color.b *  8.0,\n"
+                "                              color.r *  6.0 + color.g *  4.0 + color.b * 22.0);\n"
+                "        FragColor = vec4(floor(min(corrected, 960.0) / 4.0) / 256.0, 1.0);\n"
+                "    } else {\n"
+                "        FragColor = vec4(color / 32.0, 1.0);\n"
+                "    }\n"
+                "}\n"
+                "\n";
+
                 const std::string textureVertex = "\n"
                 "#version 330 core\n"
                 "in vec2 position;\n"
@@ -11,6 +11,7 @@ namespace Shinobu {
                 GLsizei height;
             public:
                 Texture(GLsizei width, GLsizei height);
+                Texture(GLsizei width, GLsizei height, GLenum internalFormat);
                 ~Texture();
 
                 std::pair<uint32_t,uint32_t> dimensions() const;
@@ -6,6 +6,9 @@
 #include "shinobu/frontend/opengl/Buffer.hpp"
 #include "shinobu/frontend/opengl/Vertex.hpp"
 #include "shinobu/frontend/opengl/Texture.hpp"
+#include "shinobu/frontend/opengl/PixelBuffer.hpp"
+#include "shinobu/frontend/opengl/Framebuffer.hpp"
+#include "core/Palette.hpp"
 
 namespace Shinobu {
     namespace Frontend {
@@ -18,13 +21,23 @@ namespace Shinobu {
                 std::unique_ptr<Texture> texture;
                 std::unique_ptr<Program> program;
                 std::unique_ptr<Buffer<Texel>> buffer;
+
+                std::unique_ptr<Texture> colorIndexTexture;
+                std::unique_ptr<Texture> linePaletteTexture;
+                std::unique_ptr<Program> paletteProgram;
+                std::unique_ptr<Buffer<Texel>> paletteBuffer;
+                std::unique_ptr<Framebuffer> paletteFramebuffer;
+
+                std::unique_ptr<PixelBuffer> pixelBuffer;
             public:
                 TextureRenderer(uint32_t width, uint32_t height, bool applyScale);
                 ~TextureRenderer();
 
                 void clear() const;
                 void render() const;
-                void addTextureData(std::vector<GLfloat> textureData) const;
+                void addTextureData(const uint32_t *textureData) const;
+                // Leaves the viewport set to the texture, the caller restores its own
+                void addColorIndexData(const uint8_t *colorIndices, const uint16_t *linePalettes, const Core::Palette::palette &shades, bool cgbPalettes, bool correctColors) const;
                 void toggleApplyScale();
             };
         };
@@ -1,21 +1,13 @@
 #pragma once
-#include <glad/glad.h>
+#include "core/Palette.hpp"
+#include "core/Viewer.hpp"
 
 namespace Shinobu {
     namespace Frontend {
         namespace OpenGL {
-            struct Point {
-                GLfloat x, y;
-            };
-
-            struct Color {
-                GLfloat r, g, b;
-            };
-
-            struct Vertex {
-                Point position;
-                Color color;
-            };
+            typedef Core::Viewer::Point Point;
+            typedef Core::Palette::Color Color;
+            typedef Core::Viewer::Vertex Vertex;
 
             struct Texel {
                 Point position;
@@ -0,0 +1,30 @@
+#pragma once
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include "common/Logger.hpp"
+#include "common/RingBuffer.hpp"
+#include "common/System.hpp"
+
+namespace Shinobu {
+    namespace Frontend {
+        namespace SDL2 {
+            // Stereo output fed through a lock-free ring that the SDL audio
+            // callback drains directly, the emulation thread never blocks on it.
+            class AudioDevice {
+                Common::Logs::Logger logger;
+                SDL_AudioDeviceID device;
+                bool playing;
+                Common::Concurrency::RingBuffer<int16_t, AudioRingBufferSize> samples;
+
+                static void fillAudio(void *userdata, Uint8 *stream, int length);
+            public:
+                AudioDevice(Common::Logs::Level logLevel);
+                ~AudioDevice();
+
+                void write(const int16_t *buffer, size_t count);
+                float fillLevel() const;
+                double rateAdjustment() const;
+            };
+        };
+    };
+};
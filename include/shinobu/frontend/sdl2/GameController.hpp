@@ -1,22 +1,14 @@
 #pragma once
 #include <SDL2/SDL.h>
 #include "common/Logger.hpp"
+#include "core/device/JoypadInput.hpp"
 
 namespace Shinobu {
     namespace Frontend {
         namespace SDL2 {
-            enum Button {
-                Up,
-                Down,
-                Left,
-                Right,
-                A,
-                B,
-                Start,
-                Select
-            };
+            using Core::Device::JoypadInput::Button;
 
-            class GameController {
+            class GameController : public Core::Device::JoypadInput::InputSource {
                 Common::Logs::Logger logger;
                 SDL_GameController *controller;
                 SDL_Joystick *joystick;
@@ -28,7 +20,7 @@ namespace Shinobu {
                 GameController(Common::Logs::Level logLevel, std::string controllerName);
                 ~GameController();
 
-                bool isButtonPressed(Button button) const;
+                bool isButtonPressed(Button button) const override;
                 bool hasGameController() const;
             };
         };
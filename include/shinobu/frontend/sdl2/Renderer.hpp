@@ -1,10 +1,14 @@
 #pragma once
 #include <memory>
 #include <deque>
+#include <atomic>
+#include <thread>
 #include <imgui/imgui.h>
 #include "shinobu/frontend/Renderer.hpp"
 #include "shinobu/frontend/sdl2/Window.hpp"
 #include "shinobu/frontend/opengl/TextureRenderer.hpp"
+#include "shinobu/frontend/FrameQueue.hpp"
+#include "common/SPSCQueue.hpp"
 
 namespace Core::Device::PictureProcessingUnit {
     class Processor;
@@ -21,6 +25,24 @@ namespace Shinobu {
                 float maxValue;
                 float minValue;
                 unsigned int overlayScale;
+
+                // Frames flow from the emulation thread to the render thread,
+                // which owns the GL context and the ImGui context
+                FrameQueue frameQueue;
+                Common::Concurrency::SPSCQueue<SDL_Event, 64> eventQueue;
+                Common::Concurrency::SPSCQueue<Common::Performance::Frame, 8> performanceFrameQueue;
+                std::atomic<bool> turbo;
+                std::atomic<bool> running;
+                std::atomic<uint64_t> droppedFrames;
+                bool presentedFrame;
+                bool appliedTurbo;
+                std::thread renderThread;
+
+                void renderLoop();
+                bool acquireLatestFrame();
+                void present(bool upload);
+                void processSDLEvent(SDL_Event event);
+                void addPerformanceFrame(Common::Performance::Frame frame);
             public:
                 Renderer(std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window, std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU);
                 ~Renderer();
@@ -28,7 +50,9 @@ namespace Shinobu {
                 void update() override;
                 void handleSDLEvent(SDL_Event event) override;
                 Kind frontendKind() override { return Kind::SDL; }
+                void setTurbo(bool enabled) override;
                 void setLastPerformanceFrame(Common::Performance::Frame frame);
+                uint64_t getDroppedFrames() const;
             };
         };
     };
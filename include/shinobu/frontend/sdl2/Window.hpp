@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <tuple>
 #include <optional>
+#include <atomic>
 #include "common/Logger.hpp"
 #include "common/Performance.hpp"
 
@@ -24,6 +25,8 @@ namespace Shinobu {
                 SDL_Window *window;
                 uint32_t windowID;
                 std::optional<std::tuple<uint32_t,uint32_t,float,float>> lastFullscreenViewport;
+                // Window size waiting to be applied by the thread owning the GL context, 0 when there is none
+                std::atomic<uint64_t> pendingResize;
 
                 void toggleFullscreen() const;
                 void handleWindowResize(uint32_t width, uint32_t height);
@@ -36,6 +39,8 @@ namespace Shinobu {
                 SDL_Window* windowRef() const;
                 SDL_GLContext GLContext() const;
                 void handleSDLEvent(SDL_Event event);
+                void updateViewport();
+                void restoreViewport() const;
                 void updateWindowTitleWithFramePerformance(Common::Performance::Frame frame) const;
                 void setROMFilename(std::string filename);
             };
@@ -0,0 +1,299 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "core/Machine.hpp"
+#include "common/Logger.hpp"
+#include "common/ThreadPool.hpp"
+#include "common/Formatter.hpp"
+#include "common/Timing.hpp"
+
+const uint32_t DefaultFrameBudget = 7200;
+
+struct Options {
+    std::filesystem::path testLocationsFilePath;
+    std::filesystem::path reportFilePath;
+    std::filesystem::path DMGBootstrapROM;
+    std::filesystem::path CGBBootstrapROM;
+    bool skipBootROM;
+    bool pinWorkers;
+    size_t workers;
+    uint32_t frameBudget;
+};
+
+enum Outcome {
+    Passed,
+    Failed,
+    Timeout,
+    Error,
+};
+
+struct Result {
+    std::filesystem::path ROMFilePath;
+    Outcome outcome;
+    std::string message;
+    double seconds;
+    uint64_t cycles;
+    uint64_t instructions;
+};
+
+static Common::Logs::Logger logger = Common::Logs::Logger(Common::Logs::Level::Message, "");
+
+static void printUsage() {
+    logger.logDebug("Usage: shinobu-batch [-s] [-u] [-j workers] [-f frames] [-b path] [-c path] [-o report] test-locations.txt");
+    logger.logDebug("");
+    logger.logDebug("  -s   skip BOOT ROM, only supported by DMG emulation");
+    logger.logDebug("  -u   don't pin workers to cores");
+    logger.logDebug("  -j   number of workers, defaults to the number of cores");
+    logger.logDebug("  -f   frames to emulate before a ROM times out, defaults to %d", DefaultFrameBudget);
+    logger.logDebug("  -b   DMG BOOT ROM path");
+    logger.logDebug("  -c   CGB BOOT ROM path");
+    logger.logDebug("  -o   report path, JSON when it ends with .json and JUnit XML otherwise");
+    logger.logDebug("  -h   print this message");
+    logger.logDebug("");
+}
+
+static Options parseOptions(int argc, char* argv[]) {
+    Options options = { {}, "shinobu-batch.xml", {}, {}, false, true, std::thread::hardware_concurrency(), DefaultFrameBudget };
+    int c;
+    while ((c = getopt(argc, argv, "suj:f:b:c:o:h")) != -1) {
+        switch (c) {
+        case 's':
+            options.skipBootROM = true;
+            break;
+        case 'u':
+            options.pinWorkers = false;
+            break;
+        case 'j':
+            options.workers = std::stoul(optarg);
+            break;
+        case 'f':
+            options.frameBudget = std::stoul(optarg);
+            break;
+        case 'b':
+            options.DMGBootstrapROM = optarg;
+            break;
+        case 'c':
+            options.CGBBootstrapROM = optarg;
+            break;
+        case 'o':
+            options.reportFilePath = optarg;
+            break;
+        case 'h':
+            printUsage();
+            exit(0);
+            break;
+        default:
+            printUsage();
+            exit(1);
+        }
+    }
+    if (optind >= argc) {
+        printUsage();
+        logger.logDebug("Missing argument: test locations filepath");
+        exit(1);
+    }
+    options.testLocationsFilePath = argv[optind];
+    return options;
+}
+
+// One ROM path per line, the format used by tests/*/test-locations.txt
+static std::vector<std::filesystem::path> readTestLocations(const std::filesystem::path &filePath) {
+    std::ifstream file = std::ifstream(filePath);
+    if (!file.is_open()) {
+        logger.logDebug("Unable to open test locations file at path: %s", filePath.string().c_str());
+        exit(1);
+    }
+    std::vector<std::filesystem::path> locations;
+    std::string line;
+    while (std::getline(file, line)) {
+        line.erase(line.find_last_not_of(" \t\r") + 1);
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        locations.push_back(std::filesystem::current_path() / line);
+    }
+    return locations;
+}
+
+static Result runROM(const Options &options, const std::filesystem::path &ROMFilePath) {
+    Result result = { ROMFilePath, Outcome::Error, "", 0.0, 0, 0 };
+    Core::Machine::Configuration configuration = Core::Machine::Configuration();
+    configuration.nullAudio = true;
+    configuration.DMGBootstrapROM = options.DMGBootstrapROM;
+    configuration.CGBBootstrapROM = options.CGBBootstrapROM;
+    auto start = std::chrono::steady_clock::now();
+    Core::Machine::Machine machine = Core::Machine::Machine(configuration);
+    try {
+        // The cartridge only warns about a missing file and would leave the
+        // machine running without a ROM until the budget is spent
+        if (!std::filesystem::is_regular_file(ROMFilePath) || !std::ifstream(ROMFilePath).is_open()) {
+            throw std::runtime_error(Common::Formatter::format("Unable to open ROM file at path: %s", ROMFilePath.string().c_str()));
+        }
+        machine.load(ROMFilePath, options.skipBootROM);
+        if (!machine.getCartridge()->isOpen()) {
+            throw std::runtime_error(Common::Formatter::format("Unable to load ROM file at path: %s", ROMFilePath.string().c_str()));
+        }
+        switch (machine.runTest((uint64_t)options.frameBudget * CyclesPerFrame, result.cycles)) {
+        case Core::TestResult::Passed:
+            result.outcome = Outcome::Passed;
+            break;
+        case Core::TestResult::Failed:
+            result.outcome = Outcome::Failed;
+            result.message = "The ROM reported a failure";
+            break;
+        default:
+            result.outcome = Outcome::Timeout;
+            result.message = Common::Formatter::format("No result after %u frames", options.frameBudget);
+            break;
+        }
+    } catch (const std::exception &error) {
+        result.outcome = Outcome::Error;
+        result.message = error.what();
+    }
+    result.instructions = machine.getExecutedInstructions();
+    auto end = std::chrono::steady_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+static double frames(const Result &result) {
+    return (double)result.cycles / CyclesPerFrame;
+}
+
+static double framesPerSecond(const Result &result) {
+    return result.seconds > 0.0 ? frames(result) / result.seconds : 0.0;
+}
+
+static const char *outcomeName(Outcome outcome) {
+    switch (outcome) {
+    case Outcome::Passed:
+        return "passed";
+    case Outcome::Failed:
+        return "failed";
+    case Outcome::Timeout:
+        return "timeout";
+    case Outcome::Error:
+        return "error";
+    }
+    return "unknown";
+}
+
+static std::string escapeXML(const std::string &value) {
+    std::string escaped;
+    for (char character : value) {
+        switch (character) {
+        case '&': escaped += "&amp;"; break;
+        case '<': escaped += "&lt;"; break;
+        case '>': escaped += "&gt;"; break;
+        case '"': escaped += "&quot;"; break;
+        case '\'': escaped += "&apos;"; break;
+        default: escaped += character; break;
+        }
+    }
+    return escaped;
+}
+
+static std::string escapeJSON(const std::string &value) {
+    std::string escaped;
+    for (char character : value) {
+        switch (character) {
+        case '"': escaped += "\\\""; break;
+        case '\\': escaped += "\\\\"; break;
+        case '\n': escaped += "\\n"; break;
+        case '\t': escaped += "\\t"; break;
+        default:
+            if ((unsigned char)character < 0x20) {
+                escaped += Common::Formatter::format("\\u%04x", character);
+            } else {
+                escaped += character;
+            }
+            break;
+        }
+    }
+    return escaped;
+}
+
+static void writeJUnitReport(std::ofstream &report, const std::vector<Result> &results, double seconds) {
+    size_t failures = 0;
+    size_t errors = 0;
+    for (const Result &result : results) {
+        failures += result.outcome == Outcome::Failed || result.outcome == Outcome::Timeout;
+        errors += result.outcome == Outcome::Error;
+    }
+    report << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n";
+    report << Common::Formatter::format("<testsuite name=\"shinobu-batch\" tests=\"%zu\" failures=\"%zu\" errors=\"%zu\" time=\"%.3f\">\n", results.size(), failures, errors, seconds);
+    for (const Result &result : results) {
+        std::string name = escapeXML(result.ROMFilePath.filename().string());
+        std::string className = escapeXML(result.ROMFilePath.parent_path().filename().string());
+        report << Common::Formatter::format("  <testcase classname=\"%s\" name=\"%s\" time=\"%.3f\">\n", className.c_str(), name.c_str(), result.seconds);
+        if (result.outcome == Outcome::Failed || result.outcome == Outcome::Timeout) {
+            report << Common::Formatter::format("    <failure message=\"%s\"/>\n", escapeXML(result.message).c_str());
+        } else if (result.outcome == Outcome::Error) {
+            report << Common::Formatter::format("    <error message=\"%s\"/>\n", escapeXML(result.message).c_str());
+        }
+        report << Common::Formatter::format("    <system-out>path=%s frames=%.1f fps=%.1f instructions=%llu</system-out>\n", escapeXML(result.ROMFilePath.string()).c_str(), frames(result), framesPerSecond(result), (unsigned long long)result.instructions);
+        report << "  </testcase>\n";
+    }
+    report << "</testsuite>\n";
+}
+
+static void writeJSONReport(std::ofstream &report, const std::vector<Result> &results, double seconds) {
+    report << Common::Formatter::format("{\n  \"time\": %.3f,\n  \"results\": [\n", seconds);
+    for (size_t index = 0; index < results.size(); index++) {
+        const Result &result = results[index];
+        report << Common::Formatter::format("    { \"rom\": \"%s\", \"outcome\": \"%s\", \"message\": \"%s\", \"time\": %.3f, \"frames\": %.1f, \"fps\": %.1f, \"instructions\": %llu }%s\n",
+                                            escapeJSON(result.ROMFilePath.string()).c_str(), outcomeName(result.outcome), escapeJSON(result.message).c_str(),
+                                            result.seconds, frames(result), framesPerSecond(result), (unsigned long long)result.instructions,
+                                            index + 1 < results.size() ? "," : "");
+    }
+    report << "  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    Options options = parseOptions(argc, argv);
+    std::vector<std::filesystem::path> locations = readTestLocations(options.testLocationsFilePath);
+    std::vector<Result> results = std::vector<Result>(locations.size());
+
+    size_t workers;
+    auto start = std::chrono::steady_clock::now();
+    {
+        Common::Concurrency::ThreadPool pool = Common::Concurrency::ThreadPool(options.workers, options.pinWorkers);
+        for (size_t index = 0; index < locations.size(); index++) {
+            pool.submit([&options, &locations, &results, index] {
+                results[index] = runROM(options, locations[index]);
+            });
+        }
+        pool.wait();
+        workers = pool.size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    size_t unsuccessful = 0;
+    for (const Result &result : results) {
+        unsuccessful += result.outcome != Outcome::Passed;
+        logger.logDebug("%-9s %8.3fs %9.1f fps  %s", outcomeName(result.outcome), result.seconds, framesPerSecond(result), result.ROMFilePath.string().c_str());
+        if (!result.message.empty()) {
+            logger.logDebug("          %s", result.message.c_str());
+        }
+    }
+    logger.logDebug("Ran %zu ROMs on %zu workers in %.3fs", results.size(), workers, seconds);
+
+    std::ofstream report = std::ofstream(options.reportFilePath);
+    if (!report.is_open()) {
+        logger.logDebug("Unable to write report at path: %s", options.reportFilePath.string().c_str());
+        return 1;
+    }
+    if (options.reportFilePath.extension() == ".json") {
+        writeJSONReport(report, results, seconds);
+    } else {
+        writeJUnitReport(report, results, seconds);
+    }
+    return unsuccessful == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include "core/Machine.hpp"
+
+const uint32_t BenchmarkFrames = 600;
+const uint32_t BenchmarkRuns = 5;
+const uint16_t ProgramAddress = 0x150;
+
+struct Scenario {
+    const char *name;
+    std::vector<uint8_t> (*program)();
+};
+
+// Relative jump back to position, JR's offset counts from the next opcode
+static void jumpRelative(std::vector<uint8_t> &program, uint8_t opcode, size_t position) {
+    program.push_back(opcode);
+    program.push_back((uint8_t)(position - (program.size() + 1)));
+}
+
+// Register arithmetic only, decoding and dispatch dominate
+static std::vector<uint8_t> arithmeticProgram() {
+    std::vector<uint8_t> program = { 0xF3, 0x31, 0xFE, 0xDF }; // DI, LD SP,$DFFE
+    size_t loop = program.size();
+    program.insert(program.end(), {
+        0x3C,       // INC A
+        0x80,       // ADD A,B
+        0xA9,       // XOR C
+        0x04,       // INC B
+        0x0D,       // DEC C
+        0xCB, 0x37, // SWAP A
+        0x87,       // ADD A,A
+        0x1F,       // RRA
+    });
+    jumpRelative(program, 0x18, loop); // JR loop
+    return program;
+}
+
+// Copies the ROM into the first WRAM bank over and over, loads and stores
+// go through the page tables
+static std::vector<uint8_t> memoryCopyProgram() {
+    std::vector<uint8_t> program = { 0xF3, 0x31, 0xFE, 0xDF }; // DI, LD SP,$DFFE
+    size_t outer = program.size();
+    program.insert(program.end(), {
+        0x21, 0x00, 0xC0, // LD HL,$C000
+        0x11, 0x00, 0x00, // LD DE,$0000
+    });
+    size_t inner = program.size();
+    program.insert(program.end(), {
+        0x1A,       // LD A,(DE)
+        0x13,       // INC DE
+        0x22,       // LD (HL+),A
+        0x7C,       // LD A,H
+        0xFE, 0xD0, // CP $D0
+    });
+    jumpRelative(program, 0x20, inner); // JR NZ,inner
+    jumpRelative(program, 0x18, outer); // JR outer
+    return program;
+}
+
+// Short blocks ended by CALL and RET, with the stack in WRAM
+static std::vector<uint8_t> callProgram() {
+    std::vector<uint8_t> program = { 0xF3, 0x31, 0xFE, 0xDF }; // DI, LD SP,$DFFE
+    size_t loop = program.size();
+    uint16_t subroutine = ProgramAddress + loop + 5;
+    program.insert(program.end(), { 0xCD, (uint8_t)subroutine, (uint8_t)(subroutine >> 8) }); // CALL subroutine
+    jumpRelative(program, 0x18, loop); // JR loop
+    program.insert(program.end(), {
+        0xC5, // PUSH BC
+        0x3C, // INC A
+        0x47, // LD B,A
+        0xC1, // POP BC
+        0xC9, // RET
+    });
+    return program;
+}
+
+// Copies a loop into WRAM and runs it from there, it keeps storing to
+// the second WRAM bank so the cached blocks stay valid
+static std::vector<uint8_t> WRAMProgram() {
+    std::vector<uint8_t> routine = {
+        0x21, 0x00, 0xD0, // LD HL,$D000
+    };
+    size_t loop = routine.size();
+    routine.insert(routine.end(), {
+        0x3C,       // INC A
+        0x80,       // ADD A,B
+        0x77,       // LD (HL),A
+        0x2C,       // INC L
+        0xCB, 0x37, // SWAP A
+    });
+    jumpRelative(routine, 0x18, loop); // JR loop
+
+    std::vector<uint8_t> program = { 0xF3, 0x31, 0xFE, 0xDF }; // DI, LD SP,$DFFE
+    program.insert(program.end(), {
+        0x21, 0x00, 0xC0,              // LD HL,$C000
+        0x11, 0x00, 0x00,              // LD DE,routine, patched below
+        0x06, (uint8_t)routine.size(), // LD B,length
+    });
+    size_t copy = program.size();
+    program.insert(program.end(), {
+        0x1A, // LD A,(DE)
+        0x13, // INC DE
+        0x22, // LD (HL+),A
+        0x05, // DEC B
+    });
+    jumpRelative(program, 0x20, copy);                   // JR NZ,copy
+    program.insert(program.end(), { 0xC3, 0x00, 0xC0 }); // JP $C000
+    uint16_t source = ProgramAddress + program.size();
+    program[copy - 4] = (uint8_t)source;
+    program[copy - 3] = (uint8_t)(source >> 8);
+    program.insert(program.end(), routine.begin(), routine.end());
+    return program;
+}
+
+// 32KB DMG cartridge without a mapper, the entry point jumps straight
+// into the program
+static void writeROM(const std::filesystem::path &filePath, const std::vector<uint8_t> &program) {
+    std::vector<uint8_t> ROM = std::vector<uint8_t>(0x8000, 0x00);
+    ROM[0x101] = 0xC3;
+    ROM[0x102] = (uint8_t)ProgramAddress;
+    ROM[0x103] = (uint8_t)(ProgramAddress >> 8);
+    std::copy(program.begin(), program.end(), ROM.begin() + ProgramAddress);
+    std::ofstream file = std::ofstream(filePath, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(ROM.data()), ROM.size());
+}
+
+static double runScenario(const std::filesystem::path &ROMFilePath, double &framesPerSecond) {
+    Core::Machine::Configuration configuration = Core::Machine::Configuration();
+    configuration.nullAudio = true;
+    Core::Machine::Machine machine = Core::Machine::Machine(configuration);
+    machine.load(ROMFilePath, true);
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < BenchmarkFrames; frame++) {
+        machine.runFrame();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    framesPerSecond = BenchmarkFrames / seconds;
+    return machine.getExecutedInstructions() / seconds;
+}
+
+int main() {
+    const Scenario scenarios[] = {
+        { "Arithmetic from ROM", arithmeticProgram },
+        { "Memory copy", memoryCopyProgram },
+        { "Calls and returns", callProgram },
+        { "Code in WRAM", WRAMProgram },
+    };
+    std::filesystem::path ROMFilePath = std::filesystem::temp_directory_path() / "shinobu-benchmark.gb";
+    printf("%-40s %12s %12s\n", "Scenario", "MIPS", "fps");
+    for (const auto &scenario : scenarios) {
+        writeROM(ROMFilePath, scenario.program());
+        // Median of a few runs, the first one also pays for warming up
+        // the block cache and the allocator
+        std::vector<std::pair<double, double>> runs;
+        for (uint32_t run = 0; run < BenchmarkRuns; run++) {
+            double framesPerSecond;
+            double instructionsPerSecond = runScenario(ROMFilePath, framesPerSecond);
+            runs.push_back({ instructionsPerSecond, framesPerSecond });
+        }
+        std::sort(runs.begin(), runs.end());
+        const std::pair<double, double> &median = runs[runs.size() / 2];
+        printf("%-40s %12.1f %12.1f\n", scenario.name, median.first / 1000000.0, median.second);
+    }
+    std::filesystem::remove(ROMFilePath);
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include "core/Scheduler.hpp"
+#include "core/device/Interrupt.hpp"
+#include "core/device/DirectMemoryAccess.hpp"
+#include "core/device/PictureProcessingUnit.hpp"
+#include "core/Palette.hpp"
+#include "common/Timing.hpp"
+
+using namespace Core::Device;
+
+const uint32_t BenchmarkFrames = 600;
+
+// The PPU only draws scanlines once a renderer is attached
+class NullRenderer : public PictureProcessingUnit::Renderer {
+public:
+    void update() override {}
+};
+
+struct Scenario {
+    const char *name;
+    Core::ROM::CGBFlag cgbFlag;
+    uint8_t LCDControl;
+    uint8_t windowYPosition;
+    uint8_t windowXPosition;
+};
+
+// Fills VRAM, OAM and palettes with deterministic noise, so every tile row,
+// sprite and palette lookup has to be resolved.
+static void fillVideoMemory(std::unique_ptr<PictureProcessingUnit::Processor> &PPU, Core::ROM::CGBFlag cgbFlag) {
+    uint32_t seed = 0x12345678;
+    auto next = [&seed]() {
+        seed = seed * 1103515245 + 12345;
+        return (uint8_t)(seed >> 16);
+    };
+    uint8_t banks = cgbFlag == Core::ROM::CGBFlag::DMG ? 1 : 2;
+    for (uint8_t bank = 0; bank < banks; bank++) {
+        if (cgbFlag != Core::ROM::CGBFlag::DMG) {
+            PPU->VBKStore(0x0, bank);
+        }
+        for (uint16_t offset = 0; offset < 0x2000; offset++) {
+            PPU->VRAMStore(offset, next());
+        }
+    }
+    for (uint16_t offset = 0; offset < 0xA0; offset++) {
+        PPU->OAMStore(offset, next());
+    }
+    if (cgbFlag != Core::ROM::CGBFlag::DMG) {
+        PPU->colorPaletteStore(0x0, 0x80);
+        PPU->colorPaletteStore(0x2, 0x80);
+        for (uint8_t index = 0; index < 0x40; index++) {
+            PPU->colorPaletteStore(0x1, next());
+            PPU->colorPaletteStore(0x3, next());
+        }
+    }
+    PPU->store(0x7, 0xE4);
+    PPU->store(0x8, 0xD2);
+    PPU->store(0x9, 0x1B);
+}
+
+static double runScenario(const Scenario &scenario) {
+    std::unique_ptr<Core::Scheduler::Scheduler> scheduler = std::make_unique<Core::Scheduler::Scheduler>(Common::Logs::Level::NoLog);
+    std::unique_ptr<Interrupt::Controller> interrupt = std::make_unique<Interrupt::Controller>(Common::Logs::Level::NoLog);
+    std::unique_ptr<Core::Palette::Selector> paletteSelector = std::make_unique<Core::Palette::Selector>(0);
+    std::unique_ptr<DirectMemoryAccess::Controller> DMA = std::make_unique<DirectMemoryAccess::Controller>(Common::Logs::Level::NoLog, scheduler);
+    std::unique_ptr<PictureProcessingUnit::Processor> PPU = std::make_unique<PictureProcessingUnit::Processor>(Common::Logs::Level::NoLog, true, interrupt, paletteSelector, DMA);
+    NullRenderer renderer = NullRenderer();
+    PPU->setRenderer(&renderer);
+    PPU->setCGBFlag(scenario.cgbFlag);
+    fillVideoMemory(PPU, scenario.cgbFlag);
+    PPU->store(0xA, scenario.windowYPosition);
+    PPU->store(0xB, scenario.windowXPosition);
+    PPU->store(0x0, scenario.LCDControl);
+
+    uint8_t scroll = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t frame = 0; frame < BenchmarkFrames; frame++) {
+        PPU->store(0x2, scroll);
+        PPU->store(0x3, scroll * 3);
+        scroll++;
+        for (uint32_t cycles = 0; cycles < CyclesPerScanline * TotalScanlines; cycles += 4) {
+            PPU->step(4);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    double nanoseconds = std::chrono::duration<double, std::nano>(end - start).count();
+    return nanoseconds / (BenchmarkFrames * VerticalResolution);
+}
+
+int main() {
+    const Scenario scenarios[] = {
+        { "DMG background", Core::ROM::CGBFlag::DMG, 0x91, 0x00, 0x00 },
+        { "DMG background, window and sprites", Core::ROM::CGBFlag::DMG, 0xF3, 0x40, 0x50 },
+        { "DMG 8x16 sprites", Core::ROM::CGBFlag::DMG, 0x97, 0x00, 0x00 },
+        { "CGB background", Core::ROM::CGBFlag::CGB, 0x91, 0x00, 0x00 },
+        { "CGB background, window and sprites", Core::ROM::CGBFlag::CGB, 0xF3, 0x40, 0x50 },
+    };
+    printf("%-40s %12s\n", "Scenario", "ns/scanline");
+    for (const auto &scenario : scenarios) {
+        printf("%-40s %12.1f\n", scenario.name, runScenario(scenario));
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "common/Delta.hpp"
+#include <cstring>
+
+static void writeLength(std::vector<uint8_t> &output, size_t value) {
+    while (value >= 0x80) {
+        output.push_back((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    output.push_back(value);
+}
+
+static bool readLength(const std::vector<uint8_t> &input, size_t &position, size_t &value) {
+    value = 0;
+    for (uint8_t shift = 0; position < input.size(); shift += 7) {
+        uint8_t byte = input[position++];
+        value |= (size_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool isEqualWord(const uint8_t *previous, const uint8_t *current) {
+    uint64_t previousWord;
+    uint64_t currentWord;
+    memcpy(&previousWord, previous, sizeof(previousWord));
+    memcpy(&currentWord, current, sizeof(currentWord));
+    return previousWord == currentWord;
+}
+
+void Common::Delta::encode(const uint8_t *previous, const uint8_t *current, size_t length, std::vector<uint8_t> &output) {
+    output.clear();
+    size_t position = 0;
+    while (position < length) {
+        size_t unchanged = position;
+        while ((unchanged + 8) <= length && isEqualWord(previous + unchanged, current + unchanged)) {
+            unchanged += 8;
+        }
+        while (unchanged < length && previous[unchanged] == current[unchanged]) {
+            unchanged++;
+        }
+        if (unchanged == length) {
+            break;
+        }
+        size_t changed = unchanged;
+        while (changed < length) {
+            if (previous[changed] != current[changed]) {
+                changed++;
+                continue;
+            }
+            size_t run = changed;
+            while (run < length && (run - changed) < MinimumUnchangedRun && previous[run] == current[run]) {
+                run++;
+            }
+            if ((run - changed) >= MinimumUnchangedRun || run == length) {
+                break;
+            }
+            changed = run;
+        }
+        writeLength(output, unchanged - position);
+        writeLength(output, changed - unchanged);
+        for (size_t index = unchanged; index < changed; index++) {
+            output.push_back(previous[index] ^ current[index]);
+        }
+        position = changed;
+    }
+}
+
+bool Common::Delta::apply(const std::vector<uint8_t> &delta, uint8_t *data, size_t length) {
+    size_t index = 0;
+    size_t position = 0;
+    while (index < delta.size()) {
+        size_t unchanged;
+        size_t changed;
+        if (!readLength(delta, index, unchanged) || !readLength(delta, index, changed)) {
+            return false;
+        }
+        position += unchanged;
+        if ((position + changed) > length || (index + changed) > delta.size()) {
+            return false;
+        }
+        for (size_t offset = 0; offset < changed; offset++) {
+            data[position + offset] ^= delta[index + offset];
+        }
+        position += changed;
+        index += changed;
+    }
+    return true;
+}
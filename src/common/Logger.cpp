@@ -4,13 +4,14 @@
 #include <filesystem>
 #include <cstdarg>
 #include "common/Formatter.hpp"
-#include "shinobu/Configuration.hpp"
 #include <stdexcept>
+#include <mutex>
 
 using namespace Common::Logs;
 
 std::stringstream stream = std::stringstream();
 uint16_t bufferSize = 0;
+std::recursive_mutex streamMutex;
 
 Level Common::Logs::levelWithValue(std::string value) {
     if (value.compare("WAR") == 0) {
@@ -32,6 +33,7 @@ Level Logger::logLevel() {
 }
 
 void Logger::flush() const {
+    std::lock_guard<std::recursive_mutex> lock(streamMutex);
     std::ofstream logfile = std::ofstream();
     logfile.open(filePath, std::ios::out | std::ios::app);
     logfile << stream.str();
@@ -41,6 +43,7 @@ void Logger::flush() const {
 }
 
 void Logger::traceMessage(std::string message) const {
+    std::lock_guard<std::recursive_mutex> lock(streamMutex);
     stream << message << std::endl;
     bufferSize += message.length();
     if (bufferSize < BUFFER_SIZE_LIMIT) {
@@ -0,0 +1,135 @@
+#include "common/ThreadPool.hpp"
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace Common::Concurrency;
+
+static void pinCurrentThread(size_t core) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core % CPU_SETSIZE, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)core;
+#endif
+}
+
+ThreadPool::ThreadPool(size_t workerCount, bool pinWorkers) : workers(), threads(), nextWorker(0), stateMutex(), jobAvailable(), jobsFinished(), queuedJobs(0), pendingJobs(0), stopping(false), error() {
+    if (workerCount == 0) {
+        workerCount = 1;
+    }
+    for (size_t index = 0; index < workerCount; index++) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    for (size_t index = 0; index < workerCount; index++) {
+        threads.emplace_back(&ThreadPool::run, this, index, pinWorkers);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    jobAvailable.notify_all();
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        queuedJobs++;
+        pendingJobs++;
+    }
+    Worker &worker = *workers[nextWorker.fetch_add(1) % workers.size()];
+    {
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.jobs.push_back(std::move(job));
+    }
+    jobAvailable.notify_one();
+}
+
+void ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(stateMutex);
+    jobsFinished.wait(lock, [this] { return pendingJobs == 0; });
+    if (error) {
+        std::exception_ptr jobError = error;
+        error = nullptr;
+        std::rethrow_exception(jobError);
+    }
+}
+
+size_t ThreadPool::size() const {
+    return workers.size();
+}
+
+// Newest job of its own deque first, then the oldest job of the others
+bool ThreadPool::popJob(size_t index, std::function<void()> &job) {
+    {
+        Worker &worker = *workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (!worker.jobs.empty()) {
+            job = std::move(worker.jobs.back());
+            worker.jobs.pop_back();
+            return true;
+        }
+    }
+    for (size_t offset = 1; offset < workers.size(); offset++) {
+        Worker &victim = *workers[(index + offset) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t index, bool pinned) {
+    if (pinned) {
+        pinCurrentThread(index);
+    }
+    std::function<void()> job;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex);
+            jobAvailable.wait(lock, [this] { return stopping || queuedJobs > 0; });
+            if (queuedJobs == 0) {
+                return;
+            }
+        }
+        // The counter is bumped before the job is pushed, keep looking
+        // until it shows up
+        if (!popJob(index, job)) {
+            std::this_thread::yield();
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock(stateMutex);
+            queuedJobs--;
+        }
+        // Letting an exception escape would terminate the process, and
+        // skipping the counter would leave wait() blocked forever
+        std::exception_ptr jobError;
+        try {
+            job();
+        } catch (...) {
+            jobError = std::current_exception();
+        }
+        job = nullptr;
+        std::lock_guard<std::mutex> lock(stateMutex);
+        if (jobError && !error) {
+            error = jobError;
+        }
+        pendingJobs--;
+        if (pendingJobs == 0) {
+            jobsFinished.notify_all();
+        }
+    }
+}
@@ -0,0 +1,261 @@
+#include "core/Machine.hpp"
+#include "common/System.hpp"
+#include "common/Timing.hpp"
+
+using namespace Core::Machine;
+
+Machine::Machine(Configuration configuration) : logger(Common::Logs::Level::Message, "  [Machine]: "), configuration(configuration), frameCycles(), executedInstructions() {
+    paletteSelector = std::make_unique<Core::Palette::Selector>(configuration.paletteIndex);
+    scheduler = std::make_unique<Core::Scheduler::Scheduler>(configuration.memoryLogLevel);
+    interrupt = std::make_unique<Core::Device::Interrupt::Controller>(configuration.interruptLogLevel);
+    DMA = std::make_unique<Core::Device::DirectMemoryAccess::Controller>(configuration.DMALogLevel, scheduler);
+    PPU = std::make_unique<Core::Device::PictureProcessingUnit::Processor>(configuration.PPULogLevel, configuration.correctColors, interrupt, paletteSelector, DMA);
+    sound = std::make_unique<Core::Device::Sound::Controller>(configuration.soundLogLevel, configuration.mute, configuration.nullAudio);
+    sound->setSampleRate(SampleRate);
+    timer = std::make_unique<Core::Device::Timer::Controller>(configuration.timerLogLevel, interrupt, scheduler);
+    joypad = std::make_unique<Core::Device::JoypadInput::Controller>(configuration.joypadLogLevel, interrupt);
+    serial = std::make_unique<Core::Device::SerialDataTransfer::Controller>(configuration.serialLogLevel);
+    cartridge = std::make_unique<Core::ROM::Cartridge>(configuration.ROMLogLevel, configuration.overrideCGBFlag);
+    bootROM = std::make_unique<Core::ROM::BOOT::ROM>(configuration.ROMLogLevel, configuration.DMGBootstrapROM, configuration.CGBBootstrapROM);
+    memoryController = std::make_unique<Core::Memory::Controller>(configuration.memoryLogLevel, cartridge, bootROM, serial, PPU, sound, interrupt, timer, joypad, DMA, scheduler);
+    processor = std::make_unique<Core::CPU::Processor>(configuration.CPULogLevel, memoryController, interrupt);
+    disassembler = std::make_unique<Core::CPU::Disassembler::Disassembler>(configuration.disassemblerLogLevel, processor);
+    PPU->setMemoryController(memoryController);
+    DMA->setMemoryController(memoryController);
+}
+
+Machine::~Machine() {
+
+}
+
+void Machine::load(std::filesystem::path ROMFilePath, bool skipBootROM) {
+    cartridge->open(ROMFilePath);
+    PPU->setCGBFlag(cartridge->cgbFlag());
+    memoryController->initialize(skipBootROM);
+    processor->initialize();
+}
+
+uint8_t Machine::step() {
+    const Core::CPU::Instructions::DecodedInstruction &decoded = processor->fetchDecodedInstruction();
+    Core::CPU::Instructions::Instruction instruction = decoded.instruction;
+    if constexpr (Common::Logs::TraceEnabled) {
+        disassembler->disassembleWhileExecuting(instruction);
+    }
+    decoded.handler(*processor, instruction);
+    executedInstructions++;
+    joypad->updateJoypad();
+    processor->checkPendingInterrupts(instruction);
+    return memoryController->elapsedCycles();
+}
+
+void Machine::runFrame() {
+    while (frameCycles < CyclesPerFrame) {
+        frameCycles += step();
+    }
+    endFrame();
+}
+
+// Stops on the instruction that reports the result, or with Timeout once
+// the cycle budget is spent
+Core::TestResult::Result Machine::runTest(uint64_t cycleBudget, uint64_t &elapsedCycles) {
+    elapsedCycles = 0;
+    while (elapsedCycles < cycleBudget) {
+        uint8_t cycles = step();
+        elapsedCycles += cycles;
+        frameCycles += cycles;
+        if (frameCycles >= CyclesPerFrame) {
+            endFrame();
+        }
+        Core::TestResult::Result result = testResult();
+        if (result != Core::TestResult::Running) {
+            return result;
+        }
+    }
+    return Core::TestResult::Timeout;
+}
+
+Core::TestResult::Result Machine::testResult() const {
+    Core::TestResult::Result result = serial->testResult();
+    if (result != Core::TestResult::Running) {
+        return result;
+    }
+    return processor->testResult();
+}
+
+void Machine::endFrame() {
+    frameCycles -= CyclesPerFrame;
+    if (sound->availableSamples() > AudioBufferSize) {
+        sound->discardSamples();
+    }
+}
+
+void Machine::saveState(std::vector<uint8_t> &state) const {
+    state.clear();
+    Core::SaveState::Header header = Core::SaveState::Header();
+    header.magic = Core::SaveState::Magic;
+    header.version = Core::SaveState::Version;
+    header.cgbFlag = cartridge->cgbFlag();
+    memcpy(header.title, cartridge->getHeader().title._value, sizeof(header.title));
+    memcpy(header.globalChecksum, cartridge->getHeader().globalChecksum, sizeof(header.globalChecksum));
+    Core::SaveState::Writer writer = Core::SaveState::Writer(state);
+    writer.write(header);
+    saveDevices(writer);
+    header.size = writer.size();
+    memcpy(&state[0], &header, sizeof(header));
+}
+
+bool Machine::loadState(const std::vector<uint8_t> &state) {
+    Core::SaveState::Reader reader = Core::SaveState::Reader(state);
+    Core::SaveState::Header header;
+    if (state.size() < sizeof(header)) {
+        logger.logWarning("Save state is too small to be valid");
+        return false;
+    }
+    reader.read(header);
+    if (header.magic != Core::SaveState::Magic) {
+        logger.logWarning("Not a save state");
+        return false;
+    }
+    if (header.version != Core::SaveState::Version) {
+        logger.logWarning("Unsupported save state version: %d, expected: %d", header.version, Core::SaveState::Version);
+        return false;
+    }
+    if (header.size != state.size()) {
+        logger.logWarning("Save state size mismatch: %d, expected: %d", header.size, (uint32_t)state.size());
+        return false;
+    }
+    if (header.cgbFlag != cartridge->cgbFlag() ||
+        memcmp(header.title, cartridge->getHeader().title._value, sizeof(header.title)) != 0 ||
+        memcmp(header.globalChecksum, cartridge->getHeader().globalChecksum, sizeof(header.globalChecksum)) != 0) {
+        logger.logWarning("Save state was created for a different cartridge");
+        return false;
+    }
+    // Failing halfway would leave devices partially loaded, so every size
+    // and count is checked by a read only pass first
+    try {
+        Core::SaveState::Reader validationReader = reader;
+        validateDevices(validationReader);
+    } catch (const std::runtime_error &error) {
+        logger.logWarning("Unable to load save state: %s", error.what());
+        return false;
+    }
+    loadDevices(reader);
+    return true;
+}
+
+// The child starts out sharing the cartridge ROM and every page of guest
+// memory with this machine, pages are only copied once either side writes
+// to them. Registers are copied device by device, the LCD output isn't and
+// gets redrawn by the child's next frame. Must be called from the thread
+// running this machine.
+std::unique_ptr<Machine> Machine::fork() {
+    std::unique_ptr<Machine> child = std::make_unique<Machine>(configuration);
+    child->cartridge->share(*cartridge);
+    child->bootROM->share(*bootROM);
+    child->PPU->setCGBFlag(cartridge->cgbFlag());
+    child->PPU->shareMemory(*PPU);
+    child->memoryController->shareMemory(*memoryController);
+    child->scheduler->copyState(*scheduler);
+    child->interrupt->copyState(*interrupt);
+    child->timer->copyState(*timer);
+    child->joypad->copyState(*joypad);
+    child->serial->copyState(*serial);
+    child->DMA->copyState(*DMA);
+    child->PPU->copyState(*PPU);
+    child->sound->copyState(*sound);
+    child->memoryController->copyState(*memoryController);
+    child->processor->copyState(*processor);
+    child->frameCycles = frameCycles;
+    child->executedInstructions = executedInstructions;
+    return child;
+}
+
+void Machine::saveDevices(Core::SaveState::Writer &writer) const {
+    scheduler->saveState(writer);
+    interrupt->saveState(writer);
+    timer->saveState(writer);
+    joypad->saveState(writer);
+    serial->saveState(writer);
+    DMA->saveState(writer);
+    PPU->saveState(writer);
+    sound->saveState(writer);
+    bootROM->saveState(writer);
+    memoryController->saveState(writer);
+    processor->saveState(writer);
+    writer.write(frameCycles);
+    writer.write(executedInstructions);
+}
+
+void Machine::loadDevices(Core::SaveState::Reader &reader) {
+    scheduler->loadState(reader);
+    interrupt->loadState(reader);
+    timer->loadState(reader);
+    joypad->loadState(reader);
+    serial->loadState(reader);
+    DMA->loadState(reader);
+    PPU->loadState(reader);
+    sound->loadState(reader);
+    bootROM->loadState(reader);
+    memoryController->loadState(reader);
+    processor->loadState(reader);
+    reader.read(frameCycles);
+    reader.read(executedInstructions);
+}
+
+void Machine::validateDevices(Core::SaveState::Reader &reader) const {
+    scheduler->validateState(reader);
+    interrupt->validateState(reader);
+    timer->validateState(reader);
+    joypad->validateState(reader);
+    serial->validateState(reader);
+    DMA->validateState(reader);
+    PPU->validateState(reader);
+    sound->validateState(reader);
+    bootROM->validateState(reader);
+    memoryController->validateState(reader);
+    processor->validateState(reader);
+    reader.skipBytes(sizeof(frameCycles) + sizeof(executedInstructions));
+    if (reader.remaining() != 0) {
+        throw std::runtime_error("Corrupted save state");
+    }
+}
+
+std::unique_ptr<Core::Palette::Selector> &Machine::getPaletteSelector() {
+    return paletteSelector;
+}
+
+std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &Machine::getPPU() {
+    return PPU;
+}
+
+std::unique_ptr<Core::Device::Sound::Controller> &Machine::getSound() {
+    return sound;
+}
+
+std::unique_ptr<Core::Device::JoypadInput::Controller> &Machine::getJoypad() {
+    return joypad;
+}
+
+std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &Machine::getSerial() {
+    return serial;
+}
+
+std::unique_ptr<Core::ROM::Cartridge> &Machine::getCartridge() {
+    return cartridge;
+}
+
+std::unique_ptr<Core::Memory::Controller> &Machine::getMemoryController() {
+    return memoryController;
+}
+
+std::unique_ptr<Core::CPU::Processor> &Machine::getProcessor() {
+    return processor;
+}
+
+std::unique_ptr<Core::CPU::Disassembler::Disassembler> &Machine::getDisassembler() {
+    return disassembler;
+}
+
+uint64_t Machine::getExecutedInstructions() const {
+    return executedInstructions;
+}
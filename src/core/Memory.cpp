@@ -3,11 +3,11 @@
 #include "core/device/SerialDataTransfer.hpp"
 #include "core/device/PictureProcessingUnit.hpp"
 #include "core/ROM.hpp"
-#include "shinobu/Configuration.hpp"
 #include "core/device/Interrupt.hpp"
 #include "core/device/Timer.hpp"
 #include "core/device/JoypadInput.hpp"
 #include "core/device/Sound.hpp"
+#include "core/Scheduler.hpp"
 #include <cstring>
 #include "common/System.hpp"
 
@@ -30,18 +30,74 @@ std::optional<uint32_t> Range::contains(uint32_t address) const {
     }
  }
 
+static IORegister IORegisterForAddress(uint16_t address) {
+    std::optional<uint32_t> offset = Core::Device::JoypadInput::AddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::JoypadRegister, *offset);
+    }
+    offset = Core::Device::SerialDataTransfer::AddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::SerialRegister, *offset);
+    }
+    offset = Core::Device::PictureProcessingUnit::AddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::LCDRegister, *offset);
+    }
+    offset = Core::Device::PictureProcessingUnit::VBKAddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::VBKRegister, *offset);
+    }
+    offset = Core::Device::DirectMemoryAccess::HDMA::AddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::HDMARegister, *offset);
+    }
+    offset = Core::Device::PictureProcessingUnit::ColorPaletteRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::ColorPaletteRegister, *offset);
+    }
+    offset = Core::ROM::BOOT::BootROMRegisterRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::BootROMLockRegister, *offset);
+    }
+    offset = Core::Device::Interrupt::FlagAddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::InterruptFlagRegister, *offset);
+    }
+    offset = Core::Device::Timer::AddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::TimerRegister, *offset);
+    }
+    offset = Core::Device::Sound::AddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::SoundRegister, *offset);
+    }
+    offset = Core::Memory::SVBKRegisterRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::SVBKRegister, *offset);
+    }
+    offset = Core::Memory::KEY1AddressRange.contains(address);
+    if (offset) {
+        return IORegister(IORegisterHandler::KEY1Register, *offset);
+    }
+    return IORegister();
+}
+
 BankController::BankController(Common::Logs::Level logLevel,
+                               BankControllerType type,
                                std::unique_ptr<Core::ROM::Cartridge> &cartridge,
                                std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                               std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                                std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                                std::unique_ptr<Core::Device::Sound::Controller> &sound,
                                std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                                std::unique_ptr<Core::Device::Timer::Controller> &timer,
                                std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
                                std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : logger(logLevel, "  [Memory]: "),
+                                                                                                     type(type),
                                                                                                      cartridge(cartridge),
                                                                                                      bootROM(bootROM),
                                                                                                      WRAMBank(),
+                                                                                                     serialCommController(serialCommController),
                                                                                                      PPU(PPU),
                                                                                                      sound(sound),
                                                                                                      HRAM(),
@@ -51,15 +107,29 @@ BankController::BankController(Common::Logs::Level logLevel,
                                                                                                      joypad(joypad),
                                                                                                      DMA(DMA),
                                                                                                      _SVBK(),
-                                                                                                     _KEY1() {
+                                                                                                     _KEY1(),
+                                                                                                     loadPages(),
+                                                                                                     storePages(),
+                                                                                                     loadVersions(),
+                                                                                                     storeVersions(),
+                                                                                                     WRAMVersions(),
+                                                                                                     externalRAMVersions(),
+                                                                                                     IORegisters(),
+                                                                                                     bootROMMapped() {
     externalRAM.resize(cartridge->RAMSize());
     if (cartridge->cgbFlag() == Core::ROM::CGBFlag::DMG) {
         WRAMBank.resize(WRAMBankSize * 2);
     } else {
         WRAMBank.resize(WRAMBankSize * 8);
     }
-    Shinobu::Configuration::Manager *configurationManager = Shinobu::Configuration::Manager::getInstance();
-    serialCommController = std::make_unique<Device::SerialDataTransfer::Controller>(configurationManager->serialLogLevel());
+    WRAMVersions.resize(WRAMBank.size() / MemoryPageSize);
+    externalRAMVersions.resize((externalRAM.size() + MemoryPageSize - 1) / MemoryPageSize);
+    for (uint16_t address = 0xFF00; address < 0xFF80; address++) {
+        IORegisters[address & 0x7F] = IORegisterForAddress(address);
+    }
+    mapWRAMPages();
+    // Address 0x0 is always overlaid by the BOOT ROM while it's mapped
+    bootROMMapped = bootROM->shouldHandleAddress(0x0, cartridge->cgbFlag());
 }
 
 BankController::~BankController() {
@@ -83,7 +153,13 @@ void BankController::loadExternalRAMFromSaveFile() {
     logger.logMessage("Opened save file path of size: %x", fileSize);
 
     file.seekg(0, file.beg);
-    file.read(reinterpret_cast<char *>(&externalRAM[0]), cartridge->RAMSize());
+    std::vector<uint8_t> data = std::vector<uint8_t>(externalRAM.size());
+    file.read(reinterpret_cast<char *>(data.data()), data.size());
+    for (uint32_t physicalAddress = 0; physicalAddress < data.size(); physicalAddress += MemoryPageSize) {
+        if (memcmp(externalRAM.page(physicalAddress / MemoryPageSize), &data[physicalAddress], MemoryPageSize) != 0) {
+            memcpy(writablePage(externalRAM, physicalAddress, &externalRAMVersions[0]), &data[physicalAddress], MemoryPageSize);
+        }
+    }
 
     if (fileSize > cartridge->RAMSize() && cartridge->hasRTC()) {
         uint32_t remainingData = (uint32_t)fileSize - cartridge->RAMSize();
@@ -106,7 +182,9 @@ void BankController::saveExternalRAM() {
     if (cartridge->hasBattery()) {
         std::ofstream saveFile = std::ofstream();
         saveFile.open(cartridge->saveFilePath(), std::ios::out | std::ios::trunc | std::ios::binary);
-        saveFile.write(reinterpret_cast<char *>(&externalRAM[0]), externalRAM.size());
+        std::vector<uint8_t> data = std::vector<uint8_t>(externalRAM.size());
+        externalRAM.read(data.data(), data.size());
+        saveFile.write(reinterpret_cast<char *>(data.data()), data.size());
         if (cartridge->hasRTC()) {
             std::vector<uint8_t> clockData = dynamic_cast<Core::Memory::MBC3::Controller*>(this)->clockData();
             saveFile.write(reinterpret_cast<char *>(&clockData[0]), clockData.size());
@@ -126,6 +204,312 @@ SpeedSwitch::Speed BankController::currentSpeed() const {
     return _KEY1.currentSpeed();
 }
 
+void BankController::saveState(Core::SaveState::Writer &writer) const {
+    WRAMBank.saveState(writer);
+    writer.write(HRAM);
+    externalRAM.saveState(writer);
+    writer.write(_SVBK);
+    writer.write(_KEY1);
+    writer.write(bootROMMapped);
+    switch (type) {
+    case BankControllerType::ROMBankController:
+        break;
+    case BankControllerType::MBC1BankController:
+        static_cast<const MBC1::Controller *>(this)->saveBankingState(writer);
+        break;
+    case BankControllerType::MBC3BankController:
+        static_cast<const MBC3::Controller *>(this)->saveBankingState(writer);
+        break;
+    case BankControllerType::MBC5BankController:
+        static_cast<const MBC5::Controller *>(this)->saveBankingState(writer);
+        break;
+    }
+}
+
+void BankController::loadState(Core::SaveState::Reader &reader) {
+    WRAMBank.loadState(reader);
+    reader.read(HRAM);
+    externalRAM.loadState(reader);
+    reader.read(_SVBK);
+    reader.read(_KEY1);
+    reader.read(bootROMMapped);
+    switch (type) {
+    case BankControllerType::ROMBankController:
+        break;
+    case BankControllerType::MBC1BankController:
+        static_cast<MBC1::Controller *>(this)->loadBankingState(reader);
+        break;
+    case BankControllerType::MBC3BankController:
+        static_cast<MBC3::Controller *>(this)->loadBankingState(reader);
+        break;
+    case BankControllerType::MBC5BankController:
+        static_cast<MBC5::Controller *>(this)->loadBankingState(reader);
+        break;
+    }
+    mapWRAMPages();
+    // Every page was rewritten behind the store fast path
+    for (uint32_t &version : WRAMVersions) {
+        version++;
+    }
+    for (uint32_t &version : externalRAMVersions) {
+        version++;
+    }
+}
+
+void BankController::validateState(Core::SaveState::Reader &reader) const {
+    WRAMBank.validateState(reader);
+    reader.skipBytes(sizeof(HRAM));
+    externalRAM.validateState(reader);
+    reader.skipBytes(sizeof(_SVBK) + sizeof(_KEY1) + sizeof(bootROMMapped));
+    switch (type) {
+    case BankControllerType::ROMBankController:
+        break;
+    case BankControllerType::MBC1BankController:
+        static_cast<const MBC1::Controller *>(this)->validateBankingState(reader);
+        break;
+    case BankControllerType::MBC3BankController:
+        static_cast<const MBC3::Controller *>(this)->validateBankingState(reader);
+        break;
+    case BankControllerType::MBC5BankController:
+        static_cast<const MBC5::Controller *>(this)->validateBankingState(reader);
+        break;
+    }
+}
+
+// Paged memory is shared through shareMemory
+void BankController::copyState(const BankController &other) {
+    HRAM = other.HRAM;
+    _SVBK = other._SVBK;
+    _KEY1 = other._KEY1;
+    bootROMMapped = other.bootROMMapped;
+    switch (type) {
+    case BankControllerType::ROMBankController:
+        break;
+    case BankControllerType::MBC1BankController:
+        static_cast<MBC1::Controller *>(this)->copyBankingState(static_cast<const MBC1::Controller &>(other));
+        break;
+    case BankControllerType::MBC3BankController:
+        static_cast<MBC3::Controller *>(this)->copyBankingState(static_cast<const MBC3::Controller &>(other));
+        break;
+    case BankControllerType::MBC5BankController:
+        static_cast<MBC5::Controller *>(this)->copyBankingState(static_cast<const MBC5::Controller &>(other));
+        break;
+    }
+    mapWRAMPages();
+}
+
+void BankController::mapPages(uint16_t address, uint16_t length, const uint8_t *source) {
+    for (uint16_t page = 0; page < (length / MemoryPageSize); page++) {
+        loadPages[(address / MemoryPageSize) + page] = source + (page * MemoryPageSize);
+        storePages[(address / MemoryPageSize) + page] = nullptr;
+        loadVersions[(address / MemoryPageSize) + page] = nullptr;
+        storeVersions[(address / MemoryPageSize) + page] = nullptr;
+    }
+}
+
+// Shared pages keep their store version but go through storeSlow, which
+// copies them before the first write
+void BankController::mapPages(uint16_t address, uint16_t length, PagedBuffer &buffer, uint32_t physicalAddress, uint32_t *versions) {
+    for (uint16_t page = 0; page < (length / MemoryPageSize); page++) {
+        uint32_t index = (physicalAddress / MemoryPageSize) + page;
+        loadPages[(address / MemoryPageSize) + page] = buffer.page(index);
+        storePages[(address / MemoryPageSize) + page] = buffer.isShared(index) ? nullptr : buffer.writablePage(index);
+        loadVersions[(address / MemoryPageSize) + page] = &versions[index];
+        storeVersions[(address / MemoryPageSize) + page] = &versions[index];
+    }
+}
+
+void BankController::unmapPages(uint16_t address, uint16_t length) {
+    for (uint16_t page = 0; page < (length / MemoryPageSize); page++) {
+        loadPages[(address / MemoryPageSize) + page] = nullptr;
+        storePages[(address / MemoryPageSize) + page] = nullptr;
+        loadVersions[(address / MemoryPageSize) + page] = nullptr;
+        storeVersions[(address / MemoryPageSize) + page] = nullptr;
+    }
+}
+
+void BankController::mapROMPages(uint16_t address, uint32_t physicalAddress) {
+    for (uint16_t page = 0; page < (0x4000 / MemoryPageSize); page++) {
+        loadPages[(address / MemoryPageSize) + page] = cartridge->pageAt(physicalAddress + (page * MemoryPageSize));
+        storePages[(address / MemoryPageSize) + page] = nullptr;
+        loadVersions[(address / MemoryPageSize) + page] = nullptr;
+        storeVersions[(address / MemoryPageSize) + page] = nullptr;
+    }
+}
+
+void BankController::mapExternalRAMPages(bool loadEnabled, bool storeEnabled, uint32_t physicalAddress) {
+    if ((physicalAddress + 0x2000) > externalRAM.size()) {
+        unmapPages(0xA000, 0x2000);
+        return;
+    }
+    for (uint16_t page = 0; page < (0x2000 / MemoryPageSize); page++) {
+        uint32_t index = (physicalAddress / MemoryPageSize) + page;
+        const uint8_t *source = externalRAM.page(index);
+        uint32_t *version = &externalRAMVersions[index];
+        loadPages[(0xA000 / MemoryPageSize) + page] = loadEnabled ? source : nullptr;
+        storePages[(0xA000 / MemoryPageSize) + page] = storeEnabled && !externalRAM.isShared(index) ? externalRAM.writablePage(index) : nullptr;
+        loadVersions[(0xA000 / MemoryPageSize) + page] = loadEnabled ? version : nullptr;
+        storeVersions[(0xA000 / MemoryPageSize) + page] = storeEnabled ? version : nullptr;
+    }
+}
+
+void BankController::mapWRAMPages() {
+    mapPages(0xC000, 0x1000, WRAMBank, 0x0, &WRAMVersions[0]);
+    uint32_t upperMask = _SVBK.WRAMBank;
+    uint32_t physicalAddress = upperMask << 12;
+    if ((physicalAddress + WRAMBankSize) <= WRAMBank.size()) {
+        mapPages(0xD000, 0x1000, WRAMBank, physicalAddress, &WRAMVersions[0]);
+    } else {
+        unmapPages(0xD000, 0x1000);
+    }
+    mapPages(0xE000, 0x1E00, WRAMBank, 0x0, &WRAMVersions[0]);
+}
+
+// Stores only land here when the page isn't mapped writable, because it's
+// still shared or was when it got mapped (the other side of a fork copied
+// it since). Either way only the mappings of that one page are stale.
+uint8_t *BankController::writablePage(PagedBuffer &buffer, uint32_t physicalAddress, uint32_t *versions) {
+    uint32_t index = physicalAddress / MemoryPageSize;
+    uint8_t *page = buffer.writablePage(index);
+    remapPage(&versions[index], page);
+    return page;
+}
+
+// Versions are unique per physical page, so they identify every virtual
+// page the physical one is mapped at (echo RAM included)
+void BankController::remapPage(const uint32_t *version, uint8_t *page) {
+    for (uint16_t index = (0xA000 / MemoryPageSize); index < (0xFE00 / MemoryPageSize); index++) {
+        if (loadVersions[index] == version) {
+            loadPages[index] = page;
+        }
+        if (storeVersions[index] == version) {
+            storePages[index] = page;
+        }
+    }
+}
+
+void BankController::updateBankedPages() {
+    mapWRAMPages();
+    switch (type) {
+    case BankControllerType::ROMBankController:
+        static_cast<ROM::Controller *>(this)->updatePages();
+        return;
+    case BankControllerType::MBC1BankController:
+        static_cast<MBC1::Controller *>(this)->updatePages();
+        return;
+    case BankControllerType::MBC3BankController:
+        static_cast<MBC3::Controller *>(this)->updatePages();
+        return;
+    case BankControllerType::MBC5BankController:
+        static_cast<MBC5::Controller *>(this)->updatePages();
+        return;
+    }
+}
+
+// Both controllers end up with every shared page mapped read only, the
+// first store to one of them goes through storeSlow and copies it
+void BankController::shareMemory(BankController &other) {
+    WRAMBank = other.WRAMBank;
+    externalRAM = other.externalRAM;
+    updateBankedPages();
+    other.updateBankedPages();
+}
+
+// Bumping the version also invalidates blocks decoded from the shared copy
+void BankController::storeWRAM(uint32_t physicalAddress, uint8_t value) {
+    writablePage(WRAMBank, physicalAddress, &WRAMVersions[0])[physicalAddress % MemoryPageSize] = value;
+    WRAMVersions[physicalAddress / MemoryPageSize]++;
+}
+
+void BankController::storeExternalRAM(uint32_t physicalAddress, uint8_t value) {
+    writablePage(externalRAM, physicalAddress, &externalRAMVersions[0])[physicalAddress % MemoryPageSize] = value;
+    externalRAMVersions[physicalAddress / MemoryPageSize]++;
+}
+
+uint8_t BankController::loadIORegister(uint16_t address) const {
+    IORegister entry = IORegisters[address & 0x7F];
+    switch (entry.handler) {
+    case IORegisterHandler::JoypadRegister:
+        return joypad->load();
+    case IORegisterHandler::SerialRegister:
+        return serialCommController->load(entry.offset);
+    case IORegisterHandler::LCDRegister:
+        return PPU->load(entry.offset);
+    case IORegisterHandler::VBKRegister:
+        return PPU->VBKLoad(entry.offset);
+    case IORegisterHandler::HDMARegister:
+        return DMA->HDMALoad(entry.offset);
+    case IORegisterHandler::ColorPaletteRegister:
+        return PPU->colorPaletteLoad(entry.offset);
+    case IORegisterHandler::BootROMLockRegister:
+        return bootROM->loadLockRegister();
+    case IORegisterHandler::InterruptFlagRegister:
+        return interrupt->loadFlag();
+    case IORegisterHandler::TimerRegister:
+        return timer->load(entry.offset);
+    case IORegisterHandler::SoundRegister:
+        return sound->load(address);
+    case IORegisterHandler::SVBKRegister:
+        return _SVBK._value;
+    case IORegisterHandler::KEY1Register:
+        return _KEY1._value;
+    case IORegisterHandler::UnhandledRegister:
+        break;
+    }
+    logger.logWarning("Unhandled I/O Register load at address: %04x", address);
+    return 0;
+}
+
+void BankController::storeIORegister(uint16_t address, uint8_t value) {
+    IORegister entry = IORegisters[address & 0x7F];
+    switch (entry.handler) {
+    case IORegisterHandler::JoypadRegister:
+        joypad->store(value);
+        return;
+    case IORegisterHandler::SerialRegister:
+        serialCommController->store(entry.offset, value);
+        return;
+    case IORegisterHandler::LCDRegister:
+        PPU->store(entry.offset, value);
+        return;
+    case IORegisterHandler::VBKRegister:
+        PPU->VBKStore(entry.offset, value);
+        return;
+    case IORegisterHandler::HDMARegister:
+        DMA->HDMAStore(entry.offset, value);
+        return;
+    case IORegisterHandler::ColorPaletteRegister:
+        PPU->colorPaletteStore(entry.offset, value);
+        return;
+    case IORegisterHandler::BootROMLockRegister:
+        bootROM->storeLockRegister(value);
+        bootROMMapped = bootROM->shouldHandleAddress(0x0, cartridge->cgbFlag());
+        return;
+    case IORegisterHandler::InterruptFlagRegister:
+        interrupt->storeFlag(value);
+        return;
+    case IORegisterHandler::TimerRegister:
+        timer->store(entry.offset, value);
+        return;
+    case IORegisterHandler::SoundRegister:
+        sound->store(address, value);
+        return;
+    case IORegisterHandler::SVBKRegister:
+        _SVBK._value = value;
+        if (_SVBK.WRAMBank == 0x0) {
+            _SVBK.WRAMBank = 0x1;
+        }
+        mapWRAMPages();
+        return;
+    case IORegisterHandler::KEY1Register:
+        _KEY1._value = value;
+        return;
+    case IORegisterHandler::UnhandledRegister:
+        break;
+    }
+    logger.logWarning("Unhandled I/O Register write at address: %04x with value: %02x", address, value);
+}
+
 uint8_t BankController::loadInternal(uint16_t address) const {
     std::optional<uint32_t> offset = VideoRAM.contains(address);
     if (offset) {
@@ -158,56 +542,7 @@ uint8_t BankController::loadInternal(uint16_t address) const {
     }
     offset = I_ORegisters.contains(address);
     if (offset) {
-        offset = Device::JoypadInput::AddressRange.contains(address);
-        if (offset) {
-            return joypad->load();
-        }
-        offset = Device::SerialDataTransfer::AddressRange.contains(address);
-        if (offset) {
-            return serialCommController->load(*offset);
-        }
-        offset = Device::PictureProcessingUnit::AddressRange.contains(address);
-        if (offset) {
-            return PPU->load(*offset);;
-        }
-        offset = Device::PictureProcessingUnit::VBKAddressRange.contains(address);
-        if (offset) {
-            return PPU->VBKLoad(*offset);
-        }
-        offset = Device::DirectMemoryAccess::HDMA::AddressRange.contains(address);
-        if (offset) {
-            return DMA->HDMALoad(*offset);
-        }
-        offset = Device::PictureProcessingUnit::ColorPaletteRange.contains(address);
-        if (offset) {
-            return PPU->colorPaletteLoad(*offset);
-        }
-        offset = Core::ROM::BOOT::BootROMRegisterRange.contains(address);
-        if (offset) {
-            return bootROM->loadLockRegister();
-        }
-        offset = Core::Device::Interrupt::FlagAddressRange.contains(address);
-        if (offset) {
-            return interrupt->loadFlag();
-        }
-        offset = Core::Device::Timer::AddressRange.contains(address);
-        if (offset) {
-            return timer->load(*offset);
-        }
-        offset = Core::Device::Sound::AddressRange.contains(address);
-        if (offset) {
-            return sound->load(address);
-        }
-        offset = Core::Memory::SVBKRegisterRange.contains(address);
-        if (offset) {
-            return _SVBK._value;
-        }
-        offset = Core::Memory::KEY1AddressRange.contains(address);
-        if (offset) {
-            return _KEY1._value;
-        }
-        logger.logWarning("Unhandled I/O Register load at address: %04x", address);
-        return 0;
+        return loadIORegister(address);
     }
     offset = HighRAM.contains(address);
     if (offset) {
@@ -231,19 +566,19 @@ void BankController::storeInternal(uint16_t address, uint8_t value) {
     }
     offset = WorkRAMBank00.contains(address);
     if (offset) {
-        WRAMBank[*offset] = value;
+        storeWRAM(*offset, value);
         return;
     }
     offset = WorkRAMBank01_N.contains(address);
     if (offset) {
         uint32_t upperMask = _SVBK.WRAMBank;
         uint32_t physicalAddress = (upperMask << 12) | (*offset & 0xFFF);
-        WRAMBank[physicalAddress] = value;
+        storeWRAM(physicalAddress, value);
         return;
     }
     offset = EchoRAM.contains(address);
     if (offset) {
-        WRAMBank[*offset] = value;
+        storeWRAM(*offset, value);
         return;
     }
     offset = SpriteAttributeTable.contains(address);
@@ -258,70 +593,7 @@ void BankController::storeInternal(uint16_t address, uint8_t value) {
     }
     offset = I_ORegisters.contains(address);
     if (offset) {
-        offset = Device::JoypadInput::AddressRange.contains(address);
-        if (offset) {
-            joypad->store(value);
-            return;
-        }
-        offset = Device::SerialDataTransfer::AddressRange.contains(address);
-        if (offset) {
-            serialCommController->store(*offset, value);
-            return;
-        }
-        offset = Device::PictureProcessingUnit::AddressRange.contains(address);
-        if (offset) {
-            PPU->store(*offset, value);
-            return;
-        }
-        offset = Device::PictureProcessingUnit::VBKAddressRange.contains(address);
-        if (offset) {
-            PPU->VBKStore(*offset, value);
-            return;
-        }
-        offset = Device::DirectMemoryAccess::HDMA::AddressRange.contains(address);
-        if (offset) {
-            DMA->HDMAStore(*offset, value);
-            return;
-        }
-        offset = Device::PictureProcessingUnit::ColorPaletteRange.contains(address);
-        if (offset) {
-            PPU->colorPaletteStore(*offset, value);
-            return;
-        }
-        offset = Core::ROM::BOOT::BootROMRegisterRange.contains(address);
-        if (offset) {
-            bootROM->storeLockRegister(value);
-            return;
-        }
-        offset = Core::Device::Interrupt::FlagAddressRange.contains(address);
-        if (offset) {
-            interrupt->storeFlag(value);
-            return;
-        }
-        offset = Device::Timer::AddressRange.contains(address);
-        if (offset) {
-            timer->store(*offset, value);
-            return;
-        }
-        offset = Device::Sound::AddressRange.contains(address);
-        if (offset) {
-            sound->store(address, value);
-            return;
-        }
-        offset = Core::Memory::SVBKRegisterRange.contains(address);
-        if (offset) {
-            _SVBK._value = value;
-            if (_SVBK.WRAMBank == 0x0) {
-                _SVBK.WRAMBank = 0x1;
-            }
-            return;
-        }
-        offset = Core::Memory::KEY1AddressRange.contains(address);
-        if (offset) {
-            _KEY1._value = value;
-            return;
-        }
-        logger.logWarning("Unhandled I/O Register write at address: %04x with value: %02x", address, value);
+        storeIORegister(address, value);
         return;
     }
     offset = HighRAM.contains(address);
@@ -338,7 +610,16 @@ void BankController::storeInternal(uint16_t address, uint8_t value) {
     return;
 }
 
-uint8_t ROM::Controller::load(uint16_t address) const {
+void ROM::Controller::updatePages() {
+    updateROMPages();
+}
+
+void ROM::Controller::updateROMPages() {
+    mapROMPages(0x0, 0x0);
+    mapROMPages(0x4000, 0x4000);
+}
+
+uint8_t ROM::Controller::loadBanked(uint16_t address) const {
     std::optional<uint32_t> offset = ROMRange.contains(address);
     if (offset) {
         return cartridge->load(*offset);
@@ -346,7 +627,7 @@ uint8_t ROM::Controller::load(uint16_t address) const {
     return loadInternal(address);
 }
 
-void ROM::Controller::store(uint16_t address, uint8_t value) {
+void ROM::Controller::storeBanked(uint16_t address, uint8_t value) {
     std::optional<uint32_t> offset = Core::Memory::MBC1::BANK1Range.contains(address);
     if (offset) {
         return;
@@ -355,7 +636,54 @@ void ROM::Controller::store(uint16_t address, uint8_t value) {
     return;
 }
 
-uint8_t MBC1::Controller::load(uint16_t address) const {
+void MBC1::Controller::updatePages() {
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC1::Controller::updateROMPages() {
+    uint32_t upperMask = mode.mode ? _BANK2.bank2 << 5 : 0x0;
+    mapROMPages(0x0, (upperMask << 14) % cartridge->ROMSize());
+    upperMask = _BANK2.bank2 << 5 | _BANK1.bank1;
+    mapROMPages(0x4000, (upperMask << 14) % cartridge->ROMSize());
+}
+
+void MBC1::Controller::saveBankingState(Core::SaveState::Writer &writer) const {
+    writer.write(_RAMG);
+    writer.write(_BANK1);
+    writer.write(_BANK2);
+    writer.write(mode);
+}
+
+void MBC1::Controller::loadBankingState(Core::SaveState::Reader &reader) {
+    reader.read(_RAMG);
+    reader.read(_BANK1);
+    reader.read(_BANK2);
+    reader.read(mode);
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC1::Controller::validateBankingState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(_RAMG) + sizeof(_BANK1) + sizeof(_BANK2) + sizeof(mode));
+}
+
+void MBC1::Controller::copyBankingState(const Controller &other) {
+    _RAMG = other._RAMG;
+    _BANK1 = other._BANK1;
+    _BANK2 = other._BANK2;
+    mode = other.mode;
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC1::Controller::updateExternalRAMPages() {
+    bool enabled = _RAMG.enableAccess == 0b1010;
+    uint32_t upperMask = mode.mode ? _BANK2.bank2 : 0x0;
+    mapExternalRAMPages(enabled, enabled, upperMask << 13);
+}
+
+uint8_t MBC1::Controller::loadBanked(uint16_t address) const {
     std::optional<uint32_t> offset = ROMBank00.contains(address);
     if (offset) {
         uint32_t upperMask = mode.mode ? _BANK2.bank2 << 5 : 0x0;
@@ -381,10 +709,11 @@ uint8_t MBC1::Controller::load(uint16_t address) const {
     return loadInternal(address);
 }
 
-void MBC1::Controller::store(uint16_t address, uint8_t value) {
+void MBC1::Controller::storeBanked(uint16_t address, uint8_t value) {
     std::optional<uint32_t> offset = RAMGRange.contains(address);
     if (offset) {
         _RAMG._value = value;
+        updateExternalRAMPages();
         return;
     }
     offset = BANK1Range.contains(address);
@@ -393,16 +722,21 @@ void MBC1::Controller::store(uint16_t address, uint8_t value) {
         if (_BANK1.bank1 == 0) {
             _BANK1.bank1 = 1;
         }
+        updateROMPages();
         return;
     }
     offset = BANK2Range.contains(address);
     if (offset) {
         _BANK2._value = value;
+        updateROMPages();
+        updateExternalRAMPages();
         return;
     }
     offset = ModeRange.contains(address);
     if (offset) {
         mode._value = value;
+        updateROMPages();
+        updateExternalRAMPages();
         return;
     }
     offset = ExternalRAM.contains(address);
@@ -410,7 +744,7 @@ void MBC1::Controller::store(uint16_t address, uint8_t value) {
         if (_RAMG.enableAccess == 0b1010) {
             uint32_t upperMask = mode.mode ? _BANK2.bank2 : 0x0;
             uint32_t physicalAddress = (upperMask << 13) | (address & 0x1FFF);
-            externalRAM[physicalAddress] = value;
+            storeExternalRAM(physicalAddress, value);
         }
         return;
     }
@@ -418,7 +752,77 @@ void MBC1::Controller::store(uint16_t address, uint8_t value) {
     return;
 }
 
-uint8_t MBC3::Controller::load(uint16_t address) const {
+void MBC3::Controller::updatePages() {
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC3::Controller::updateROMPages() {
+    mapROMPages(0x0, 0x0);
+    uint32_t upperMask = _ROMBANK._value;
+    mapROMPages(0x4000, (upperMask << 14) % cartridge->ROMSize());
+}
+
+void MBC3::Controller::saveBankingState(Core::SaveState::Writer &writer) const {
+    writer.write(_RAMG);
+    writer.write(_ROMBANK);
+    writer.write(_RAMBANK_RTCRegister);
+    writer.write(latchClockData);
+    writer.write(_RTCS);
+    writer.write(_RTCM);
+    writer.write(_RTCH);
+    writer.write(_RTCDL);
+    writer.write(_RTCDH);
+    writer.write<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(lastTimePoint.time_since_epoch()).count());
+    writer.write<int64_t>(calculationRemainder.count());
+}
+
+void MBC3::Controller::loadBankingState(Core::SaveState::Reader &reader) {
+    reader.read(_RAMG);
+    reader.read(_ROMBANK);
+    reader.read(_RAMBANK_RTCRegister);
+    reader.read(latchClockData);
+    reader.read(_RTCS);
+    reader.read(_RTCM);
+    reader.read(_RTCH);
+    reader.read(_RTCDL);
+    reader.read(_RTCDH);
+    // The clock keeps counting the wall time spent between save and load
+    std::chrono::milliseconds lastTime = std::chrono::milliseconds(reader.read<int64_t>());
+    lastTimePoint = std::chrono::time_point<std::chrono::system_clock>(std::chrono::duration_cast<std::chrono::system_clock::duration>(lastTime));
+    calculationRemainder = std::chrono::milliseconds(reader.read<int64_t>());
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC3::Controller::validateBankingState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(_RAMG) + sizeof(_ROMBANK) + sizeof(_RAMBANK_RTCRegister) + sizeof(latchClockData) +
+                     sizeof(_RTCS) + sizeof(_RTCM) + sizeof(_RTCH) + sizeof(_RTCDL) + sizeof(_RTCDH) + sizeof(int64_t) * 2);
+}
+
+void MBC3::Controller::copyBankingState(const Controller &other) {
+    _RAMG = other._RAMG;
+    _ROMBANK = other._ROMBANK;
+    _RAMBANK_RTCRegister = other._RAMBANK_RTCRegister;
+    latchClockData = other.latchClockData;
+    _RTCS = other._RTCS;
+    _RTCM = other._RTCM;
+    _RTCH = other._RTCH;
+    _RTCDL = other._RTCDL;
+    _RTCDH = other._RTCDH;
+    lastTimePoint = other.lastTimePoint;
+    calculationRemainder = other.calculationRemainder;
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC3::Controller::updateExternalRAMPages() {
+    bool enabled = _RAMG.enableAccess == 0b1010 && _RAMBANK_RTCRegister._value <= 0x3;
+    uint32_t upperMask = _RAMBANK_RTCRegister.bank2;
+    mapExternalRAMPages(enabled, enabled, upperMask << 13);
+}
+
+uint8_t MBC3::Controller::loadBanked(uint16_t address) const {
     std::optional<uint32_t> offset = ROMBank00.contains(address);
     if (offset) {
         uint32_t physicalAddress = address & 0x3FFF;
@@ -463,10 +867,11 @@ uint8_t MBC3::Controller::load(uint16_t address) const {
     return loadInternal(address);
 }
 
-void MBC3::Controller::store(uint16_t address, uint8_t value) {
+void MBC3::Controller::storeBanked(uint16_t address, uint8_t value) {
     std::optional<uint32_t> offset = RAMG_TimerEnableRange.contains(address);
     if (offset) {
         _RAMG._value = value;
+        updateExternalRAMPages();
         return;
     }
     offset = ROMBANKRange.contains(address);
@@ -475,11 +880,13 @@ void MBC3::Controller::store(uint16_t address, uint8_t value) {
         if (_ROMBANK.bank1 == 0) {
             _ROMBANK.bank1 = 1;
         }
+        updateROMPages();
         return;
     }
     offset = RAMBANK_RTCRegisterRange.contains(address);
     if (offset) {
         _RAMBANK_RTCRegister._value = value;
+        updateExternalRAMPages();
         return;
     }
     offset = LatchClockDataRange.contains(address);
@@ -499,7 +906,7 @@ void MBC3::Controller::store(uint16_t address, uint8_t value) {
             if (_RAMBANK_RTCRegister._value <= 0x3) {
                 uint32_t upperMask = _RAMBANK_RTCRegister.bank2;
                 uint32_t physicalAddress = (upperMask << 13) | (address & 0x1FFF);
-                externalRAM[physicalAddress] = value;
+                storeExternalRAM(physicalAddress, value);
             } else if (_RAMBANK_RTCRegister._value >= 0x08 && _RAMBANK_RTCRegister._value <= 0x0C) {
                 if (!hasRTC) {
                     logger.logWarning("Using RTC registers when RTC isn't available");
@@ -602,7 +1009,56 @@ void MBC3::Controller::loadClockData(std::vector<uint8_t> clockData) {
     _RTCDH._value = clockData[16];
 }
 
-uint8_t MBC5::Controller::load(uint16_t address) const {
+void MBC5::Controller::updatePages() {
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC5::Controller::updateROMPages() {
+    mapROMPages(0x0, 0x0);
+    uint32_t upperMask = _ROMB1.ROMBankNumberMSB << 8;
+    upperMask |= ROMB0;
+    mapROMPages(0x4000, (upperMask << 14) % cartridge->ROMSize());
+}
+
+void MBC5::Controller::saveBankingState(Core::SaveState::Writer &writer) const {
+    writer.write(RAMG);
+    writer.write(ROMB0);
+    writer.write(_ROMB1);
+    writer.write(_RAMB);
+}
+
+void MBC5::Controller::loadBankingState(Core::SaveState::Reader &reader) {
+    reader.read(RAMG);
+    reader.read(ROMB0);
+    reader.read(_ROMB1);
+    reader.read(_RAMB);
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC5::Controller::validateBankingState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(RAMG) + sizeof(ROMB0) + sizeof(_ROMB1) + sizeof(_RAMB));
+}
+
+void MBC5::Controller::copyBankingState(const Controller &other) {
+    RAMG = other.RAMG;
+    ROMB0 = other.ROMB0;
+    _ROMB1 = other._ROMB1;
+    _RAMB = other._RAMB;
+    updateROMPages();
+    updateExternalRAMPages();
+}
+
+void MBC5::Controller::updateExternalRAMPages() {
+    // Loads and stores check RAMG differently, keep both behaviors.
+    bool loadEnabled = (RAMG & 0xF) == 0b1010;
+    bool storeEnabled = RAMG == 0b00001010;
+    uint32_t upperMask = _RAMB.RAMBankNumber;
+    mapExternalRAMPages(loadEnabled, storeEnabled, upperMask << 13);
+}
+
+uint8_t MBC5::Controller::loadBanked(uint16_t address) const {
     std::optional<uint32_t> offset = ROMBank00.contains(address);
     if (offset) {
         uint32_t physicalAddress = address & 0x3FFF;
@@ -628,25 +1084,29 @@ uint8_t MBC5::Controller::load(uint16_t address) const {
     return loadInternal(address);
 }
 
-void MBC5::Controller::store(uint16_t address, uint8_t value) {
+void MBC5::Controller::storeBanked(uint16_t address, uint8_t value) {
     std::optional<uint32_t> offset = MBC1::RAMGRange.contains(address);
     if (offset) {
         RAMG = value;
+        updateExternalRAMPages();
         return;
     }
     offset = ROMB0Range.contains(address);
     if (offset) {
         ROMB0 = value;
+        updateROMPages();
         return;
     }
     offset = ROMB1Range.contains(address);
     if (offset) {
         _ROMB1._value = value;
+        updateROMPages();
         return;
     }
     offset = RAMBRange.contains(address);
     if (offset) {
         _RAMB._value = value;
+        updateExternalRAMPages();
         return;
     }
     offset = Unmapped.contains(address);
@@ -659,7 +1119,7 @@ void MBC5::Controller::store(uint16_t address, uint8_t value) {
         if (RAMG == 0b00001010) {
             uint32_t upperMask = _RAMB.RAMBankNumber;
             uint32_t physicalAddress = (upperMask << 13) | (address & 0x1FFF);
-            externalRAM[physicalAddress] = value;
+            storeExternalRAM(physicalAddress, value);
         }
         return;
     }
@@ -667,30 +1127,76 @@ void MBC5::Controller::store(uint16_t address, uint8_t value) {
     return;
 }
 
+uint8_t BankController::loadSlow(uint16_t address) const {
+    switch (type) {
+    case BankControllerType::ROMBankController:
+        return static_cast<const ROM::Controller *>(this)->loadBanked(address);
+    case BankControllerType::MBC1BankController:
+        return static_cast<const MBC1::Controller *>(this)->loadBanked(address);
+    case BankControllerType::MBC3BankController:
+        return static_cast<const MBC3::Controller *>(this)->loadBanked(address);
+    case BankControllerType::MBC5BankController:
+        return static_cast<const MBC5::Controller *>(this)->loadBanked(address);
+    }
+    return loadInternal(address);
+}
+
+void BankController::storeSlow(uint16_t address, uint8_t value) {
+    switch (type) {
+    case BankControllerType::ROMBankController:
+        static_cast<ROM::Controller *>(this)->storeBanked(address, value);
+        return;
+    case BankControllerType::MBC1BankController:
+        static_cast<MBC1::Controller *>(this)->storeBanked(address, value);
+        return;
+    case BankControllerType::MBC3BankController:
+        static_cast<MBC3::Controller *>(this)->storeBanked(address, value);
+        return;
+    case BankControllerType::MBC5BankController:
+        static_cast<MBC5::Controller *>(this)->storeBanked(address, value);
+        return;
+    }
+    storeInternal(address, value);
+}
+
 Controller::Controller(Common::Logs::Level logLevel,
                        std::unique_ptr<Core::ROM::Cartridge> &cartridge,
+                       std::unique_ptr<Core::ROM::BOOT::ROM> &bootROM,
+                       std::unique_ptr<Core::Device::SerialDataTransfer::Controller> &serialCommController,
                        std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU,
                        std::unique_ptr<Core::Device::Sound::Controller> &sound,
                        std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
                        std::unique_ptr<Core::Device::Timer::Controller> &timer,
                        std::unique_ptr<Core::Device::JoypadInput::Controller> &joypad,
-                       std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA) : logger(logLevel, "  [Memory]: "),
+                       std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMA,
+                       std::unique_ptr<Core::Scheduler::Scheduler> &scheduler) : logger(logLevel, "  [Memory]: "),
                                                                                              cartridge(cartridge),
+                                                                                             bootROM(bootROM),
+                                                                                             serialCommController(serialCommController),
                                                                                              PPU(PPU),
                                                                                              sound(sound),
                                                                                              interrupt(interrupt),
                                                                                              timer(timer),
                                                                                              joypad(joypad),
                                                                                              DMA(DMA),
+                                                                                             scheduler(scheduler),
                                                                                              cyclesCurrentInstruction(0) {
-    Shinobu::Configuration::Manager *configurationManager = Shinobu::Configuration::Manager::getInstance();
-    bootROM = std::make_unique<Core::ROM::BOOT::ROM>(configurationManager->ROMLogLevel());
 }
 
 Controller::~Controller() {
 
 }
 
+MemoryPage Controller::instructionPage(uint16_t address) const {
+    if (bankController->isBootROMMapped() && bootROM->shouldHandleAddress(address, cartridge->cgbFlag())) {
+        return { nullptr, nullptr };
+    }
+    if (DMA->isActive()) {
+        return { nullptr, nullptr };
+    }
+    return bankController->loadPage(address);
+}
+
 void Controller::beginCurrentInstruction() {
     cyclesCurrentInstruction = 0;
 }
@@ -699,8 +1205,10 @@ void Controller::step(uint8_t cycles) {
     if (cycles == 0) {
         return;
     }
-    timer->step(cycles);
-    DMA->step(cycles);
+    scheduler->advance(cycles);
+    while (scheduler->hasPendingEvent()) {
+        handleEvent(scheduler->popEvent());
+    }
     if (bankController->currentSpeed() == SpeedSwitch::Double) {
         sound->step(cycles / 2);
         PPU->step(cycles / 2);
@@ -712,6 +1220,17 @@ void Controller::step(uint8_t cycles) {
     }
 }
 
+void Controller::handleEvent(Core::Scheduler::Event event) {
+    switch (event.type) {
+    case Core::Scheduler::TimerOverflow:
+        timer->handleOverflow();
+        break;
+    case Core::Scheduler::DMATransfer:
+        DMA->handleTransfer();
+        break;
+    }
+}
+
 uint8_t Controller::elapsedCycles() const {
     return cyclesCurrentInstruction;
 }
@@ -720,45 +1239,78 @@ void Controller::handleSpeedSwitch() {
     bankController->handleSpeedSwitch();
 }
 
+void Controller::saveState(Core::SaveState::Writer &writer) const {
+    bankController->saveState(writer);
+}
+
+void Controller::loadState(Core::SaveState::Reader &reader) {
+    bankController->loadState(reader);
+    cyclesCurrentInstruction = 0;
+}
+
+void Controller::validateState(Core::SaveState::Reader &reader) const {
+    bankController->validateState(reader);
+}
+
+void Controller::copyState(const Controller &other) {
+    bankController->copyState(*other.bankController);
+    cyclesCurrentInstruction = 0;
+}
+
 void Controller::initialize(bool skipBootROM) {
     bootROM->initialize(skipBootROM, cartridge->cgbFlag());
     if (!cartridge->isOpen()) {
         if (!bootROM->hasBootROM()) {
             logger.logError("No cartridge or BOOT ROM detected, nothing to execute.");
         }
-        bankController = std::make_unique<ROM::Controller>(logger.logLevel(), cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA);
+        createBankController();
         logger.logWarning("ROM file not open, unable to initialize memory.");
         return;
     }
+    createBankController();
+    bankController->loadExternalRAMFromSaveFile();
+}
+
+// Shares the guest memory of a controller for the same cartridge, without
+// touching the save file
+void Controller::shareMemory(Controller &other) {
+    createBankController();
+    bankController->shareMemory(*other.bankController);
+}
+
+void Controller::createBankController() {
+    if (!cartridge->isOpen()) {
+        bankController = std::make_unique<ROM::Controller>(logger.logLevel(), cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA);
+        return;
+    }
     Core::ROM::Type cartridgeType = cartridge->type();
     switch (cartridgeType) {
     case Core::ROM::ROM:
-        bankController = std::make_unique<ROM::Controller>(logger.logLevel(), cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA);
+        bankController = std::make_unique<ROM::Controller>(logger.logLevel(), cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA);
         break;
     case Core::ROM::MBC1:
     case Core::ROM::MBC1_RAM:
     case Core::ROM::MBC1_RAM_BATTERY:
-        bankController = std::make_unique<MBC1::Controller>(logger.logLevel(), cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA);
+        bankController = std::make_unique<MBC1::Controller>(logger.logLevel(), cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA);
         break;
     case Core::ROM::MBC3:
     case Core::ROM::MBC3_RAM:
     case Core::ROM::MBC3_RAM_BATTERY:
-        bankController = std::make_unique<MBC3::Controller>(logger.logLevel(), cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA, false);
+        bankController = std::make_unique<MBC3::Controller>(logger.logLevel(), cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA, false);
         break;
     case Core::ROM::MBC3_TIMER_BATTERY:
     case Core::ROM::MBC3_TIMER_RAM_BATTERY:
-        bankController = std::make_unique<MBC3::Controller>(logger.logLevel(), cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA, true);
+        bankController = std::make_unique<MBC3::Controller>(logger.logLevel(), cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA, true);
         break;
     case Core::ROM::MBC5:
     case Core::ROM::MBC5_RAM:
     case Core::ROM::MBC5_RAM_BATTERY:
-        bankController = std::make_unique<MBC5::Controller>(logger.logLevel(), cartridge, bootROM, PPU, sound, interrupt, timer, joypad, DMA);
+        bankController = std::make_unique<MBC5::Controller>(logger.logLevel(), cartridge, bootROM, serialCommController, PPU, sound, interrupt, timer, joypad, DMA);
         break;
     default:
         logger.logError("Unhandled cartridge type: %02x", cartridgeType);
         break;
     }
-    bankController->loadExternalRAMFromSaveFile();
 }
 
 bool Controller::hasBootROM() const {
@@ -773,7 +1325,7 @@ uint8_t Controller::load(uint16_t address, bool shouldStep, bool hasPriority) {
     if (shouldStep) {
         step(4);
     }
-    if (bootROM->shouldHandleAddress(address, cartridge->cgbFlag())) {
+    if (bankController->isBootROMMapped() && bootROM->shouldHandleAddress(address, cartridge->cgbFlag())) {
         return bootROM->load(address);
     }
     if (DMA->isActive() && !hasPriority) {
@@ -794,7 +1346,7 @@ void Controller::store(uint16_t address, uint8_t value, bool shouldStep, bool ha
     if (shouldStep) {
         step(4);
     }
-    if (bootROM->shouldHandleAddress(address, cartridge->cgbFlag())) {
+    if (bankController->isBootROMMapped() && bootROM->shouldHandleAddress(address, cartridge->cgbFlag())) {
         return;
     }
     if (DMA->isActive() && !hasPriority) {
@@ -0,0 +1,89 @@
+#include "core/PagedBuffer.hpp"
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+
+using namespace Core::Memory;
+
+static const std::shared_ptr<Page> &zeroPage() {
+    static const std::shared_ptr<Page> page = std::make_shared<Page>();
+    return page;
+}
+
+PagedBuffer::PagedBuffer() : pages(), pageData() {
+
+}
+
+PagedBuffer::PagedBuffer(size_t length) : pages(), pageData() {
+    resize(length);
+}
+
+PagedBuffer::~PagedBuffer() {
+
+}
+
+void PagedBuffer::resize(size_t length) {
+    size_t count = (length + MemoryPageSize - 1) / MemoryPageSize;
+    pages.assign(count, zeroPage());
+    pageData.assign(count, zeroPage()->data());
+}
+
+uint8_t *PagedBuffer::writablePage(size_t index) {
+    if (isShared(index)) {
+        pages[index] = std::make_shared<Page>(*pages[index]);
+        pageData[index] = pages[index]->data();
+        return pageData[index];
+    }
+    // Orders the writes after the last reads of a buffer on another thread
+    // that released the page
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return pageData[index];
+}
+
+void PagedBuffer::read(uint8_t *destination, size_t length) const {
+    for (size_t index = 0; index < pages.size() && length > 0; index++) {
+        size_t count = std::min(length, (size_t)MemoryPageSize);
+        memcpy(destination, pageData[index], count);
+        destination += count;
+        length -= count;
+    }
+}
+
+void PagedBuffer::write(const uint8_t *source, size_t length) {
+    for (size_t index = 0; index < pages.size() && length > 0; index++) {
+        size_t count = std::min(length, (size_t)MemoryPageSize);
+        if (memcmp(pageData[index], source, count) != 0) {
+            memcpy(writablePage(index), source, count);
+        }
+        source += count;
+        length -= count;
+    }
+}
+
+void PagedBuffer::saveState(Core::SaveState::Writer &writer) const {
+    writer.write<uint32_t>(size());
+    for (uint8_t *data : pageData) {
+        writer.writeBytes(data, MemoryPageSize);
+    }
+}
+
+// Pages matching the state are left alone, so they stay shared
+void PagedBuffer::loadState(Core::SaveState::Reader &reader) {
+    if (reader.read<uint32_t>() != size()) {
+        throw std::runtime_error("Save state doesn't match the loaded cartridge");
+    }
+    Page page;
+    for (size_t index = 0; index < pages.size(); index++) {
+        reader.readBytes(page.data(), MemoryPageSize);
+        if (memcmp(pageData[index], page.data(), MemoryPageSize) != 0) {
+            memcpy(writablePage(index), page.data(), MemoryPageSize);
+        }
+    }
+}
+
+void PagedBuffer::validateState(Core::SaveState::Reader &reader) const {
+    if (reader.read<uint32_t>() != size()) {
+        throw std::runtime_error("Save state doesn't match the loaded cartridge");
+    }
+    reader.skipBytes(pages.size() * MemoryPageSize);
+}
@@ -1,12 +1,12 @@
 #include "core/ROM.hpp"
 #include <iostream>
 #include <cstring>
-#include "shinobu/Configuration.hpp"
 #include "common/Formatter.hpp"
+#include "common/System.hpp"
 
 using namespace Core::ROM;
 
-BOOT::ROM::ROM(Common::Logs::Level logLevel) : logger(logLevel, "  [BOOTROM]: "), lockRegister(), data(), initialized(false) {
+BOOT::ROM::ROM(Common::Logs::Level logLevel, std::filesystem::path DMGBootstrapROMFilePath, std::filesystem::path CGBBootstrapROMFilePath) : logger(logLevel, "  [BOOTROM]: "), lockRegister(), data(), initialized(false), DMGBootstrapROMFilePath(DMGBootstrapROMFilePath), CGBBootstrapROMFilePath(CGBBootstrapROMFilePath) {
 
 }
 
@@ -15,7 +15,6 @@ BOOT::ROM::~ROM() {
 }
 
 void BOOT::ROM::initialize(bool skip, Core::ROM::CGBFlag cgbFlag) {
-    Shinobu::Configuration::Manager *configurationManager = Shinobu::Configuration::Manager::getInstance();
     if (skip) {
         if (cgbFlag != CGBFlag::DMG) {
             logger.logError("Skipping boot ROM is not supported for CGB emulation. See README.md.");
@@ -27,13 +26,13 @@ void BOOT::ROM::initialize(bool skip, Core::ROM::CGBFlag cgbFlag) {
     std::filesystem::path bootROMFilePath;
     switch (cgbFlag) {
     case Core::ROM::CGBFlag::DMG :
-        bootROMFilePath = configurationManager->DMGBootstrapROM();
+        bootROMFilePath = DMGBootstrapROMFilePath;
         break;
     case Core::ROM::CGBFlag::DMG_CGB:
-        bootROMFilePath = configurationManager->CGBBootstrapROM();
+        bootROMFilePath = CGBBootstrapROMFilePath;
         break;
     case Core::ROM::CGBFlag::CGB:
-        bootROMFilePath = configurationManager->CGBBootstrapROM();
+        bootROMFilePath = CGBBootstrapROMFilePath;
         break;
     }
     if (!std::filesystem::exists(bootROMFilePath)) {
@@ -60,6 +59,12 @@ void BOOT::ROM::initialize(bool skip, Core::ROM::CGBFlag cgbFlag) {
     initialized = true;
 }
 
+void BOOT::ROM::share(const ROM &other) {
+    data = other.data;
+    initialized = other.initialized;
+    lockRegister = other.lockRegister;
+}
+
 uint8_t BOOT::ROM::load(uint16_t offset) const {
     return data[offset];
 }
@@ -124,9 +129,10 @@ void Cartridge::open(std::filesystem::path &filePath) {
     file.seekg(HEADER_START_ADDRESS, file.beg);
     file.read(reinterpret_cast<char *>(&header), sizeof(Header));
 
-    memory.resize(fileSize);
+    std::shared_ptr<std::vector<uint8_t>> contents = std::make_shared<std::vector<uint8_t>>(fileSize);
     file.seekg(0, file.beg);
-    file.read(reinterpret_cast<char *>(&memory[0]), fileSize);
+    file.read(reinterpret_cast<char *>(contents->data()), fileSize);
+    memory = contents;
 
     logger.logMessage("ROM header information: ");
     logger.logMessage("Cartridge type: %x", header.cartridgeType);
@@ -136,8 +142,14 @@ void Cartridge::open(std::filesystem::path &filePath) {
     file.close();
 }
 
+void Cartridge::share(const Cartridge &other) {
+    filePath = other.filePath;
+    memory = other.memory;
+    header = other.header;
+}
+
 bool Cartridge::isOpen() const {
-    return !memory.empty();
+    return memory && !memory->empty();
 }
 
 bool Cartridge::hasBattery() const {
@@ -187,12 +199,23 @@ std::filesystem::path Cartridge::disassemblyFilePath() const {
     return std::filesystem::path(filePath).replace_extension(".asm");
 }
 
+std::filesystem::path Cartridge::saveStateFilePath() const {
+    return std::filesystem::path(filePath).replace_extension(".state");
+}
+
 uint8_t Cartridge::load(uint32_t address) const {
-    if (address > memory.size()) {
+    if (address > ROMSize()) {
         logger.logWarning("ROM load out of bounds with address: %04x", address);
         return 0xFF;
     }
-    return memory[address];
+    return (*memory)[address];
+}
+
+const uint8_t *Cartridge::pageAt(uint32_t address) const {
+    if (address + MemoryPageSize > ROMSize()) {
+        return nullptr;
+    }
+    return memory->data() + address;
 }
 
 uint32_t Cartridge::RAMSize() const {
@@ -218,7 +241,7 @@ uint32_t Cartridge::RAMSize() const {
 }
 
 uint32_t Cartridge::ROMSize() const {
-    return memory.size();
+    return memory ? memory->size() : 0;
 }
 
 Type Cartridge::type() const {
@@ -232,3 +255,19 @@ CGBFlag Cartridge::cgbFlag() const {
     }
     return flag;
 }
+
+const Header &Cartridge::getHeader() const {
+    return header;
+}
+
+void BOOT::ROM::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(lockRegister);
+}
+
+void BOOT::ROM::loadState(Core::SaveState::Reader &reader) {
+    reader.read(lockRegister);
+}
+
+void BOOT::ROM::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(lockRegister));
+}
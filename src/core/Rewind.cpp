@@ -0,0 +1,96 @@
+#include "core/Rewind.hpp"
+#include <algorithm>
+#include "common/Delta.hpp"
+
+using namespace Core::Rewind;
+
+Buffer::Buffer(Common::Logs::Level logLevel, uint32_t interval, size_t capacity) : logger(logLevel, "  [Rewind]: "), interval(interval), capacity(capacity), frames(), current(), captured(), encoded(), snapshots(), memoryUsage() {
+
+}
+
+Buffer::~Buffer() {
+
+}
+
+void Buffer::frame(Core::Machine::Machine &machine) {
+    if (interval == 0) {
+        return;
+    }
+    frames++;
+    if (frames < interval) {
+        return;
+    }
+    frames = 0;
+    capture(machine);
+}
+
+void Buffer::capture(Core::Machine::Machine &machine) {
+    machine.saveState(captured);
+    if (current.empty()) {
+        current.swap(captured);
+        memoryUsage = current.size();
+        return;
+    }
+    // States only change size with pending DMA requests and scheduler events,
+    // the shorter one is zero padded for the delta
+    uint32_t previousSize = current.size();
+    uint32_t capturedSize = captured.size();
+    size_t length = std::max(previousSize, capturedSize);
+    current.resize(length);
+    captured.resize(length);
+    Common::Delta::encode(current.data(), captured.data(), length, encoded);
+    snapshots.push_back({ std::vector<uint8_t>(encoded.begin(), encoded.end()), previousSize });
+    memoryUsage += encoded.size();
+    current.swap(captured);
+    current.resize(capturedSize);
+    memoryUsage += capturedSize;
+    memoryUsage -= previousSize;
+    while (memoryUsage > capacity && !snapshots.empty()) {
+        memoryUsage -= snapshots.front().delta.size();
+        snapshots.pop_front();
+    }
+}
+
+bool Buffer::rewind(Core::Machine::Machine &machine) {
+    if (current.empty()) {
+        return false;
+    }
+    frames = 0;
+    if (!machine.loadState(current)) {
+        logger.logWarning("Unable to restore snapshot, discarding rewind buffer");
+        clear();
+        return false;
+    }
+    if (snapshots.empty()) {
+        clear();
+        return true;
+    }
+    Snapshot &snapshot = snapshots.back();
+    memoryUsage -= current.size();
+    current.resize(std::max((uint32_t)current.size(), snapshot.size));
+    if (!Common::Delta::apply(snapshot.delta, current.data(), current.size())) {
+        logger.logWarning("Corrupted snapshot delta, discarding rewind buffer");
+        clear();
+        return true;
+    }
+    current.resize(snapshot.size);
+    memoryUsage += current.size();
+    memoryUsage -= snapshot.delta.size();
+    snapshots.pop_back();
+    return true;
+}
+
+void Buffer::clear() {
+    frames = 0;
+    current.clear();
+    snapshots.clear();
+    memoryUsage = 0;
+}
+
+size_t Buffer::size() const {
+    return current.empty() ? 0 : snapshots.size() + 1;
+}
+
+size_t Buffer::usedMemory() const {
+    return memoryUsage;
+}
@@ -0,0 +1,71 @@
+#include "core/Scheduler.hpp"
+#include <algorithm>
+
+using namespace Core::Scheduler;
+
+static bool isLater(const Event &lhs, const Event &rhs) {
+    return lhs.timestamp > rhs.timestamp;
+}
+
+Scheduler::Scheduler(Common::Logs::Level logLevel) : logger(logLevel, "  [Scheduler]: "), timestamp(), events() {
+
+}
+
+Scheduler::~Scheduler() {
+
+}
+
+Event Scheduler::popEvent() {
+    std::pop_heap(events.begin(), events.end(), isLater);
+    Event event = events.back();
+    events.pop_back();
+    return event;
+}
+
+void Scheduler::schedule(EventType type, uint64_t eventTimestamp) {
+    cancel(type);
+    events.push_back({ eventTimestamp, type });
+    std::push_heap(events.begin(), events.end(), isLater);
+}
+
+void Scheduler::cancel(EventType type) {
+    auto iterator = std::find_if(events.begin(), events.end(), [type](const Event &event) {
+        return event.type == type;
+    });
+    if (iterator == events.end()) {
+        return;
+    }
+    events.erase(iterator);
+    std::make_heap(events.begin(), events.end(), isLater);
+}
+
+// Events are written field by field so padding never ends up in the state,
+// they're restored in their heap order
+void Scheduler::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(timestamp);
+    writer.write<uint32_t>(events.size());
+    for (const Event &event : events) {
+        writer.write(event.timestamp);
+        writer.write(event.type);
+    }
+}
+
+void Scheduler::loadState(Core::SaveState::Reader &reader) {
+    reader.read(timestamp);
+    events.resize(reader.readCount(sizeof(Event::timestamp) + sizeof(Event::type)));
+    for (Event &event : events) {
+        reader.read(event.timestamp);
+        reader.read(event.type);
+    }
+}
+
+void Scheduler::validateState(Core::SaveState::Reader &reader) const {
+    size_t eventSize = sizeof(Event::timestamp) + sizeof(Event::type);
+    reader.skipBytes(sizeof(timestamp));
+    reader.skipBytes(reader.readCount(eventSize) * eventSize);
+}
+
+void Scheduler::copyState(const Scheduler &other) {
+    timestamp = other.timestamp;
+    events = other.events;
+}
@@ -5,7 +5,32 @@
 
 using namespace Core::CPU;
 
-Processor::Processor(Common::Logs::Level logLevel, std::unique_ptr<Memory::Controller> &memory, std::unique_ptr<Device::Interrupt::Controller> &interrupt) : logger(logLevel, "  [CPU]: "), registers(), memory(memory), interruptController(interrupt), shouldSetIME(false), halted(false) {
+static const Instructions::DecodedInstruction HaltedInstruction = { Instructions::HALTED<void>, Instructions::Instruction(0x76, false), 0x0 };
+// Copy-on-write pages leave entries behind at addresses that are never
+// executed again, the cache starts over once it grows past this
+static const size_t MaximumCachedBlocks = 4096;
+
+static bool endsBlock(Instructions::Instruction instruction) {
+    if (instruction.isPrefixed) {
+        return false;
+    }
+    switch (instruction.code._value) {
+    case 0x10: // STOP
+    case 0x18: // JR i8
+    case 0x76: // HALT
+    case 0xC3: // JP u16
+    case 0xC9: // RET
+    case 0xCD: // CALL u16
+    case 0xD9: // RETI
+    case 0xE9: // JP HL
+        return true;
+    default:
+        // RST n
+        return instruction.code.x == 3 && instruction.code.z == 7;
+    }
+}
+
+Processor::Processor(Common::Logs::Level logLevel, std::unique_ptr<Memory::Controller> &memory, std::unique_ptr<Device::Interrupt::Controller> &interrupt) : logger(logLevel, "  [CPU]: "), registers(), memory(memory), interruptController(interrupt), shouldSetIME(false), halted(false), result(Core::TestResult::Running), blocks(), currentBlock(), currentBlockIndex(), uncachedInstruction() {
 }
 
 Processor::~Processor() {
@@ -45,46 +70,76 @@ std::string Processor::disassembleArithmetic(Instructions::Instruction instructi
     }
 }
 
-uint8_t Processor::executeArithmetic(Instructions::Instruction instruction, std::function<std::tuple<uint8_t, Flag>(uint8_t,uint8_t)> operation, bool useAccumulator) {
-    advanceProgramCounter(instruction);
-    if (instruction.code.x == 2) {
-        uint8_t R = Instructions::RTable[instruction.code.z];
-        if (R != 0xFF) {
-            uint8_t RValue = registers._value8[R];
-            uint8_t result;
-            Flag flags;
-            std::tie(result, flags) = operation(registers.a, RValue);
-            if (useAccumulator) {
-                registers.a = result;
+// A freed page can be reallocated for a different physical page, the
+// version pointer tells them apart
+Block &Processor::findBlock(Memory::MemoryPage page, uint8_t offset) {
+    auto cached = blocks.find(page.data + offset);
+    if (cached != blocks.end()) {
+        Block &block = cached->second;
+        if (block.version != page.version || !block.isValid()) {
+            decodeBlock(block, page, offset);
+        }
+        return block;
+    }
+    if (blocks.size() >= MaximumCachedBlocks) {
+        blocks.clear();
+    }
+    Block &block = blocks[page.data + offset];
+    decodeBlock(block, page, offset);
+    return block;
+}
+
+void Processor::decodeBlock(Block &block, Memory::MemoryPage page, uint8_t offset) const {
+    block.page = page.data;
+    block.version = page.version;
+    block.decodedVersion = page.version != nullptr ? *page.version : 0;
+    block.instructions.clear();
+    uint16_t position = offset;
+    while (position < MemoryPageSize) {
+        Instructions::Instruction instruction = Instructions::Instruction(page.data[position], false);
+        Instructions::InstructionHandler<void> handler;
+        uint8_t length;
+        if (instruction.code._value == Instructions::InstructionPrefix) {
+            // The prefixed opcode has to be fetched from the same page
+            if ((position + 1) >= MemoryPageSize) {
+                break;
             }
-            registers.flag = flags;
+            instruction = Instructions::Instruction(page.data[position + 1], true);
+            handler = Instructions::PrefixedInstructionHandlerTable<void>[instruction.code._value];
+            length = 2;
         } else {
-            uint8_t HLValue = memory->load(registers.hl);
-            uint8_t result;
-            Flag flags;
-            std::tie(result, flags) = operation(registers.a, HLValue);
-            if (useAccumulator) {
-                registers.a = result;
-            }
-            registers.flag = flags;
+            handler = Instructions::InstructionHandlerTable<void>[instruction.code._value];
+            length = Instructions::InstructionSizeTable[instruction.code._value];
+        }
+        if (handler == nullptr) {
+            break;
         }
-    } else if (instruction.code.x == 3) {
-        uint8_t NValue = memory->load(registers.pc - 1); // PC is already at next instruction
-        int8_t result;
-        Flag flags;
-        std::tie(result, flags) = operation(registers.a, NValue);
-        if (useAccumulator) {
-            registers.a = result;
+        block.instructions.push_back({ handler, instruction, (uint8_t)position });
+        if (endsBlock(instruction)) {
+            break;
         }
-        registers.flag = flags;
+        position += length;
+    }
+}
+
+const Instructions::DecodedInstruction &Processor::fetchUncachedInstruction() {
+    currentBlock = nullptr;
+    uint8_t code = memory->load(registers.pc, false);
+    if (code == Instructions::InstructionPrefix) {
+        uint16_t immediateAddress = registers.pc + 1;
+        code = memory->load(immediateAddress);
+        uncachedInstruction.instruction = Instructions::Instruction(code, true);
     } else {
-        logger.logError("Invalid instruction decoding");
-        return 0;
+        uncachedInstruction.instruction = Instructions::Instruction(code, false);
     }
-    return 0;
+    uncachedInstruction.handler = decodeInstruction<void>(uncachedInstruction.instruction);
+    return uncachedInstruction;
 }
 
 void Processor::initialize() {
+    blocks.clear();
+    currentBlock = nullptr;
+    result = Core::TestResult::Running;
     if (memory->hasBootROM()) {
         registers.pc = 0x0000;
     } else {
@@ -142,6 +197,43 @@ Instructions::Instruction Processor::fetchInstruction() const {
     return Instructions::Instruction(code, false);
 }
 
+const Instructions::DecodedInstruction &Processor::fetchDecodedInstruction() {
+    memory->beginCurrentInstruction();
+    if (halted) {
+        return HaltedInstruction;
+    }
+    // Opcode fetch timing is kept, only the load and decoding are skipped
+    memory->step(4);
+    Memory::MemoryPage page = memory->instructionPage(registers.pc);
+    if (page.data == nullptr) {
+        return fetchUncachedInstruction();
+    }
+    uint8_t offset = registers.pc & 0xFF;
+    if (currentBlock == nullptr ||
+        currentBlock->page != page.data ||
+        currentBlock->version != page.version ||
+        currentBlockIndex >= currentBlock->instructions.size() ||
+        currentBlock->instructions[currentBlockIndex].offset != offset ||
+        !currentBlock->isValid()) {
+        currentBlock = &findBlock(page, offset);
+        currentBlockIndex = 0;
+        if (currentBlock->instructions.empty()) {
+            return fetchUncachedInstruction();
+        }
+    }
+    const Instructions::DecodedInstruction &decoded = currentBlock->instructions[currentBlockIndex++];
+    if (decoded.instruction.isPrefixed) {
+        memory->step(4);
+        if (memory->instructionPage(registers.pc + 1).data != page.data) {
+            currentBlock = nullptr;
+            uncachedInstruction.instruction = Instructions::Instruction(memory->load(registers.pc + 1, false), true);
+            uncachedInstruction.handler = decodeInstruction<void>(uncachedInstruction.instruction);
+            return uncachedInstruction;
+        }
+    }
+    return decoded;
+}
+
 void Processor::checkPendingInterrupts(Instructions::Instruction lastInstruction) {
     if (shouldSetIME && lastInstruction.code._value != 0xFB) {
         interruptController->IME = true;
@@ -181,17 +273,13 @@ Instructions::InstructionHandler<T> Processor::decodeInstruction(Instructions::I
     if (halted) {
         return Instructions::HALTED;
     }
-    std::vector<Instructions::InstructionHandler<T>> table;
+    Instructions::InstructionHandler<T> handler;
     if (instruction.isPrefixed) {
-        table = Instructions::PrefixedInstructionHandlerTable<T>;
+        handler = Instructions::PrefixedInstructionHandlerTable<T>[instruction.code._value];
     } else {
-        table = Instructions::InstructionHandlerTable<T>;
-    }
-    if (instruction.code._value > table.size()) {
-        logger.logError("Unhandled instruction with code: %02x, at PC: %04x", instruction.code._value, registers.pc);
+        handler = Instructions::InstructionHandlerTable<T>[instruction.code._value];
     }
-    Instructions::InstructionHandler<T> handler = table[instruction.code._value];
-    if (handler == NULL) {
+    if (handler == nullptr) {
         logger.logError("Unhandled instruction with code: %02x, at PC: %04x", instruction.code._value, registers.pc);
     }
     return handler;
@@ -199,3 +287,53 @@ Instructions::InstructionHandler<T> Processor::decodeInstruction(Instructions::I
 
 template Instructions::InstructionHandler<void> Processor::decodeInstruction<void>(Instructions::Instruction instruction) const;
 template Instructions::InstructionHandler<std::string> Processor::decodeInstruction<std::string>(Instructions::Instruction instruction) const;
+
+void Processor::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(registers);
+    writer.write(shouldSetIME);
+    writer.write(halted);
+}
+
+void Processor::loadState(Core::SaveState::Reader &reader) {
+    reader.read(registers);
+    reader.read(shouldSetIME);
+    reader.read(halted);
+    result = Core::TestResult::Running;
+    // Memory was replaced wholesale, cached blocks can't be trusted anymore
+    blocks.clear();
+    currentBlock = nullptr;
+}
+
+void Processor::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(registers) + sizeof(shouldSetIME) + sizeof(halted));
+}
+
+// The copied memory is new to this processor, so nothing is cached yet
+void Processor::copyState(const Processor &other) {
+    registers = other.registers;
+    shouldSetIME = other.shouldSetIME;
+    halted = other.halted;
+    result = other.result;
+    blocks.clear();
+    currentBlock = nullptr;
+}
+
+// Mooneye's ROMs execute LD B,B with the Fibonacci numbers 3, 5, 8, 13, 21
+// and 34 in B, C, D, E, H and L when they pass, and 0x42 in all of them
+// when they fail
+void Processor::checkTestResult() {
+    if (result != Core::TestResult::Running) {
+        return;
+    }
+    if (registers.b == 3 && registers.c == 5 && registers.d == 8 &&
+        registers.e == 13 && registers.h == 21 && registers.l == 34) {
+        result = Core::TestResult::Passed;
+    } else if (registers.b == 0x42 && registers.c == 0x42 && registers.d == 0x42 &&
+               registers.e == 0x42 && registers.h == 0x42 && registers.l == 0x42) {
+        result = Core::TestResult::Failed;
+    }
+}
+
+Core::TestResult::Result Processor::testResult() const {
+    return result;
+}
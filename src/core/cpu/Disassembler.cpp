@@ -17,7 +17,7 @@ void Disassembler::disassembleWhileExecuting(Instructions::Instruction instructi
         return;
     }
     Core::CPU::Instructions::InstructionHandler<std::string> disassemblerHandler = processor->decodeInstruction<std::string>(instruction);
-    std::string disassembledInstruction = disassemblerHandler(processor, instruction);
+    std::string disassembledInstruction = disassemblerHandler(*processor, instruction);
     logger.logDebug("A: %02X F: %02X B: %02X C: %02X D: %02X E: %02X H: %02X L: %02X SP: %04X PC: 00:%04X | %s",
         processor->registers.a,
         processor->registers.f,
@@ -39,7 +39,7 @@ std::string Disassembler::disassemble(Instructions::Instruction instruction) {
         instruction = Instructions::Instruction(0x0, false);
         disassembledInstruction = Common::Formatter::format("00:%04X | ???: %02x", processor->registers.pc, instruction.code._value);
     } else {
-        disassembledInstruction = disassemblerHandler(processor, instruction);
+        disassembledInstruction = disassemblerHandler(*processor, instruction);
     }
     std::string separator = std::string(20 - disassembledInstruction.length(), ' ');
     disassembledInstruction = Common::Formatter::format("%s%s; 00:%04X", disassembledInstruction.c_str(), separator.c_str(), processor->registers.pc);
@@ -36,7 +36,7 @@ HDMA::Request::Request(uint8_t HDMA1, uint8_t HDMA2, uint8_t HDMA3, uint8_t HDMA
     mode = _HDMA5.mode();
 }
 
-Controller::Controller(Common::Logs::Level logLevel) : logger(logLevel, "  [DMA]: "), memoryController(nullptr), requests(), HDMA1(), HDMA2(), HDMA3(), HDMA4(), _HDMA5(), currentHDMARequest(std::nullopt) {
+Controller::Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Scheduler::Scheduler> &scheduler) : logger(logLevel, "  [DMA]: "), memoryController(nullptr), scheduler(scheduler), requests(), HDMA1(), HDMA2(), HDMA3(), HDMA4(), _HDMA5(), currentHDMARequest(std::nullopt), lastSynchronization() {
 
 }
 
@@ -49,6 +49,10 @@ void Controller::setMemoryController(std::unique_ptr<Core::Memory::Controller> &
 }
 
 void Controller::execute(uint8_t value) {
+    if (requests.empty()) {
+        lastSynchronization = scheduler->currentTimestamp();
+        scheduler->schedule(Core::Scheduler::DMATransfer, lastSynchronization + 4);
+    }
     for (auto& request : requests) {
         request.canceling = true;
     }
@@ -56,8 +60,9 @@ void Controller::execute(uint8_t value) {
     requests.push_back(request);
 }
 
-void Controller::step(uint8_t cycles) {
-    uint8_t steps = cycles / 4;
+void Controller::handleTransfer() {
+    uint64_t steps = (scheduler->currentTimestamp() - lastSynchronization) / 4;
+    lastSynchronization += steps * 4;
     while (steps > 0) {
         if (requests.empty()) {
             break;
@@ -84,6 +89,9 @@ void Controller::step(uint8_t cycles) {
             request.remainingTransfers--;
         }
     }
+    if (!requests.empty()) {
+        scheduler->schedule(Core::Scheduler::DMATransfer, lastSynchronization + 4);
+    }
 }
 
 bool Controller::isActive() const {
@@ -208,3 +216,73 @@ void Controller::stepHBlank() {
 
     currentHDMARequest = { request };
 }
+
+void Controller::saveState(Core::SaveState::Writer &writer) const {
+    writer.write<uint32_t>(requests.size());
+    writer.writeBytes(requests.data(), requests.size() * sizeof(DMA::Request));
+    writer.write(HDMA1);
+    writer.write(HDMA2);
+    writer.write(HDMA3);
+    writer.write(HDMA4);
+    writer.write(_HDMA5);
+    writer.write<uint8_t>(currentHDMARequest.has_value());
+    if (currentHDMARequest) {
+        writer.write(currentHDMARequest->startSourceAddress);
+        writer.write(currentHDMARequest->startDestinationAddress);
+        writer.write(currentHDMARequest->currentSourceAddress);
+        writer.write(currentHDMARequest->currentDestinationAddress);
+        writer.write(currentHDMARequest->remainingTransfers);
+        writer.write<uint8_t>(currentHDMARequest->mode);
+        writer.write(currentHDMARequest->cancelled);
+    }
+    writer.write(lastSynchronization);
+}
+
+void Controller::loadState(Core::SaveState::Reader &reader) {
+    requests.assign(reader.readCount(sizeof(DMA::Request)), DMA::Request(0x0));
+    reader.readBytes(requests.data(), requests.size() * sizeof(DMA::Request));
+    reader.read(HDMA1);
+    reader.read(HDMA2);
+    reader.read(HDMA3);
+    reader.read(HDMA4);
+    reader.read(_HDMA5);
+    currentHDMARequest = std::nullopt;
+    if (reader.read<uint8_t>()) {
+        HDMA::Request request = HDMA::Request(0x0, 0x0, 0x0, 0x0, HDMA::HDMA5());
+        reader.read(request.startSourceAddress);
+        reader.read(request.startDestinationAddress);
+        reader.read(request.currentSourceAddress);
+        reader.read(request.currentDestinationAddress);
+        reader.read(request.remainingTransfers);
+        request.mode = HDMA::Mode(reader.read<uint8_t>());
+        reader.read(request.cancelled);
+        currentHDMARequest = request;
+    }
+    reader.read(lastSynchronization);
+}
+
+void Controller::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(reader.readCount(sizeof(DMA::Request)) * sizeof(DMA::Request));
+    reader.skipBytes(sizeof(HDMA1) + sizeof(HDMA2) + sizeof(HDMA3) + sizeof(HDMA4) + sizeof(_HDMA5));
+    if (reader.read<uint8_t>()) {
+        reader.skipBytes(sizeof(HDMA::Request::startSourceAddress) +
+                         sizeof(HDMA::Request::startDestinationAddress) +
+                         sizeof(HDMA::Request::currentSourceAddress) +
+                         sizeof(HDMA::Request::currentDestinationAddress) +
+                         sizeof(HDMA::Request::remainingTransfers) +
+                         sizeof(uint8_t) +
+                         sizeof(HDMA::Request::cancelled));
+    }
+    reader.skipBytes(sizeof(lastSynchronization));
+}
+
+void Controller::copyState(const Controller &other) {
+    requests = other.requests;
+    HDMA1 = other.HDMA1;
+    HDMA2 = other.HDMA2;
+    HDMA3 = other.HDMA3;
+    HDMA4 = other.HDMA4;
+    _HDMA5 = other._HDMA5;
+    currentHDMARequest = other.currentHDMARequest;
+    lastSynchronization = other.lastSynchronization;
+}
@@ -41,3 +41,25 @@ uint8_t Controller::loadFlag() const {
 void Controller::storeFlag(uint8_t value) {
     flag._value = value;
 }
+
+void Controller::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(IME);
+    writer.write(enable);
+    writer.write(flag);
+}
+
+void Controller::loadState(Core::SaveState::Reader &reader) {
+    reader.read(IME);
+    reader.read(enable);
+    reader.read(flag);
+}
+
+void Controller::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(IME) + sizeof(enable) + sizeof(flag));
+}
+
+void Controller::copyState(const Controller &other) {
+    IME = other.IME;
+    enable = other.enable;
+    flag = other.flag;
+}
@@ -1,14 +1,19 @@
 #include "core/device/JoypadInput.hpp"
-#include <SDL2/SDL.h>
 #include "core/device/Interrupt.hpp"
 
 using namespace Core::Device::JoypadInput;
-using namespace Shinobu::Frontend::SDL2;
 
-Controller::Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt, std::string controllerName) : logger(logLevel, "  [Joypad]: "), interrupt(interrupt), joypad(), gameController(Common::Logs::Level::Warning, controllerName) {}
+Controller::Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt) : logger(logLevel, "  [Joypad]: "), interrupt(interrupt), joypad(), inputSource(nullptr) {}
 
 Controller::~Controller() {}
 
+bool Controller::isButtonPressed(Button button) const {
+    if (inputSource == nullptr) {
+        return false;
+    }
+    return inputSource->isButtonPressed(button);
+}
+
 uint8_t Controller::load() const {
     return joypad._value;
 }
@@ -21,50 +26,50 @@ void Controller::store(uint8_t value) {
 void Controller::updateJoypad() {
     bool shouldTriggerInterrupt = false;
     if (!joypad.selectDirectionKeys && joypad.selectButtonKeys) {
-        if (gameController.isButtonPressed(Button::Right)) {
+        if (isButtonPressed(Button::Right)) {
             shouldTriggerInterrupt = !joypad.p10;
             joypad.p10 = 0x0;
         } else {
             joypad.p10 = 0x1;
         }
-        if (gameController.isButtonPressed(Button::Left)) {
+        if (isButtonPressed(Button::Left)) {
             shouldTriggerInterrupt = !joypad.p11;
             joypad.p11 = 0x0;
         } else {
             joypad.p11 = 0x1;
         }
-        if (gameController.isButtonPressed(Button::Up)) {
+        if (isButtonPressed(Button::Up)) {
             shouldTriggerInterrupt = !joypad.p12;
             joypad.p12 = 0x0;
         } else {
             joypad.p12 = 0x1;
         }
-        if (gameController.isButtonPressed(Button::Down)) {
+        if (isButtonPressed(Button::Down)) {
             shouldTriggerInterrupt = !joypad.p13;
             joypad.p13 = 0x0;
         } else {
             joypad.p13 = 0x1;
         }
     } else if (!joypad.selectButtonKeys && joypad.selectDirectionKeys) {
-        if (gameController.isButtonPressed(Button::A)) {
+        if (isButtonPressed(Button::A)) {
             shouldTriggerInterrupt = !joypad.p10;
             joypad.p10 = 0x0;
         } else {
             joypad.p10 = 0x1;
         }
-        if (gameController.isButtonPressed(Button::B)) {
+        if (isButtonPressed(Button::B)) {
             shouldTriggerInterrupt = !joypad.p11;
             joypad.p11 = 0x0;
         } else {
             joypad.p11 = 0x1;
         }
-        if (gameController.isButtonPressed(Button::Select)) {
+        if (isButtonPressed(Button::Select)) {
             shouldTriggerInterrupt = !joypad.p12;
             joypad.p12 = 0x0;
         } else {
             joypad.p12 = 0x1;
         }
-        if (gameController.isButtonPressed(Button::Start)) {
+        if (isButtonPressed(Button::Start)) {
             shouldTriggerInterrupt = !joypad.p13;
             joypad.p13 = 0x0;
         } else {
@@ -76,6 +81,22 @@ void Controller::updateJoypad() {
     }
 }
 
-bool Controller::hasGameController() const {
-    return gameController.hasGameController();
+void Controller::setInputSource(InputSource *inputSource) {
+    this->inputSource = inputSource;
+}
+
+void Controller::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(joypad);
+}
+
+void Controller::loadState(Core::SaveState::Reader &reader) {
+    reader.read(joypad);
+}
+
+void Controller::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(joypad));
+}
+
+void Controller::copyState(const Controller &other) {
+    joypad = other.joypad;
 }
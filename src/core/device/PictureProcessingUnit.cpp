@@ -1,24 +1,22 @@
 #include "core/device/PictureProcessingUnit.hpp"
 #include <iostream>
 #include "common/Timing.hpp"
-#include <bitset>
 #include "common/System.hpp"
-#include "shinobu/frontend/Renderer.hpp"
 #include <algorithm>
-#include "shinobu/frontend/Palette.hpp"
+#include "core/Palette.hpp"
 
 using namespace Core::Device::PictureProcessingUnit;
-using namespace Shinobu::Frontend::Palette;
+using namespace Core::Palette;
 
 Processor::Processor(Common::Logs::Level logLevel,
                      bool correctColors,
                      std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt,
-                     std::unique_ptr<Shinobu::Frontend::Palette::Selector> &paletteSelector,
+                     std::unique_ptr<Core::Palette::Selector> &paletteSelector,
                      std::unique_ptr<Core::Device::DirectMemoryAccess::Controller> &DMAController) : logger(logLevel, "  [PPU]: "),
                                                                                                      interrupt(interrupt),
                                                                                                      paletteSelector(paletteSelector),
                                                                                                      DMAController(DMAController),
-                                                                                                     memory(),
+                                                                                                     memory(0x4000),
                                                                                                      spriteAttributeTable(),
                                                                                                      control(),
                                                                                                      status(),
@@ -34,8 +32,10 @@ Processor::Processor(Common::Logs::Level logLevel,
                                                                                                      windowLineCounter(),
                                                                                                      windowYPositionTrigger(),
                                                                                                      steps(),
+                                                                                                     nextModeUpdateSteps(),
                                                                                                      interruptConditions(),
                                                                                                      renderer(nullptr),
+                                                                                                     lcd(),
                                                                                                      lcdData(),
                                                                                                      memoryController(nullptr),
                                                                                                      DMA(),
@@ -46,16 +46,31 @@ Processor::Processor(Common::Logs::Level logLevel,
                                                                                                      _BGPI(),
                                                                                                      objectPaletteData(),
                                                                                                      _OBPI(),
-                                                                                                     correctColors(correctColors) {
-                                                                                                         lcdData.resize(HorizontalResolution * VerticalResolution * 3);
+                                                                                                     correctColors(correctColors),
+                                                                                                     backgroundScanline(),
+                                                                                                     backgroundTileRows(),
+                                                                                                     tileRowDecoder(TileRow::selectDecoder()),
+                                                                                                     spriteScanline(),
+                                                                                                     spriteLine() {
 }
 
 Processor::~Processor() {
 
 }
 
-void Processor::setRenderer(Shinobu::Frontend::Renderer *renderer) {
+void Processor::setRenderer(Renderer *renderer) {
     this->renderer = renderer;
+    if (renderer != nullptr) {
+        allocateLCD();
+    }
+}
+
+void Processor::allocateLCD() {
+    if (lcd) {
+        return;
+    }
+    lcd = std::make_unique<LCDOutput>();
+    lcd->colorIndices.fill(BlackColorIndex);
 }
 
 void Processor::setMemoryController(std::unique_ptr<Core::Memory::Controller> &memoryController) {
@@ -66,6 +81,10 @@ void Processor::setCGBFlag(Core::ROM::CGBFlag cgbFlag) {
     this->cgbFlag = cgbFlag;
 }
 
+void Processor::shareMemory(const Processor &other) {
+    memory = other.memory;
+}
+
 uint8_t Processor::load(uint16_t offset) const {
     switch (offset) {
     case 0x0:
@@ -99,6 +118,8 @@ uint8_t Processor::load(uint16_t offset) const {
 }
 
 void Processor::store(uint16_t offset, uint8_t value) {
+    // Register writes can change the mode, coincidence or STAT conditions
+    nextModeUpdateSteps = 0;
     switch (offset) {
     case 0x0: {
         uint8_t previousLCDState = control.LCDDisplayEnable;
@@ -120,11 +141,11 @@ void Processor::store(uint16_t offset, uint8_t value) {
         return;
     }
     case 0x2:
-        logger.logMessage("SCY write with value: %02x", value);
+        logger.logTrace("SCY write with value: %02x", value);
         scrollY = value;
         return;
     case 0x3:
-        logger.logMessage("SCX write with value: %02x", value);
+        logger.logTrace("SCX write with value: %02x", value);
         scrollX = value;
         return;
     case 0x4:
@@ -147,11 +168,11 @@ void Processor::store(uint16_t offset, uint8_t value) {
         object1Palette._value = value;
         return;
     case 0xA:
-        logger.logMessage("WY write with value: %02x", value);
+        logger.logTrace("WY write with value: %02x", value);
         windowYPosition = value;
         return;
     case 0xB:
-        logger.logMessage("WX write with value: %02x", value);
+        logger.logTrace("WX write with value: %02x", value);
         windowXPosition._value = value;
         return;
     default:
@@ -160,16 +181,14 @@ void Processor::store(uint16_t offset, uint8_t value) {
     }
 }
 
-void Processor::step(uint8_t cycles) {
-    if (!control.LCDDisplayEnable) {
-        return;
-    }
-    steps += cycles;
+void Processor::updateMode() {
+    // Cycles stepped from here on (e.g. by HBlank DMA) are evaluated one by one
+    nextModeUpdateSteps = 0;
     bool areAnyConditionsMet = interruptConditions != LCDCSTATInterruptCondition::None;
 
     if (LY < 144) {
         if (steps <= 80) {
-            logger.logMessage("PPU in OAM (Mode 2)");
+            logger.logTrace("PPU in OAM (Mode 2)");
             status.setMode(SearchingOAM);
             if (status.mode2InterruptEnable) {
                 interruptConditions |= LCDCSTATInterruptCondition::Mode2;
@@ -177,7 +196,7 @@ void Processor::step(uint8_t cycles) {
                 interruptConditions &= ~LCDCSTATInterruptCondition::Mode2;
             }
         } else if (steps <= 289) {
-            logger.logMessage("PPU in Transfering data (Mode 3)");
+            logger.logTrace("PPU in Transfering data (Mode 3)");
             status.setMode(TransferingData);
         } else {
             // TODO: Fix this, it's awful!
@@ -188,11 +207,11 @@ void Processor::step(uint8_t cycles) {
                 // this is awful but until we have a pixel FIFO this is fixing
                 // the Oracle games windows so YOLO
                 if (LY <= 143) {
-                    logger.logMessage("Rendering scanline: %d", LY);
+                    logger.logTrace("Rendering scanline: %d", LY);
                     renderScanline();
                 }
             }
-            logger.logMessage("PPU in HBlank (Mode 0)");
+            logger.logTrace("PPU in HBlank (Mode 0)");
             status.setMode(HBlank);
             if (status.mode0InterruptEnable) {
                 status.mode0InterruptEnable |= LCDCSTATInterruptCondition::Mode0;
@@ -201,7 +220,7 @@ void Processor::step(uint8_t cycles) {
             }
         }
     } else {
-        logger.logMessage("PPU in VBlank (Mode 1)");
+        logger.logTrace("PPU in VBlank (Mode 1)");
         status.setMode(VBlank);
         if (status.mode1InterruptEnable) {
             interruptConditions |= LCDCSTATInterruptCondition::Mode1;
@@ -221,8 +240,12 @@ void Processor::step(uint8_t cycles) {
         LY++;
         if (LY == 144) {
             interrupt->requestInterrupt(Interrupt::VBLANK);
-            renderer->update();
-            std::fill_n(lcdData.begin(), HorizontalResolution * VerticalResolution * 3, 0.0f);
+            if (renderer != nullptr) {
+                renderer->update();
+            }
+            if (lcd) {
+                lcd->colorIndices.fill(BlackColorIndex);
+            }
             windowLineCounter = 0;
             windowYPositionTrigger = false;
         }
@@ -230,6 +253,16 @@ void Processor::step(uint8_t cycles) {
             LY = 0;
         }
         steps %= CyclesPerScanline;
+        // The new scanline has to update its mode and coincidence right away
+        nextModeUpdateSteps = 0;
+    } else if (LY >= 144) {
+        nextModeUpdateSteps = CyclesPerScanline;
+    } else if (steps <= 80) {
+        nextModeUpdateSteps = 81;
+    } else if (steps <= 289) {
+        nextModeUpdateSteps = 290;
+    } else {
+        nextModeUpdateSteps = CyclesPerScanline;
     }
 
     if (!areAnyConditionsMet && (interruptConditions != LCDCSTATInterruptCondition::None)) {
@@ -251,7 +284,7 @@ void Processor::VRAMStore(uint16_t offset, uint8_t value) {
         logger.logWarning("Attempting to store to VRAM while inaccessible with mode: %02x at offset: %04x with value: %02x", status.mode(), offset, value);
         return;
     }
-    memory[offset] = value;
+    memory.store(offset, value);
 }
 
 uint8_t Processor::OAMLoad(uint16_t offset) const {
@@ -340,7 +373,7 @@ void Processor::colorPaletteStore(uint16_t offset, uint8_t value) {
     }
 }
 
-uint8_t Processor::getColorIndexForSpriteAtScreenHorizontalPosition(Sprite sprite, uint16_t screenPositionX) const {
+std::array<uint8_t, 8> Processor::getSpriteRowColorIndices(const Sprite &sprite) const {
     SpriteSize spriteSize = control.spriteSize();
     uint8_t spriteHeight = spriteSize == SpriteSize::_8x16 ? 16 : 8;
     uint16_t tileIndex = sprite.tileNumber;
@@ -363,58 +396,31 @@ uint8_t Processor::getColorIndexForSpriteAtScreenHorizontalPosition(Sprite sprit
     }
     uint8_t low = memory[lowAddress];
     uint8_t high = memory[highAddress];
-    auto colorData = getTileRowPixelsColorIndicesWithData(low, high);
-    uint8_t colorDataIndex = screenPositionX - sprite.positionX();
     if (sprite.attributes.xFlip) {
-        colorDataIndex = 7 - colorDataIndex;
+        low = TileRow::ReversedBitsTable[low];
+        high = TileRow::ReversedBitsTable[high];
     }
-    uint8_t colorIndex = colorData[colorDataIndex];
-    return colorIndex;
+    return getTileRowPixelsColorIndicesWithData(low, high);
 }
 
-std::pair<uint8_t, BackgroundMapAttributes> Processor::getColorIndexForBackgroundAtScreenHorizontalPosition(uint16_t screenPositionX) const {
-    Background_WindowTileMapLocation backgroundMapLocation = control.backgroundTileMapDisplaySelect();
-    uint32_t backgroundMapAddressStart;
-    switch (backgroundMapLocation) {
-    case _9800_9BFF:
-        backgroundMapAddressStart = 0x9800 - 0x8000;
-        break;
-    case _9C00_9FFF:
-        backgroundMapAddressStart = 0x9C00 - 0x8000;
-        break;
-    }
-    Background_WindowTileMapLocation windowMapLocation = control.windowTileMapDisplaySelect();
-    uint32_t windowMapAddressStart;
-    switch (windowMapLocation) {
+uint16_t Processor::tileMapAddressStart(Background_WindowTileMapLocation location) const {
+    switch (location) {
     case _9800_9BFF:
-        windowMapAddressStart = 0x9800 - 0x8000;
-        break;
+        return 0x9800 - 0x8000;
     case _9C00_9FFF:
-        windowMapAddressStart = 0x9C00 - 0x8000;
-        break;
+        return 0x9C00 - 0x8000;
     }
-    bool drawWindow = false;
-    Background_WindowTileDataLocation tileDataLocation = control.background_WindowTileDataSelect();
-    uint16_t screenPositionXWithScroll = (screenPositionX + scrollX) % TileMapResolution;
-    uint16_t screenPositionYWithScroll = (LY + scrollY) % TileMapResolution;
-    uint16_t tileIndexInMap = (screenPositionXWithScroll / VRAMTileDataSide) + (screenPositionYWithScroll / VRAMTileDataSide) * VRAMTileBackgroundMapSide;
-    uint32_t addressStart = backgroundMapAddressStart;
-    uint8_t currentWindowY = windowLineCounter;
-    if (control.windowDisplayEnable) {
-        if (windowYPositionTrigger && screenPositionX >= windowXPosition.position()) {
-            addressStart = windowMapAddressStart;
-            tileIndexInMap = ((screenPositionX - windowXPosition.position()) / VRAMTileDataSide) + (currentWindowY / VRAMTileDataSide) * VRAMTileBackgroundMapSide;
-            drawWindow = true;
-        }
-    }
-    uint16_t tileIndex;
-    uint16_t addressInBackgroundMap = addressStart + tileIndexInMap;
+    return 0x9800 - 0x8000;
+}
+
+void Processor::fetchTileRow(uint16_t addressInBackgroundMap, uint8_t yInTile, uint8_t firstPixel, uint8_t length, BackgroundTileRows &tileRows) const {
     BackgroundMapAttributes attributes;
     if (cgbFlag != Core::ROM::CGBFlag::DMG) {
         uint16_t addressInBackgroundMapAttributes = (0x1 << 13) | (addressInBackgroundMap & 0x1FFF);
         attributes = BackgroundMapAttributes(memory[addressInBackgroundMapAttributes]);
     }
-    if (tileDataLocation == _8000_8FFF) {
+    uint16_t tileIndex;
+    if (control.background_WindowTileDataSelect() == _8000_8FFF) {
         uint8_t indexOffset = memory[addressInBackgroundMap];
         tileIndex = indexOffset;
     } else {
@@ -422,12 +428,6 @@ std::pair<uint8_t, BackgroundMapAttributes> Processor::getColorIndexForBackgroun
         tileIndex = 256 + indexOffset;
     }
     uint16_t offset = (0x10 * tileIndex);
-    uint16_t yInTile;
-    if (drawWindow) {
-        yInTile = currentWindowY % VRAMTileDataSide;
-    } else {
-        yInTile = screenPositionYWithScroll % VRAMTileDataSide;
-    }
     if (cgbFlag != Core::ROM::CGBFlag::DMG && attributes.yFlip) {
         yInTile = (VRAMTileDataSide - 1) - yInTile;
     }
@@ -439,36 +439,96 @@ std::pair<uint8_t, BackgroundMapAttributes> Processor::getColorIndexForBackgroun
     }
     uint8_t low = memory[lowAddress];
     uint8_t high = memory[highAddress];
-    auto colorData = getTileRowPixelsColorIndicesWithData(low, high);
-    uint8_t colorDataIndex;
-    if (drawWindow) {
-        colorDataIndex = (screenPositionX - windowXPosition.position()) % VRAMTileDataSide;
-    } else {
-        colorDataIndex = screenPositionXWithScroll % VRAMTileDataSide;
-    }
+    // Flipping the bit planes up front lets every row go through the same decoder
     if (cgbFlag != Core::ROM::CGBFlag::DMG && attributes.xFlip) {
-        colorDataIndex = (VRAMTileDataSide - 1) - colorDataIndex;
+        low = TileRow::ReversedBitsTable[low];
+        high = TileRow::ReversedBitsTable[high];
     }
-    return {colorData[colorDataIndex], attributes};
+    uint8_t index = tileRows.count++;
+    tileRows.lower[index] = low;
+    tileRows.upper[index] = high;
+    tileRows.firstPixel[index] = firstPixel;
+    tileRows.length[index] = length;
+    tileRows.attributes[index] = attributes;
 }
 
-std::vector<GLfloat> Processor::blankLCDData() const {
-    std::vector<GLfloat> blankLCDData = {};
-    blankLCDData.resize(HorizontalResolution * VerticalResolution * 3);
-    Shinobu::Frontend::OpenGL::Color blankColor = paletteSelector->currentSelection()[0];
-    for (int j = 0; j < 144; j++) {
-        std::vector<Shinobu::Frontend::OpenGL::Vertex> scanline = {};
-        for (int i = 0; i < HorizontalResolution; i++) {
-            Shinobu::Frontend::OpenGL::Color color = blankColor;
-            blankLCDData[i * 3 + 0 + j * HorizontalResolution * 3] = color.r;
-            blankLCDData[i * 3 + 1 + j * HorizontalResolution * 3] = color.g;
-            blankLCDData[i * 3 + 2 + j * HorizontalResolution * 3] = color.b;
+void Processor::fetchBackgroundScanline(BackgroundScanline &scanline, BackgroundTileRows &tileRows) const {
+    uint16_t windowStart = HorizontalResolution;
+    if (control.windowDisplayEnable && windowYPositionTrigger) {
+        windowStart = std::min<uint16_t>(windowXPosition.position(), HorizontalResolution);
+    }
+    // Every tile row is fetched once and emits up to 8 pixels
+    tileRows.count = 0;
+    uint16_t backgroundMapAddressStart = tileMapAddressStart(control.backgroundTileMapDisplaySelect());
+    uint16_t screenPositionYWithScroll = (LY + scrollY) % TileMapResolution;
+    uint16_t screenPositionX = 0;
+    while (screenPositionX < windowStart) {
+        uint16_t screenPositionXWithScroll = (screenPositionX + scrollX) % TileMapResolution;
+        uint16_t tileIndexInMap = (screenPositionXWithScroll / VRAMTileDataSide) + (screenPositionYWithScroll / VRAMTileDataSide) * VRAMTileBackgroundMapSide;
+        uint8_t firstPixel = screenPositionXWithScroll % VRAMTileDataSide;
+        uint8_t length = std::min<uint16_t>(VRAMTileDataSide - firstPixel, windowStart - screenPositionX);
+        fetchTileRow(backgroundMapAddressStart + tileIndexInMap, screenPositionYWithScroll % VRAMTileDataSide, firstPixel, length, tileRows);
+        screenPositionX += length;
+    }
+    uint16_t windowMapAddressStart = tileMapAddressStart(control.windowTileMapDisplaySelect());
+    uint8_t currentWindowY = windowLineCounter;
+    while (screenPositionX < HorizontalResolution) {
+        uint16_t windowPositionX = screenPositionX - windowXPosition.position();
+        uint16_t tileIndexInMap = (windowPositionX / VRAMTileDataSide) + (currentWindowY / VRAMTileDataSide) * VRAMTileBackgroundMapSide;
+        uint8_t firstPixel = windowPositionX % VRAMTileDataSide;
+        uint8_t length = std::min<uint16_t>(VRAMTileDataSide - firstPixel, HorizontalResolution - screenPositionX);
+        fetchTileRow(windowMapAddressStart + tileIndexInMap, currentWindowY % VRAMTileDataSide, firstPixel, length, tileRows);
+        screenPositionX += length;
+    }
+    tileRowDecoder(tileRows.lower.data(), tileRows.upper.data(), tileRows.count, tileRows.colorIndices.data());
+    screenPositionX = 0;
+    for (uint8_t i = 0; i < tileRows.count; i++) {
+        uint8_t length = tileRows.length[i];
+        const uint8_t *colorIndices = tileRows.colorIndices.data() + i * VRAMTileDataSide + tileRows.firstPixel[i];
+        std::copy(colorIndices, colorIndices + length, scanline.colorIndices.begin() + screenPositionX);
+        std::fill_n(scanline.attributes.begin() + screenPositionX, length, tileRows.attributes[i]);
+        screenPositionX += length;
+    }
+}
+
+void Processor::captureLinePalette() {
+    LinePalette &linePalette = lcd->linePalettes[LY];
+    if (cgbFlag != Core::ROM::CGBFlag::DMG) {
+        for (uint8_t i = 0; i < ObjectPaletteEntriesStart; i++) {
+            linePalette[i] = PaletteData(backgroundPaletteData[i * 2], backgroundPaletteData[i * 2 + 1])._value;
+            linePalette[ObjectPaletteEntriesStart + i] = PaletteData(objectPaletteData[i * 2], objectPaletteData[i * 2 + 1])._value;
         }
+        return;
+    }
+    linePalette[0] = backgroundPalette.color0;
+    linePalette[1] = backgroundPalette.color1;
+    linePalette[2] = backgroundPalette.color2;
+    linePalette[3] = backgroundPalette.color3;
+    linePalette[4] = object0Palette.color0;
+    linePalette[5] = object0Palette.color1;
+    linePalette[6] = object0Palette.color2;
+    linePalette[7] = object0Palette.color3;
+    linePalette[8] = object1Palette.color0;
+    linePalette[9] = object1Palette.color1;
+    linePalette[10] = object1Palette.color2;
+    linePalette[11] = object1Palette.color3;
+}
+
+Core::Palette::Color Processor::cgbColorForPaletteData(PaletteData paletteData) const {
+    if (correctColors) {
+        // Taken from: https://byuu.net/video/color-emulation/
+        int r = (paletteData.red * 26 + paletteData.green *  4 + paletteData.blue *  2);
+        int g = (                       paletteData.green * 24 + paletteData.blue *  8);
+        int b = (paletteData.red *  6 + paletteData.green *  4 + paletteData.blue * 22);
+        r = std::min(960, r) >> 2;
+        g = std::min(960, g) >> 2;
+        b = std::min(960, b) >> 2;
+        return { (float)r / 256.0f, (float)g / 256.0f, (float)b / 256.0f };
     }
-    return blankLCDData;
+    return { paletteData.red / 32.0f, paletteData.green / 32.0f, paletteData.blue / 32.0f };
 }
 
-Shinobu::Frontend::Palette::palette Processor::cgbPaletteAtIndex(uint8_t index, bool isBackground) const {
+Core::Palette::palette Processor::cgbPaletteAtIndex(uint8_t index, bool isBackground) const {
     palette palette = {};
     uint16_t offset = index * 8;
     std::array<uint8_t, 64UL> paletteDataSource = backgroundPaletteData;
@@ -478,25 +538,22 @@ Shinobu::Frontend::Palette::palette Processor::cgbPaletteAtIndex(uint8_t index,
     for (int i = 0; i < 4; i++) {
         uint8_t low = paletteDataSource[offset + (i * 2)];
         uint8_t high = paletteDataSource[offset + (i * 2) + 1];
-        PaletteData paletteData = PaletteData(low, high);
-        Shinobu::Frontend::OpenGL::Color color;
-        if (correctColors) {
-            // Taken from: https://byuu.net/video/color-emulation/
-            int r = (paletteData.red * 26 + paletteData.green *  4 + paletteData.blue *  2);
-            int g = (                       paletteData.green * 24 + paletteData.blue *  8);
-            int b = (paletteData.red *  6 + paletteData.green *  4 + paletteData.blue * 22);
-            r = std::min(960, r) >> 2;
-            g = std::min(960, g) >> 2;
-            b = std::min(960, b) >> 2;
-            color = { (float)r / 256.0f, (float)g / 256.0f, (float)b / 256.0f };
-        } else {
-            color = { paletteData.red / 32.0f, paletteData.green / 32.0f, paletteData.blue / 32.0f };
-        }
-        palette[i] = color;
+        palette[i] = cgbColorForPaletteData(PaletteData(low, high));
     }
     return palette;
 }
 
+Pixel Core::Device::PictureProcessingUnit::packColor(Core::Palette::Color color) {
+    uint32_t red = (uint32_t)(color.r * 255.0f + 0.5f);
+    uint32_t green = (uint32_t)(color.g * 255.0f + 0.5f);
+    uint32_t blue = (uint32_t)(color.b * 255.0f + 0.5f);
+    return red | (green << 8) | (blue << 16) | (0xFFu << 24);
+}
+
+PixelPalette Core::Device::PictureProcessingUnit::packPalette(const palette &colors) {
+    return { packColor(colors[0]), packColor(colors[1]), packColor(colors[2]), packColor(colors[3]) };
+}
+
 bool Core::Device::PictureProcessingUnit::DMG_compareSpritesByPriority(const Sprite &a, const Sprite &b) {
     if (a.x == b.x) {
         return a.offset < b.offset;
@@ -508,66 +565,73 @@ bool Core::Device::PictureProcessingUnit::CGB_compareSpritesByPriority(const Spr
     return a.offset < b.offset;
 }
 
-std::vector<Sprite> Processor::getVisibleSprites() const {
-    SpriteSize spriteSize = control.spriteSize();
-    uint8_t spriteHeight = spriteSize == SpriteSize::_8x16 ? 16 : 8;
-    std::vector<Sprite> visibleSprites = {};
-    std::vector<Sprite> sprites = getSpriteData();
-    if (control.spriteDisplayEnable) {
-        for (auto const& sprite : sprites) {
-            if ((LY >= sprite.positionY() && LY < (sprite.positionY() + spriteHeight)) && sprite.positionX() >= -8 && sprite.positionX() < 168) {
-                visibleSprites.push_back(sprite);
+void Processor::scanOAM(SpriteScanline &sprites) const {
+    sprites.count = 0;
+    if (!control.spriteDisplayEnable) {
+        return;
+    }
+    uint8_t spriteHeight = control.spriteSize() == SpriteSize::_8x16 ? 16 : 8;
+    for (int i = 0; i < NumberOfSpritesInOAM && sprites.count < MaximumSpritesPerScanline; i++) {
+        uint16_t offset = i * 4;
+        Sprite sprite = Sprite(spriteAttributeTable[offset], spriteAttributeTable[offset + 1], spriteAttributeTable[offset + 2], SpriteAttributes(spriteAttributeTable[offset + 3]), offset);
+        if ((LY >= sprite.positionY() && LY < (sprite.positionY() + spriteHeight)) && sprite.positionX() >= -8 && sprite.positionX() < 168) {
+            sprites.sprites[sprites.count++] = sprite;
+        }
+    }
+    auto end = sprites.sprites.begin() + sprites.count;
+    if (cgbFlag != Core::ROM::CGBFlag::DMG) {
+        std::sort(sprites.sprites.begin(), end, CGB_compareSpritesByPriority);
+    } else {
+        std::sort(sprites.sprites.begin(), end, DMG_compareSpritesByPriority);
+    }
+}
+
+void Processor::rasterizeSprites(const SpriteScanline &sprites, SpriteLineBuffer &line) const {
+    line.spriteIndices.fill(NoSprite);
+    // A pixel shows the first opaque sprite in priority order, and the last
+    // sprite covering it when all of them are transparent there
+    for (uint8_t spriteIndex = 0; spriteIndex < sprites.count; spriteIndex++) {
+        const Sprite &sprite = sprites.sprites[spriteIndex];
+        std::array<uint8_t, 8> colorData = getSpriteRowColorIndices(sprite);
+        for (int16_t i = 0; i < VRAMTileDataSide; i++) {
+            int16_t screenPositionX = sprite.positionX() + i;
+            if (screenPositionX < 0 || screenPositionX >= HorizontalResolution) {
+                continue;
             }
-            if (visibleSprites.size() >= 10) {
-                break;
+            if (line.spriteIndices[screenPositionX] != NoSprite && line.colorIndices[screenPositionX] != 0) {
+                continue;
             }
+            line.spriteIndices[screenPositionX] = spriteIndex;
+            line.colorIndices[screenPositionX] = colorData[i];
         }
     }
-    return visibleSprites;
 }
 
 void Processor::DMG_renderScanline() {
-    const std::vector<Sprite> visibleSprites = getVisibleSprites();
-    const palette colors = paletteSelector->currentSelection();
-    const palette backgroundPaletteColors = { colors[backgroundPalette.color0], colors[backgroundPalette.color1], colors[backgroundPalette.color2], colors[backgroundPalette.color3] };
-    const palette object0PaletteColors = { colors[object0Palette.color0], colors[object0Palette.color1], colors[object0Palette.color2], colors[object0Palette.color3] };
-    const palette object1PaletteColors = { colors[object1Palette.color0], colors[object1Palette.color1], colors[object1Palette.color2], colors[object1Palette.color3] };
+    scanOAM(spriteScanline);
+    rasterizeSprites(spriteScanline, spriteLine);
+    fetchBackgroundScanline(backgroundScanline, backgroundTileRows);
+    uint8_t *line = lcd->colorIndices.data() + LY * HorizontalResolution;
     for (int i = 0; i < HorizontalResolution; i++) {
-        std::vector<Sprite> spritesToDraw = {};
-        for (auto const& sprite : visibleSprites) {
-            if (i >= sprite.positionX() && i < sprite.positionX() + 8) {
-                spritesToDraw.push_back(sprite);
-            }
-        }
-        std::sort(spritesToDraw.begin(), spritesToDraw.end(), DMG_compareSpritesByPriority);
-        if (!control.background_WindowDisplayEnable && spritesToDraw.empty()) {
-            Shinobu::Frontend::OpenGL::Color blankColor = colors[0];
-            lcdData[i * 3 + 0 + LY * HorizontalResolution * 3] = blankColor.r;
-            lcdData[i * 3 + 1 + LY * HorizontalResolution * 3] = blankColor.g;
-            lcdData[i * 3 + 2 + LY * HorizontalResolution * 3] = blankColor.b;
+        uint8_t spriteIndex = spriteLine.spriteIndices[i];
+        if (!control.background_WindowDisplayEnable && spriteIndex == NoSprite) {
+            line[i] = BlankColorIndex;
             continue;
         }
-        Shinobu::Frontend::OpenGL::Color color;
-        uint8_t backgroundColorIndex;
-        std::tie(backgroundColorIndex, std::ignore) = getColorIndexForBackgroundAtScreenHorizontalPosition(i);
-        Shinobu::Frontend::OpenGL::Color backgroundColor = backgroundPaletteColors[backgroundColorIndex];
-        if (spritesToDraw.empty()) {
+        uint8_t color;
+        uint8_t backgroundColorIndex = backgroundScanline.colorIndices[i];
+        uint8_t backgroundColor = backgroundColorIndex;
+        if (spriteIndex == NoSprite) {
             color = backgroundColor;
         } else {
-            uint8_t spriteColorIndex = 0;
-            uint8_t spriteIndex = 0;
-            Sprite spriteToDraw;
-            do {
-                spriteToDraw = spritesToDraw[spriteIndex];
-                spriteColorIndex = getColorIndexForSpriteAtScreenHorizontalPosition(spriteToDraw, i);
-                spriteIndex++;
-            } while (spriteColorIndex == 0 && spriteIndex <= (spritesToDraw.size() - 1));
-
-            Shinobu::Frontend::OpenGL::Color spriteColor;
+            uint8_t spriteColorIndex = spriteLine.colorIndices[i];
+            Sprite spriteToDraw = spriteScanline.sprites[spriteIndex];
+
+            uint8_t spriteColor;
             if (spriteToDraw.attributes.DMGPalette) {
-                spriteColor = object1PaletteColors[spriteColorIndex];
+                spriteColor = 8 + spriteColorIndex;
             } else {
-                spriteColor = object0PaletteColors[spriteColorIndex];
+                spriteColor = 4 + spriteColorIndex;
             }
             if (!control.background_WindowDisplayEnable) {
                 color = spriteColor;
@@ -587,48 +651,31 @@ void Processor::DMG_renderScanline() {
                 }
             }
         }
-        lcdData[i * 3 + 0 + LY * HorizontalResolution * 3] = color.r;
-        lcdData[i * 3 + 1 + LY * HorizontalResolution * 3] = color.g;
-        lcdData[i * 3 + 2 + LY * HorizontalResolution * 3] = color.b;
-    }
-    if (control.windowDisplayEnable && LY >= windowYPosition && windowXPosition.position() <= 160) {
-        windowLineCounter++;
+        line[i] = color;
     }
 }
 
 void Processor::CGB_renderScanline() {
-    const std::vector<Sprite> visibleSprites = getVisibleSprites();
+    scanOAM(spriteScanline);
+    rasterizeSprites(spriteScanline, spriteLine);
+    fetchBackgroundScanline(backgroundScanline, backgroundTileRows);
+    uint8_t *line = lcd->colorIndices.data() + LY * HorizontalResolution;
     for (int i = 0; i < HorizontalResolution; i++) {
-        std::vector<Sprite> spritesToDraw = {};
-        for (auto const& sprite : visibleSprites) {
-            if (i >= sprite.positionX() && i < sprite.positionX() + 8) {
-                spritesToDraw.push_back(sprite);
-            }
-        }
-        std::sort(spritesToDraw.begin(), spritesToDraw.end(), CGB_compareSpritesByPriority);
-        BackgroundMapAttributes backgroundAttr;
-        Shinobu::Frontend::OpenGL::Color color;
-        uint8_t backgroundColorIndex;
-        std::tie(backgroundColorIndex, backgroundAttr) = getColorIndexForBackgroundAtScreenHorizontalPosition(i);
-        const palette backgroundPalette = cgbPaletteAtIndex(backgroundAttr.paletteNumber, true);
-        Shinobu::Frontend::OpenGL::Color backgroundColor = backgroundPalette[backgroundColorIndex];
-        if (spritesToDraw.empty()) {
+        uint8_t spriteIndex = spriteLine.spriteIndices[i];
+        BackgroundMapAttributes backgroundAttr = backgroundScanline.attributes[i];
+        uint8_t color;
+        uint8_t backgroundColorIndex = backgroundScanline.colorIndices[i];
+        uint8_t backgroundColor = backgroundAttr.paletteNumber * 4 + backgroundColorIndex;
+        if (spriteIndex == NoSprite) {
             color = backgroundColor;
         } else {
-            uint8_t spriteColorIndex = 0;
-            uint8_t spriteIndex = 0;
-            Sprite spriteToDraw;
-            do {
-                spriteToDraw = spritesToDraw[spriteIndex];
-                spriteColorIndex = getColorIndexForSpriteAtScreenHorizontalPosition(spriteToDraw, i);
-                spriteIndex++;
-            } while (spriteColorIndex == 0 && spriteIndex <= (spritesToDraw.size() - 1));
+            uint8_t spriteColorIndex = spriteLine.colorIndices[i];
+            Sprite spriteToDraw = spriteScanline.sprites[spriteIndex];
 
             if (spriteColorIndex == 0) {
                 color = backgroundColor;
             } else {
-                const palette spritePalette = cgbPaletteAtIndex(spriteToDraw.attributes.CGBPalette, false);
-                Shinobu::Frontend::OpenGL::Color spriteColor = spritePalette[spriteColorIndex];
+                uint8_t spriteColor = ObjectPaletteEntriesStart + spriteToDraw.attributes.CGBPalette * 4 + spriteColorIndex;
 
                 if (!control.background_WindowDisplayEnable) {
                     color = spriteColor;
@@ -653,12 +700,7 @@ void Processor::CGB_renderScanline() {
                 }
             }
         }
-        lcdData[i * 3 + 0 + LY * HorizontalResolution * 3] = color.r;
-        lcdData[i * 3 + 1 + LY * HorizontalResolution * 3] = color.g;
-        lcdData[i * 3 + 2 + LY * HorizontalResolution * 3] = color.b;
-    }
-    if (control.windowDisplayEnable && LY >= windowYPosition && windowXPosition.position() <= 160) {
-        windowLineCounter++;
+        line[i] = color;
     }
 }
 
@@ -666,10 +708,17 @@ void Processor::renderScanline() {
     if (LY == windowYPosition) {
         windowYPositionTrigger = true;
     }
-    if (cgbFlag != Core::ROM::CGBFlag::DMG) {
-        CGB_renderScanline();
-    } else {
-        DMG_renderScanline();
+    // Without an LCD to draw into only the window line counter matters
+    if (lcd) {
+        captureLinePalette();
+        if (cgbFlag != Core::ROM::CGBFlag::DMG) {
+            CGB_renderScanline();
+        } else {
+            DMG_renderScanline();
+        }
+    }
+    if (control.windowDisplayEnable && LY >= windowYPosition && windowXPosition.position() <= 160) {
+        windowLineCounter++;
     }
 }
 
@@ -680,20 +729,13 @@ uint16_t Processor::physicalAddressForAddress(uint16_t address) const {
 }
 
 std::array<uint8_t, 8> Processor::getTileRowPixelsColorIndicesWithData(uint8_t low, uint8_t high) const {
-    std::array<uint8_t, 8> tileRowPixelsColorIndices = {};
-    std::bitset<8> lowBits = std::bitset<8>(low);
-    std::bitset<8> highBits = std::bitset<8>(high);
-    for (int i = 7; i >= 0; i--) {
-        uint8_t highMask = (uint8_t)highBits.test(i) << 0x1;
-        uint8_t low = lowBits.test(i);
-        uint8_t index = highMask | low;
-        tileRowPixelsColorIndices[7-i] = index;
-    }
+    std::array<uint8_t, 8> tileRowPixelsColorIndices;
+    TileRow::decodeScalar(&low, &high, 1, tileRowPixelsColorIndices.data());
     return tileRowPixelsColorIndices;
 }
 
-std::vector<Shinobu::Frontend::OpenGL::Vertex> Processor::getBackgroundTileByIndex(uint16_t index, BackgroundMapAttributes attributes) const {
-    std::vector<Shinobu::Frontend::OpenGL::Vertex> tile = {};
+std::vector<Core::Viewer::Vertex> Processor::getBackgroundTileByIndex(uint16_t index, BackgroundMapAttributes attributes) const {
+    std::vector<Core::Viewer::Vertex> tile = {};
     palette palette;
     if (cgbFlag != Core::ROM::CGBFlag::DMG) {
         palette = cgbPaletteAtIndex(attributes.paletteNumber, true);
@@ -713,15 +755,15 @@ std::vector<Shinobu::Frontend::OpenGL::Vertex> Processor::getBackgroundTileByInd
         uint8_t high = memory[highAddress];
         auto colorData = getTileRowPixelsColorIndicesWithData(low, high);
         for (int j = 0; j < VRAMTileDataSide; j++) {
-            Shinobu::Frontend::OpenGL::Vertex vertex = { { (GLfloat)j, (GLfloat)(7 - i) }, palette[colorData[j]] };
+            Core::Viewer::Vertex vertex = { { (float)j, (float)(7 - i) }, palette[colorData[j]] };
             tile.push_back(vertex);
         }
     }
     return tile;
 }
 
-std::vector<Shinobu::Frontend::OpenGL::Vertex> Processor::getTileByIndex(uint16_t index, uint8_t bank, Shinobu::Frontend::Palette::palette paletteColors) const {
-    std::vector<Shinobu::Frontend::OpenGL::Vertex> tile = {};
+std::vector<Core::Viewer::Vertex> Processor::getTileByIndex(uint16_t index, uint8_t bank, Core::Palette::palette paletteColors) const {
+    std::vector<Core::Viewer::Vertex> tile = {};
     for (int i = 0; i < VRAMTileDataSide; i++) {
         uint16_t offset = (0x10 * index);
         uint16_t lowAddress = i * 2 + offset;
@@ -734,14 +776,14 @@ std::vector<Shinobu::Frontend::OpenGL::Vertex> Processor::getTileByIndex(uint16_
         uint8_t high = memory[highAddress];
         auto colorData = getTileRowPixelsColorIndicesWithData(low, high);
         for (int j = 0; j < VRAMTileDataSide; j++) {
-            Shinobu::Frontend::OpenGL::Vertex vertex = { { (GLfloat)j, (GLfloat)(7 - i) }, paletteColors[colorData[j]] };
+            Core::Viewer::Vertex vertex = { { (float)j, (float)(7 - i) }, paletteColors[colorData[j]] };
             tile.push_back(vertex);
         }
     }
     return tile;
 }
 
-void Processor::translateTileOwnCoordinatesToTileDataViewerCoordinates(std::vector<Shinobu::Frontend::OpenGL::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<GLfloat>& data) const {
+void Processor::translateTileOwnCoordinatesToTileDataViewerCoordinates(std::vector<Core::Viewer::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<float>& data) const {
     for (const auto& tilePixel : tile) {
         uint16_t x = tilePixel.position.x + (tileX * VRAMTileDataSide);
         uint16_t y = tilePixel.position.y + (tileY * VRAMTileDataSide);
@@ -751,8 +793,8 @@ void Processor::translateTileOwnCoordinatesToTileDataViewerCoordinates(std::vect
     }
 }
 
-void Processor::translateTileOwnCoordinatesToBackgroundMapViewerCoordinates(std::vector<Shinobu::Frontend::OpenGL::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<GLfloat>& data) const {
-    std::vector<Shinobu::Frontend::OpenGL::Vertex> pixels = {};
+void Processor::translateTileOwnCoordinatesToBackgroundMapViewerCoordinates(std::vector<Core::Viewer::Vertex> tile, uint16_t tileX, uint16_t tileY, std::vector<float>& data) const {
+    std::vector<Core::Viewer::Vertex> pixels = {};
     for (const auto& tilePixel : tile) {
         uint16_t x = tilePixel.position.x + (tileX * VRAMTileDataSide);
         uint16_t y = tilePixel.position.y + (tileY * VRAMTileDataSide);
@@ -762,7 +804,7 @@ void Processor::translateTileOwnCoordinatesToBackgroundMapViewerCoordinates(std:
     }
 }
 
-void Processor::translateSpriteOwnCoordinatesToSpriteViewerCoordinates(std::vector<Shinobu::Frontend::OpenGL::Vertex> tile, SpriteTilePositionInViewer position, std::vector<GLfloat>& data) const {
+void Processor::translateSpriteOwnCoordinatesToSpriteViewerCoordinates(std::vector<Core::Viewer::Vertex> tile, SpriteTilePositionInViewer position, std::vector<float>& data) const {
     for (const auto& tilePixel : tile) {
         uint16_t x = tilePixel.position.x;
         uint16_t y = tilePixel.position.y + position;
@@ -772,14 +814,14 @@ void Processor::translateSpriteOwnCoordinatesToSpriteViewerCoordinates(std::vect
     }
 }
 
-std::vector<GLfloat> Processor::getTileData(uint8_t bank) const {
+std::vector<float> Processor::getTileData(uint8_t bank) const {
     const palette colors = paletteSelector->currentSelection();
-    std::vector<GLfloat> data = {};
+    std::vector<float> data = {};
     data.resize(VRAMTileDataSide * VRAMTileDataSide * VRAMTileDataViewerHeight * VRAMTileDataViewerWidth * 3);
     uint16_t index = 0;
     for (int y = (VRAMTileDataViewerHeight - 1); y >= 0; y--) {
         for (int x = 0; x < VRAMTileDataViewerWidth; x++) {
-            std::vector<Shinobu::Frontend::OpenGL::Vertex> tile = getTileByIndex(index, bank, colors);
+            std::vector<Core::Viewer::Vertex> tile = getTileByIndex(index, bank, colors);
             translateTileOwnCoordinatesToTileDataViewerCoordinates(tile, x, y, data);
             index++;
         }
@@ -787,7 +829,7 @@ std::vector<GLfloat> Processor::getTileData(uint8_t bank) const {
     return data;
 }
 
-std::vector<GLfloat> Processor::getBackgroundMapData(BackgroundType type) const {
+std::vector<float> Processor::getBackgroundMapData(BackgroundType type) const {
     Background_WindowTileMapLocation location;
     if (type == BackgroundType::Normal) {
         location = control.backgroundTileMapDisplaySelect();
@@ -803,7 +845,7 @@ std::vector<GLfloat> Processor::getBackgroundMapData(BackgroundType type) const
         backgroundMapAddressStart = 0x9C00 - 0x8000;
         break;
     }
-    std::vector<GLfloat> data = {};
+    std::vector<float> data = {};
     data.resize(VRAMTileDataSide * VRAMTileDataSide * VRAMTileBackgroundMapSide * VRAMTileBackgroundMapSide * 3);
     Background_WindowTileDataLocation tileDataLocation = control.background_WindowTileDataSelect();
     uint16_t index = 0;
@@ -815,7 +857,7 @@ std::vector<GLfloat> Processor::getBackgroundMapData(BackgroundType type) const
                 uint16_t addressInBackgroundMapAttributes = (0x1 << 13) | (addressInBackgroundMap & 0x1FFF);
                 attributes = BackgroundMapAttributes(memory[addressInBackgroundMapAttributes]);
             }
-            std::vector<Shinobu::Frontend::OpenGL::Vertex> tile;
+            std::vector<Core::Viewer::Vertex> tile;
             if (tileDataLocation == _8000_8FFF) {
                 uint8_t tileIndex = memory[backgroundMapAddressStart + index];
                 tile = getBackgroundTileByIndex(tileIndex, attributes);
@@ -830,15 +872,15 @@ std::vector<GLfloat> Processor::getBackgroundMapData(BackgroundType type) const
     return data;
 }
 
-std::vector<Shinobu::Frontend::OpenGL::Vertex> Processor::getScrollingViewPort() const {
-    Shinobu::Frontend::OpenGL::Color color = { 1.0, 0.0, 0.0 };
-    Shinobu::Frontend::OpenGL::Point upperLeft = { (GLfloat)scrollX, (GLfloat)scrollY };
-    Shinobu::Frontend::OpenGL::Point upperLeftTranslated = { upperLeft.x, TileMapResolution - upperLeft.y };
-    std::vector<Shinobu::Frontend::OpenGL::Vertex> viewPort = {};
-    Shinobu::Frontend::OpenGL::Vertex v1 = { upperLeftTranslated, color };
-    Shinobu::Frontend::OpenGL::Vertex v2 = { { upperLeftTranslated.x + HorizontalResolution, upperLeftTranslated.y }, color };
-    Shinobu::Frontend::OpenGL::Vertex v3 = { { upperLeftTranslated.x + HorizontalResolution, upperLeftTranslated.y - VerticalResolution }, color };
-    Shinobu::Frontend::OpenGL::Vertex v4 = { { upperLeftTranslated.x, upperLeftTranslated.y - VerticalResolution }, color };
+std::vector<Core::Viewer::Vertex> Processor::getScrollingViewPort() const {
+    Core::Palette::Color color = { 1.0, 0.0, 0.0 };
+    Core::Viewer::Point upperLeft = { (float)scrollX, (float)scrollY };
+    Core::Viewer::Point upperLeftTranslated = { upperLeft.x, TileMapResolution - upperLeft.y };
+    std::vector<Core::Viewer::Vertex> viewPort = {};
+    Core::Viewer::Vertex v1 = { upperLeftTranslated, color };
+    Core::Viewer::Vertex v2 = { { upperLeftTranslated.x + HorizontalResolution, upperLeftTranslated.y }, color };
+    Core::Viewer::Vertex v3 = { { upperLeftTranslated.x + HorizontalResolution, upperLeftTranslated.y - VerticalResolution }, color };
+    Core::Viewer::Vertex v4 = { { upperLeftTranslated.x, upperLeftTranslated.y - VerticalResolution }, color };
     viewPort.push_back(v1);
     viewPort.push_back(v2);
     viewPort.push_back(v2);
@@ -888,26 +930,71 @@ std::vector<Shinobu::Frontend::OpenGL::Vertex> Processor::getScrollingViewPort()
     return viewPort;
 }
 
-std::vector<GLfloat> Processor::getLCDData() {
+// Shared by every PPU, it's only ever read
+static const ColorIndexFramebuffer &blankLCDColorIndices() {
+    static const ColorIndexFramebuffer blank = []() {
+        ColorIndexFramebuffer colorIndices;
+        colorIndices.fill(BlankColorIndex);
+        return colorIndices;
+    }();
+    return blank;
+}
+
+const ColorIndexFramebuffer &Processor::getLCDColorIndices() {
+    allocateLCD();
     if (shouldNextFrameBeBlank) {
         shouldNextFrameBeBlank = false;
         logger.logWarning("Rendering blank frame");
-        return blankLCDData();
+        return blankLCDColorIndices();
     }
-    return lcdData;
+    return lcd->colorIndices;
 }
 
-std::vector<Sprite> Processor::getSpriteData() const {
-    std::vector<Sprite> sprites = {};
-    for (int i = 0; i < NumberOfSpritesInOAM; i++) {
-        uint16_t offset = i * 4;
-        Sprite sprite = Sprite(spriteAttributeTable[offset], spriteAttributeTable[offset + 1], spriteAttributeTable[offset + 2], SpriteAttributes(spriteAttributeTable[offset + 3]), offset);
-        sprites.push_back(sprite);
+const LinePalettes &Processor::getLCDLinePalettes() {
+    allocateLCD();
+    return lcd->linePalettes;
+}
+
+bool Processor::usesCGBPalettes() const {
+    return cgbFlag != Core::ROM::CGBFlag::DMG;
+}
+
+bool Processor::correctsColors() const {
+    return correctColors;
+}
+
+Core::Palette::palette Processor::currentPaletteSelection() const {
+    return paletteSelector->currentSelection();
+}
+
+const Framebuffer &Processor::getLCDData() {
+    const ColorIndexFramebuffer &colorIndices = getLCDColorIndices();
+    if (!lcdData) {
+        lcdData = std::make_unique<Framebuffer>();
     }
-    return sprites;
+    const PixelPalette selection = packPalette(paletteSelector->currentSelection());
+    std::array<Pixel, LinePaletteSize + 2> colors;
+    colors[BlackColorIndex] = packColor({ 0.0f, 0.0f, 0.0f });
+    colors[BlankColorIndex] = selection[0];
+    bool cgbPalettes = usesCGBPalettes();
+    for (int j = 0; j < VerticalResolution; j++) {
+        const LinePalette &linePalette = lcd->linePalettes[j];
+        for (int i = 0; i < LinePaletteSize; i++) {
+            if (cgbPalettes) {
+                PaletteData paletteData = PaletteData(linePalette[i] & 0xFF, linePalette[i] >> 8);
+                colors[i] = packColor(cgbColorForPaletteData(paletteData));
+            } else {
+                colors[i] = selection[linePalette[i] & 0x3];
+            }
+        }
+        for (int i = 0; i < HorizontalResolution; i++) {
+            (*lcdData)[j * HorizontalResolution + i] = colors[colorIndices[j * HorizontalResolution + i]];
+        }
+    }
+    return *lcdData;
 }
 
-std::pair<Sprite, std::vector<GLfloat>> Processor::getSpriteAtIndex(uint8_t index) const {
+std::pair<Sprite, std::vector<float>> Processor::getSpriteAtIndex(uint8_t index) const {
     uint16_t offset = index * 4;
     Sprite sprite = Sprite(spriteAttributeTable[offset], spriteAttributeTable[offset + 1], spriteAttributeTable[offset + 2], SpriteAttributes(spriteAttributeTable[offset + 3]), offset);
 
@@ -917,18 +1004,18 @@ std::pair<Sprite, std::vector<GLfloat>> Processor::getSpriteAtIndex(uint8_t inde
     const palette selectedPalette = cgbFlag == Core::ROM::CGBFlag::DMG ? sprite.attributes.DMGPalette == 0 ? object0PaletteColors : object1PaletteColors : cgbPaletteAtIndex(sprite.attributes.CGBPalette, false);
 
     SpriteSize spriteSize = control.spriteSize();
-    std::vector<GLfloat> spriteData = {};
+    std::vector<float> spriteData = {};
     spriteData.resize(VRAMTileDataSide * 2 * VRAMTileDataSide * 3);
     std::fill_n(spriteData.begin(), VRAMTileDataSide * 2 * VRAMTileDataSide * 3, 0xFF);
     if (spriteSize == SpriteSize::_8x8) {
-        std::vector<Shinobu::Frontend::OpenGL::Vertex> vertices = getTileByIndex(sprite.tileNumber, 0, selectedPalette);
+        std::vector<Core::Viewer::Vertex> vertices = getTileByIndex(sprite.tileNumber, 0, selectedPalette);
         translateSpriteOwnCoordinatesToSpriteViewerCoordinates(vertices, SpriteTilePositionInViewer::Middle, spriteData);
         return { sprite, spriteData };
     } else {
         uint16_t tileIndex = sprite.tileNumber & 0xFE;
-        std::vector<Shinobu::Frontend::OpenGL::Vertex> bottomTile = getTileByIndex(tileIndex + 1, 0, selectedPalette);
+        std::vector<Core::Viewer::Vertex> bottomTile = getTileByIndex(tileIndex + 1, 0, selectedPalette);
         translateSpriteOwnCoordinatesToSpriteViewerCoordinates(bottomTile, SpriteTilePositionInViewer::Bottom, spriteData);
-        std::vector<Shinobu::Frontend::OpenGL::Vertex> topTile = getTileByIndex(tileIndex, 0, selectedPalette);
+        std::vector<Core::Viewer::Vertex> topTile = getTileByIndex(tileIndex, 0, selectedPalette);
         translateSpriteOwnCoordinatesToSpriteViewerCoordinates(topTile, SpriteTilePositionInViewer::Top, spriteData);
         bottomTile.insert(bottomTile.end(), topTile.begin(), topTile.end());
         return { sprite, spriteData };
@@ -938,3 +1025,97 @@ std::pair<Sprite, std::vector<GLfloat>> Processor::getSpriteAtIndex(uint8_t inde
 uint8_t Processor::VRAMBank() const {
     return _VBK.bank;
 }
+
+void Processor::saveState(Core::SaveState::Writer &writer) const {
+    memory.saveState(writer);
+    writer.write(spriteAttributeTable);
+    writer.write(control);
+    writer.write(status);
+    writer.write(scrollY);
+    writer.write(scrollX);
+    writer.write(LY);
+    writer.write(LYC);
+    writer.write(backgroundPalette);
+    writer.write(object0Palette);
+    writer.write(object1Palette);
+    writer.write(windowYPosition);
+    writer.write(windowXPosition);
+    writer.write(windowLineCounter);
+    writer.write(windowYPositionTrigger);
+    writer.write(steps);
+    writer.write(nextModeUpdateSteps);
+    writer.write(interruptConditions);
+    writer.write(DMA);
+    writer.write(shouldNextFrameBeBlank);
+    writer.write(_VBK);
+    writer.write(backgroundPaletteData);
+    writer.write(_BGPI);
+    writer.write(objectPaletteData);
+    writer.write(_OBPI);
+}
+
+void Processor::loadState(Core::SaveState::Reader &reader) {
+    memory.loadState(reader);
+    reader.read(spriteAttributeTable);
+    reader.read(control);
+    reader.read(status);
+    reader.read(scrollY);
+    reader.read(scrollX);
+    reader.read(LY);
+    reader.read(LYC);
+    reader.read(backgroundPalette);
+    reader.read(object0Palette);
+    reader.read(object1Palette);
+    reader.read(windowYPosition);
+    reader.read(windowXPosition);
+    reader.read(windowLineCounter);
+    reader.read(windowYPositionTrigger);
+    reader.read(steps);
+    reader.read(nextModeUpdateSteps);
+    reader.read(interruptConditions);
+    reader.read(DMA);
+    reader.read(shouldNextFrameBeBlank);
+    reader.read(_VBK);
+    reader.read(backgroundPaletteData);
+    reader.read(_BGPI);
+    reader.read(objectPaletteData);
+    reader.read(_OBPI);
+}
+
+void Processor::validateState(Core::SaveState::Reader &reader) const {
+    memory.validateState(reader);
+    reader.skipBytes(sizeof(spriteAttributeTable) + sizeof(control) + sizeof(status) + sizeof(scrollY) + sizeof(scrollX) +
+                     sizeof(LY) + sizeof(LYC) + sizeof(backgroundPalette) + sizeof(object0Palette) + sizeof(object1Palette) +
+                     sizeof(windowYPosition) + sizeof(windowXPosition) + sizeof(windowLineCounter) +
+                     sizeof(windowYPositionTrigger) + sizeof(steps) + sizeof(nextModeUpdateSteps) +
+                     sizeof(interruptConditions) + sizeof(DMA) + sizeof(shouldNextFrameBeBlank) + sizeof(_VBK) +
+                     sizeof(backgroundPaletteData) + sizeof(_BGPI) + sizeof(objectPaletteData) + sizeof(_OBPI));
+}
+
+// VRAM is shared through shareMemory
+void Processor::copyState(const Processor &other) {
+    spriteAttributeTable = other.spriteAttributeTable;
+    control = other.control;
+    status = other.status;
+    scrollY = other.scrollY;
+    scrollX = other.scrollX;
+    LY = other.LY;
+    LYC = other.LYC;
+    backgroundPalette = other.backgroundPalette;
+    object0Palette = other.object0Palette;
+    object1Palette = other.object1Palette;
+    windowYPosition = other.windowYPosition;
+    windowXPosition = other.windowXPosition;
+    windowLineCounter = other.windowLineCounter;
+    windowYPositionTrigger = other.windowYPositionTrigger;
+    steps = other.steps;
+    nextModeUpdateSteps = other.nextModeUpdateSteps;
+    interruptConditions = other.interruptConditions;
+    DMA = other.DMA;
+    shouldNextFrameBeBlank = other.shouldNextFrameBeBlank;
+    _VBK = other._VBK;
+    backgroundPaletteData = other.backgroundPaletteData;
+    _BGPI = other._BGPI;
+    objectPaletteData = other.objectPaletteData;
+    _OBPI = other._OBPI;
+}
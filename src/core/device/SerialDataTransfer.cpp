@@ -3,7 +3,7 @@
 
 using namespace Core::Device::SerialDataTransfer;
 
-Controller::Controller(Common::Logs::Level logLevel) : logger(logLevel, "  [Serial]: "), ttyBuffer() {
+Controller::Controller(Common::Logs::Level logLevel) : logger(logLevel, "  [Serial]: "), ttyBuffer(), result(Core::TestResult::Running) {
 
 }
 
@@ -14,12 +14,25 @@ Controller::~Controller() {
 void Controller::checkTTY(char c) {
     if (c == '\n') {
         logger.logDebug("%s", ttyBuffer.c_str());
+        checkTestResult();
         ttyBuffer.clear();
         return;
     }
     ttyBuffer.append(1, c);
 }
 
+// Blargg's ROMs end with a "Passed" line, or a line starting with "Failed"
+void Controller::checkTestResult() {
+    if (result != Core::TestResult::Running) {
+        return;
+    }
+    if (ttyBuffer.compare(0, 6, "Passed") == 0) {
+        result = Core::TestResult::Passed;
+    } else if (ttyBuffer.compare(0, 6, "Failed") == 0) {
+        result = Core::TestResult::Failed;
+    }
+}
+
 uint8_t Controller::load(uint16_t offset) {
     switch (offset) {
     case 0x0:
@@ -49,3 +62,31 @@ void Controller::store(uint16_t offset, uint8_t value) {
         return;
     }
 }
+
+void Controller::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(data);
+    writer.write(control);
+}
+
+// The output seen so far belongs to the run that's being replaced
+void Controller::loadState(Core::SaveState::Reader &reader) {
+    reader.read(data);
+    reader.read(control);
+    ttyBuffer.clear();
+    result = Core::TestResult::Running;
+}
+
+void Controller::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(data) + sizeof(control));
+}
+
+void Controller::copyState(const Controller &other) {
+    data = other.data;
+    control = other.control;
+    ttyBuffer = other.ttyBuffer;
+    result = other.result;
+}
+
+Core::TestResult::Result Controller::testResult() const {
+    return result;
+}
@@ -3,7 +3,7 @@
 
 using namespace Core::Device::Sound;
 
-Controller::Controller(Common::Logs::Level logLevel, bool mute) : logger(logLevel, "  [Sound]: "), apu(), buffer(), time(), muted(mute) {
+Controller::Controller(Common::Logs::Level logLevel, bool mute, bool nullAudio) : logger(logLevel, "  [Sound]: "), apu(), buffer(), time(), muted(mute), turbo(), rateAdjustment(), nullAudio(nullAudio), registers(), registerFile() {
     apu.treble_eq(-20.0);
 	buffer.bass_freq(461);
 	if (muted) {
@@ -15,22 +15,44 @@ Controller::Controller(Common::Logs::Level logLevel, bool mute) : logger(logLeve
 
 Controller::~Controller() {}
 
-blip_time_t Controller::clock() {
-    return time += 4;
-}
-
 uint8_t Controller::load(uint16_t address) {
-    return apu.read_register(clock(), address);
+    if (nullAudio) {
+        return registers.load(address);
+    }
+    return apu.read_register(time, address);
 }
 
 void Controller::store(uint16_t address, uint8_t value) {
-    apu.write_register(clock(), address, value);
+    registerFile[address - 0xFF10] = value;
+    if (nullAudio) {
+        registers.store(address, value);
+        return;
+    }
+    apu.write_register(time, address, value);
 }
 
 void Controller::step(uint8_t cycles) {
+	if (nullAudio) {
+		registers.step(cycles);
+		return;
+	}
+	time += cycles;
+	if (time < (blip_time_t)CyclesPerScanline) {
+		return;
+	}
+	endFrame();
+}
+
+// Ending Blip frames is by far the most expensive part of the glue, so
+// they are batched once per scanline worth of cycles
+void Controller::endFrame() {
+	blip_time_t frameLength = time;
 	time = 0;
-	bool stereo = apu.end_frame(cycles);
-	buffer.end_frame(cycles, stereo);
+	bool stereo = apu.end_frame(frameLength);
+	if (turbo) {
+		return;
+	}
+	buffer.end_frame(frameLength, stereo);
 }
 
 long Controller::availableSamples() const {
@@ -41,7 +63,14 @@ long Controller::readSamples(sample_t* out, long count) {
 	return buffer.read_samples(out, count);
 }
 
+void Controller::discardSamples() {
+	buffer.clear();
+}
+
 blargg_err_t Controller::setSampleRate(long rate) {
+	if (nullAudio) {
+		return 0;
+	}
 	apu.output(buffer.center(), buffer.left(), buffer.right());
 	buffer.clock_rate(CyclesPerSecond);
 	return buffer.set_sample_rate(rate);
@@ -55,3 +84,99 @@ void Controller::toggleMute() {
 		apu.volume(1.0f);
 	}
 }
+
+void Controller::setTurbo(bool enabled) {
+	if (turbo == enabled) {
+		return;
+	}
+	turbo = enabled;
+	// Without outputs the oscillators aren't synthesized at all, registers
+	// and length/envelope/sweep counters keep running.
+	if (turbo) {
+		apu.output(NULL, NULL, NULL);
+	} else {
+		apu.output(buffer.center(), buffer.left(), buffer.right());
+	}
+	buffer.clear();
+}
+
+// Small changes to the rate the buffer is clocked at resample the output,
+// so the frontend can keep its queue at a steady fill level
+void Controller::setRateAdjustment(double adjustment) {
+	if (rateAdjustment == adjustment) {
+		return;
+	}
+	rateAdjustment = adjustment;
+	buffer.clock_rate(CyclesPerSecond * (1.0 + rateAdjustment));
+}
+
+void Controller::saveState(Core::SaveState::Writer &writer) {
+	writer.write(nullAudio);
+	writer.write(registerFile);
+	writer.write(load(0xFF26));
+	registers.saveState(writer);
+}
+
+void Controller::loadState(Core::SaveState::Reader &reader) {
+	bool savedNullAudio = reader.read<bool>();
+	std::array<uint8_t, 0x30> savedRegisterFile = reader.read<std::array<uint8_t, 0x30>>();
+	uint8_t status = reader.read<uint8_t>();
+	RegisterModel savedRegisters = RegisterModel();
+	savedRegisters.loadState(reader);
+	if (nullAudio && savedNullAudio) {
+		registers = savedRegisters;
+		registerFile = savedRegisterFile;
+		return;
+	}
+	if (nullAudio) {
+		registers = RegisterModel();
+	} else {
+		apu.reset();
+		time = 0;
+		buffer.clear();
+	}
+	replayRegisters(savedRegisterFile, status);
+}
+
+void Controller::validateState(Core::SaveState::Reader &reader) const {
+	reader.skipBytes(sizeof(bool) + sizeof(registerFile) + sizeof(uint8_t));
+	registers.validateState(reader);
+}
+
+void Controller::copyState(Controller &other) {
+	if (nullAudio && other.nullAudio) {
+		registers = other.registers;
+		registerFile = other.registerFile;
+		return;
+	}
+	if (nullAudio) {
+		registers = RegisterModel();
+	} else {
+		apu.reset();
+		time = 0;
+		buffer.clear();
+	}
+	replayRegisters(other.registerFile, other.load(0xFF26));
+}
+
+// Approximates the saved APU by writing its registers back in an order
+// that survives power control, channels are only retriggered when they
+// were still playing when the state was saved.
+void Controller::replayRegisters(const std::array<uint8_t, 0x30> &values, uint8_t status) {
+	store(0xFF26, 0x80);
+	for (uint16_t address = 0xFF30; address < 0xFF40; address++) {
+		store(address, values[address - 0xFF10]);
+	}
+	for (uint16_t address = 0xFF10; address < 0xFF26; address++) {
+		uint8_t value = values[address - 0xFF10];
+		uint16_t offset = address - 0xFF10;
+		if (offset < 0x14 && (offset % 5) == 4 && !(status & (1 << (offset / 5)))) {
+			value &= 0x7F;
+		}
+		store(address, value);
+	}
+	if (!(status & 0x80)) {
+		store(0xFF26, 0x0);
+	}
+	registerFile = values;
+}
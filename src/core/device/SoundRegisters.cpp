@@ -0,0 +1,186 @@
+#include "core/device/SoundRegisters.hpp"
+
+using namespace Core::Device::Sound;
+
+RegisterModel::RegisterModel() : registers(), powered(true), enabledChannels(), lengthCounters(), sequencerCycles(), sequencerStep(), shadowFrequency(), sweepTimer(), sweepEnabled() {}
+
+RegisterModel::~RegisterModel() {}
+
+bool RegisterModel::isDACEnabled(uint8_t channel) const {
+    if (channel == 2) {
+        return registers[0xA] & 0x80;
+    }
+    return registers[channel * 5 + 2] & 0xF8;
+}
+
+void RegisterModel::trigger(uint8_t channel) {
+    if (lengthCounters[channel] == 0) {
+        lengthCounters[channel] = channel == 2 ? 256 : 64;
+    }
+    if (isDACEnabled(channel)) {
+        enabledChannels |= (1 << channel);
+    }
+    if (channel != 0) {
+        return;
+    }
+    uint8_t period = (registers[0x0] >> 4) & 0x7;
+    uint8_t shift = registers[0x0] & 0x7;
+    shadowFrequency = registers[0x3] | ((registers[0x4] & 0x7) << 8);
+    sweepTimer = period != 0 ? period : 8;
+    sweepEnabled = period != 0 || shift != 0;
+    if (shift != 0) {
+        nextSweepFrequency();
+    }
+}
+
+// Disables channel 1 when the next frequency overflows
+uint16_t RegisterModel::nextSweepFrequency() {
+    uint16_t delta = shadowFrequency >> (registers[0x0] & 0x7);
+    uint16_t frequency = (registers[0x0] & 0x8) ? shadowFrequency - delta : shadowFrequency + delta;
+    if (frequency > 0x7FF) {
+        enabledChannels &= ~0x1;
+    }
+    return frequency;
+}
+
+void RegisterModel::clockLengthCounters() {
+    for (uint8_t channel = 0; channel < 4; channel++) {
+        if (!(registers[channel * 5 + 4] & 0x40) || lengthCounters[channel] == 0) {
+            continue;
+        }
+        lengthCounters[channel]--;
+        if (lengthCounters[channel] == 0) {
+            enabledChannels &= ~(1 << channel);
+        }
+    }
+}
+
+void RegisterModel::clockSweep() {
+    if (sweepTimer > 0) {
+        sweepTimer--;
+    }
+    if (sweepTimer > 0) {
+        return;
+    }
+    uint8_t period = (registers[0x0] >> 4) & 0x7;
+    sweepTimer = period != 0 ? period : 8;
+    if (!sweepEnabled || period == 0) {
+        return;
+    }
+    uint16_t frequency = nextSweepFrequency();
+    if (frequency > 0x7FF || (registers[0x0] & 0x7) == 0) {
+        return;
+    }
+    shadowFrequency = frequency;
+    registers[0x3] = frequency & 0xFF;
+    registers[0x4] = (registers[0x4] & ~0x7) | ((frequency >> 8) & 0x7);
+    nextSweepFrequency();
+}
+
+uint8_t RegisterModel::load(uint16_t address) const {
+    uint16_t offset = address - 0xFF10;
+    if (offset >= 0x20) {
+        return registers[offset];
+    }
+    if (address == 0xFF26) {
+        return (powered ? 0x80 : 0x0) | RegisterReadMasks[offset] | enabledChannels;
+    }
+    return registers[offset] | RegisterReadMasks[offset];
+}
+
+void RegisterModel::store(uint16_t address, uint8_t value) {
+    uint16_t offset = address - 0xFF10;
+    if (offset >= 0x20) {
+        registers[offset] = value;
+        return;
+    }
+    if (address == 0xFF26) {
+        bool power = value & 0x80;
+        if (powered && !power) {
+            for (uint16_t i = 0; i < 0x16; i++) {
+                registers[i] = 0;
+            }
+            enabledChannels = 0;
+        } else if (!powered && power) {
+            sequencerStep = 0;
+        }
+        powered = power;
+        return;
+    }
+    if (!powered) {
+        return;
+    }
+    registers[offset] = value;
+    if (offset >= 0x14) {
+        return;
+    }
+    uint8_t channel = offset / 5;
+    switch (offset % 5) {
+    case 0:
+        if (channel == 2 && !isDACEnabled(channel)) {
+            enabledChannels &= ~(1 << channel);
+        }
+        break;
+    case 1:
+        lengthCounters[channel] = channel == 2 ? 256 - value : 64 - (value & 0x3F);
+        break;
+    case 2:
+        if (channel != 2 && !isDACEnabled(channel)) {
+            enabledChannels &= ~(1 << channel);
+        }
+        break;
+    case 4:
+        if (value & 0x80) {
+            trigger(channel);
+        }
+        break;
+    }
+}
+
+void RegisterModel::step(uint8_t cycles) {
+    if (!powered) {
+        return;
+    }
+    sequencerCycles += cycles;
+    if (sequencerCycles < FrameSequencerPeriod) {
+        return;
+    }
+    sequencerCycles -= FrameSequencerPeriod;
+    if ((sequencerStep & 0x1) == 0) {
+        clockLengthCounters();
+    }
+    if (sequencerStep == 2 || sequencerStep == 6) {
+        clockSweep();
+    }
+    sequencerStep = (sequencerStep + 1) & 0x7;
+}
+
+void RegisterModel::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(registers);
+    writer.write(powered);
+    writer.write(enabledChannels);
+    writer.write(lengthCounters);
+    writer.write(sequencerCycles);
+    writer.write(sequencerStep);
+    writer.write(shadowFrequency);
+    writer.write(sweepTimer);
+    writer.write(sweepEnabled);
+}
+
+void RegisterModel::loadState(Core::SaveState::Reader &reader) {
+    reader.read(registers);
+    reader.read(powered);
+    reader.read(enabledChannels);
+    reader.read(lengthCounters);
+    reader.read(sequencerCycles);
+    reader.read(sequencerStep);
+    reader.read(shadowFrequency);
+    reader.read(sweepTimer);
+    reader.read(sweepEnabled);
+}
+
+void RegisterModel::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(registers) + sizeof(powered) + sizeof(enabledChannels) + sizeof(lengthCounters) +
+                     sizeof(sequencerCycles) + sizeof(sequencerStep) + sizeof(shadowFrequency) + sizeof(sweepTimer) +
+                     sizeof(sweepEnabled));
+}
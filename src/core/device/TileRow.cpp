@@ -0,0 +1,74 @@
+#include "core/device/TileRow.hpp"
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__)
+#include <emmintrin.h>
+#endif
+#if defined(__aarch64__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+using namespace Core::Device::PictureProcessingUnit;
+
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "ExpandedBitsTable is laid out for little endian hosts");
+
+void TileRow::decodeScalar(const uint8_t *lower, const uint8_t *upper, uint8_t count, uint8_t *colorIndices) {
+    for (uint8_t i = 0; i < count; i++) {
+        uint64_t row = ExpandedBitsTable[lower[i]] | (ExpandedBitsTable[upper[i]] << 1);
+        memcpy(colorIndices + i * 8, &row, sizeof(row));
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2")))
+void TileRow::decodeSSE2(const uint8_t *lower, const uint8_t *upper, uint8_t count, uint8_t *colorIndices) {
+    const __m128i masks = _mm_set_epi8(0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80, 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, (char)0x80);
+    const __m128i ones = _mm_set1_epi8(0x1);
+    const __m128i twos = _mm_set1_epi8(0x2);
+    uint8_t i = 0;
+    // 8 tile rows per iteration, every bit plane byte is broadcast to the 8
+    // lanes of its pixels and tested against the mask of each pixel
+    for (; (i + 8) <= count; i += 8) {
+        __m128i lowerBytes = _mm_loadl_epi64((const __m128i *)(lower + i));
+        __m128i upperBytes = _mm_loadl_epi64((const __m128i *)(upper + i));
+        __m128i lower16 = _mm_unpacklo_epi8(lowerBytes, lowerBytes);
+        __m128i upper16 = _mm_unpacklo_epi8(upperBytes, upperBytes);
+        __m128i lowerHalves[2] = { _mm_unpacklo_epi16(lower16, lower16), _mm_unpackhi_epi16(lower16, lower16) };
+        __m128i upperHalves[2] = { _mm_unpacklo_epi16(upper16, upper16), _mm_unpackhi_epi16(upper16, upper16) };
+        for (uint8_t half = 0; half < 2; half++) {
+            __m128i lowerPairs[2] = { _mm_unpacklo_epi32(lowerHalves[half], lowerHalves[half]), _mm_unpackhi_epi32(lowerHalves[half], lowerHalves[half]) };
+            __m128i upperPairs[2] = { _mm_unpacklo_epi32(upperHalves[half], upperHalves[half]), _mm_unpackhi_epi32(upperHalves[half], upperHalves[half]) };
+            for (uint8_t pair = 0; pair < 2; pair++) {
+                __m128i lowerBits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(lowerPairs[pair], masks), masks), ones);
+                __m128i upperBits = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(upperPairs[pair], masks), masks), twos);
+                _mm_storeu_si128((__m128i *)(colorIndices + (i + half * 4 + pair * 2) * 8), _mm_or_si128(lowerBits, upperBits));
+            }
+        }
+    }
+    decodeScalar(lower + i, upper + i, count - i, colorIndices + i * 8);
+}
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON)
+void TileRow::decodeNEON(const uint8_t *lower, const uint8_t *upper, uint8_t count, uint8_t *colorIndices) {
+    static const uint8_t pixelMasks[8] = { 0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01 };
+    const uint8x8_t masks = vld1_u8(pixelMasks);
+    const uint8x8_t ones = vdup_n_u8(0x1);
+    const uint8x8_t twos = vdup_n_u8(0x2);
+    for (uint8_t i = 0; i < count; i++) {
+        uint8x8_t lowerBits = vand_u8(vtst_u8(vdup_n_u8(lower[i]), masks), ones);
+        uint8x8_t upperBits = vand_u8(vtst_u8(vdup_n_u8(upper[i]), masks), twos);
+        vst1_u8(colorIndices + i * 8, vorr_u8(lowerBits, upperBits));
+    }
+}
+#endif
+
+TileRow::Decoder TileRow::selectDecoder() {
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("sse2")) {
+        return decodeSSE2;
+    }
+#elif defined(__aarch64__) || defined(__ARM_NEON)
+    return decodeNEON;
+#endif
+    return decodeScalar;
+}
@@ -1,10 +1,11 @@
 #include "core/device/Timer.hpp"
 #include "common/Timing.hpp"
-#include <bitset>
+#include <algorithm>
+#include <limits>
 
 using namespace Core::Device::Timer;
 
-Controller::Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt) : logger(logLevel, "  [Timer]: "), interrupt(interrupt), DIV(), TIMA(), TMA(), control(), lastResult(), overflown() {
+Controller::Controller(Common::Logs::Level logLevel, std::unique_ptr<Core::Device::Interrupt::Controller> &interrupt, std::unique_ptr<Core::Scheduler::Scheduler> &scheduler) : logger(logLevel, "  [Timer]: "), interrupt(interrupt), scheduler(scheduler), DIV(), TIMA(), TMA(), control(), lastResult(), overflown(), lastSynchronization() {
 
 }
 
@@ -12,7 +13,75 @@ Controller::~Controller() {
 
 }
 
-uint8_t Controller::load(uint16_t offset) const {
+bool Controller::currentResult() const {
+    uint8_t bitPositionForCurrentClock = clocks[control._clock];
+    return ((DIV >> bitPositionForCurrentClock) & 0x1) & control.enable;
+}
+
+uint32_t Controller::stepsUntilFallingEdge() const {
+    if (!control.enable) {
+        return std::numeric_limits<uint32_t>::max();
+    }
+    uint32_t period = 1 << (clocks[control._clock] + 1);
+    uint32_t elapsed = DIV & (period - 1);
+    return (period - elapsed) / 4;
+}
+
+void Controller::tick() {
+    DIV += 4;
+
+    if (overflown) {
+        overflown = false;
+        TIMA = TMA;
+        interrupt->requestInterrupt(Interrupt::TIMER);
+    }
+
+    bool result = currentResult();
+    if (lastResult && !result) {
+        TIMA++;
+        if (TIMA == 0) {
+            overflown = true;
+        }
+    }
+    lastResult = result;
+}
+
+void Controller::synchronize() {
+    uint64_t steps = (scheduler->currentTimestamp() - lastSynchronization) / 4;
+    lastSynchronization += steps * 4;
+    while (steps > 0) {
+        if (!overflown && lastResult == currentResult()) {
+            // Only DIV changes until the selected bit has a falling edge
+            uint64_t skipped = std::min<uint64_t>(steps, stepsUntilFallingEdge() - 1);
+            DIV += skipped * 4;
+            steps -= skipped;
+            lastResult = currentResult();
+            if (steps == 0) {
+                break;
+            }
+        }
+        tick();
+        steps--;
+    }
+}
+
+void Controller::scheduleOverflow() {
+    uint64_t steps;
+    if (overflown || lastResult != currentResult()) {
+        steps = 1;
+    } else if (!control.enable) {
+        scheduler->cancel(Core::Scheduler::TimerOverflow);
+        return;
+    } else {
+        uint64_t period = (1 << (clocks[control._clock] + 1)) / 4;
+        uint64_t increments = 0x100 - TIMA;
+        steps = stepsUntilFallingEdge() + (increments - 1) * period + 1;
+    }
+    scheduler->schedule(Core::Scheduler::TimerOverflow, lastSynchronization + steps * 4);
+}
+
+uint8_t Controller::load(uint16_t offset) {
+    synchronize();
     switch (offset) {
     case 0x0:
         return (DIV & 0xFF00) >> 8;
@@ -29,46 +98,63 @@ uint8_t Controller::load(uint16_t offset) const {
 }
 
 void Controller::store(uint16_t offset, uint8_t value) {
+    synchronize();
     switch (offset) {
     case 0x0:
         DIV = 0;
-        return;
+        break;
     case 0x1:
         TIMA = value;
-        return;
+        break;
     case 0x2:
         TMA = value;
         return;
     case 0x3:
         control._value = value;
-        return;
+        break;
     default:
         logger.logWarning("Unhandled Timer store at offset: %04x with value %02x", offset, value);
         return;
     }
+    scheduleOverflow();
 }
 
-void Controller::step(uint8_t cycles) {
-    uint8_t steps = cycles / 4;
-    while (steps > 0) {
-        DIV += 4;
-        steps--;
+void Controller::handleOverflow() {
+    synchronize();
+    scheduleOverflow();
+}
 
-        if (overflown) {
-            overflown = false;
-            TIMA = TMA;
-            interrupt->requestInterrupt(Interrupt::TIMER);
-        }
+// The pending overflow is part of the scheduler state
+void Controller::saveState(Core::SaveState::Writer &writer) const {
+    writer.write(DIV);
+    writer.write(TIMA);
+    writer.write(TMA);
+    writer.write(control);
+    writer.write(lastResult);
+    writer.write(overflown);
+    writer.write(lastSynchronization);
+}
 
-        uint8_t bitPositionForCurrentClock = clocks[control._clock];
-        std::bitset<16> dividerBits = std::bitset<16>(DIV);
-        bool result = dividerBits.test(bitPositionForCurrentClock) & control.enable;
-        if (lastResult && !result) {
-            TIMA++;
-            if (TIMA == 0) {
-                overflown = true;
-            }
-        }
-        lastResult = result;
-    }
+void Controller::loadState(Core::SaveState::Reader &reader) {
+    reader.read(DIV);
+    reader.read(TIMA);
+    reader.read(TMA);
+    reader.read(control);
+    reader.read(lastResult);
+    reader.read(overflown);
+    reader.read(lastSynchronization);
+}
+
+void Controller::validateState(Core::SaveState::Reader &reader) const {
+    reader.skipBytes(sizeof(DIV) + sizeof(TIMA) + sizeof(TMA) + sizeof(control) + sizeof(lastResult) + sizeof(overflown) + sizeof(lastSynchronization));
+}
+
+void Controller::copyState(const Controller &other) {
+    DIV = other.DIV;
+    TIMA = other.TIMA;
+    TMA = other.TMA;
+    control = other.control;
+    lastResult = other.lastResult;
+    overflown = other.overflown;
+    lastSynchronization = other.lastSynchronization;
 }
@@ -14,10 +14,11 @@ ArgumentParser::~ArgumentParser() {
 }
 
 void Shinobu::Program::ArgumentParser::printUsage() const {
-    logger.logDebug("Usage: shinobu [-s] [-d] [-h] filepath");
+    logger.logDebug("Usage: shinobu [-s] [-d] [-t] [-h] filepath");
     logger.logDebug("");
     logger.logDebug("  -s   skip BOOT ROM, only supported by DMG emulation");
     logger.logDebug("  -d   disassemble, a `filepath.s` file will be created");
+    logger.logDebug("  -t   turbo, run as fast as possible without audio (toggle with T)");
     logger.logDebug("  -h   print this message");
     logger.logDebug("");
 }
@@ -26,8 +27,9 @@ Shinobu::Program::Configuration ArgumentParser::parse(int argc, char* argv[]) co
     int c;
     bool skipBootROM = false;
     bool disassemble = false;
+    bool turbo = false;
     std::filesystem::path ROMFilePath;
-    while ((c = getopt(argc, argv, "sdh")) != -1) {
+    while ((c = getopt(argc, argv, "sdth")) != -1) {
         switch (c) {
         case 's':
             skipBootROM = true;
@@ -35,6 +37,9 @@ Shinobu::Program::Configuration ArgumentParser::parse(int argc, char* argv[]) co
         case 'd':
             disassemble = true;
             break;
+        case 't':
+            turbo = true;
+            break;
         case 'h':
             printUsage();
             exit(0);
@@ -59,5 +64,5 @@ Shinobu::Program::Configuration ArgumentParser::parse(int argc, char* argv[]) co
         logger.logDebug("The filepath provided as argument: %s doesn't exist.", ROMFilePath.c_str());
         exit(1);
     }
-    return { ROMFilePath, skipBootROM, disassemble };
+    return { ROMFilePath, skipBootROM, disassemble, turbo };
 }
@@ -25,6 +25,8 @@ Configuration::Manager::Manager() : logger(Common::Logs::Logger(Common::Logs::Le
     dmgBootstrapROM(),
     cgbBootstrapROM(),
     colorCorrection(true),
+    rewindInterval(4),
+    rewindBuffer(32),
     screenDoorEffect(false),
     forceIntegerScale(false),
     sentryDSN(""),
@@ -126,6 +128,14 @@ bool Configuration::Manager::shouldCorrectColors() const {
     return colorCorrection;
 }
 
+int Configuration::Manager::rewindSnapshotInterval() const {
+    return rewindInterval;
+}
+
+int Configuration::Manager::rewindBufferSize() const {
+    return rewindBuffer;
+}
+
 bool Configuration::Manager::shouldEmulateScreenDoorEffect() const {
     return screenDoorEffect;
 }
@@ -170,6 +180,8 @@ void Configuration::Manager::setupConfigurationFile() const {
     emulationConfiguration["CGBBootstrapROM"] = "CGB_ROM.BIN";
     emulationConfiguration["DMGBootstrapROM"] = "DMG_ROM.BIN";
     emulationConfiguration["colorCorrection"] = "true";
+    emulationConfiguration["rewindInterval"] = "4";
+    emulationConfiguration["rewindBufferSize"] = "32";
     Yaml::Node logConfiguration = Yaml::Node();
     Yaml::Node &logConfigurationRef = logConfiguration;
     logConfigurationRef["CPU"] = "NOLOG";
@@ -225,6 +237,9 @@ void Configuration::Manager::loadConfiguration() {
     dmgBootstrapROM = configuration["emulation"]["DMGBootstrapROM"].As<std::string>();
     cgbBootstrapROM = configuration["emulation"]["CGBBootstrapROM"].As<std::string>();
     colorCorrection = configuration["emulation"]["colorCorrection"].As<bool>();
+    // Configuration files written before rewind support keep the defaults
+    rewindInterval = configuration["emulation"]["rewindInterval"].As<int>(rewindInterval);
+    rewindBuffer = configuration["emulation"]["rewindBufferSize"].As<int>(rewindBuffer);
     sentryDSN = configuration["sentry"]["dsn"].As<std::string>();
     controllerName = configuration["input"]["controllerName"].As<std::string>();
     std::filesystem::remove(Common::Logs::filePath);
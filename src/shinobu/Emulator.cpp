@@ -1,7 +1,6 @@
 #include "shinobu/Emulator.hpp"
 #include <iostream>
 #include "shinobu/Configuration.hpp"
-#include "core/device/PictureProcessingUnit.hpp"
 #include <glad/glad.h>
 #include "common/System.hpp"
 #include "shinobu/frontend/sdl2/Renderer.hpp"
@@ -9,12 +8,14 @@
 #include "common/Performance.hpp"
 #include "shinobu/frontend/sdl2/Renderer.hpp"
 #include <stdexcept>
+#include <thread>
+#include <fstream>
+#include <algorithm>
 
 using namespace Shinobu::Program;
 
-Emulator::Emulator() : logger(Common::Logs::Level::Message, ""), currentFrameCycles(), frameCounter(), frameTime(SDL_GetTicks()), frameTimes(), soundQueue(), isMuted(), stopEmulation() {
+Emulator::Emulator() : logger(Common::Logs::Level::Message, ""), currentFrameCycles(), frameCounter(), frameTime(SDL_GetTicks()), frameTimes(), frameInstructions(), nextFrameTime(std::chrono::steady_clock::now()), isMuted(), turbo(), rewinding(), stopEmulation() {
     Shinobu::Configuration::Manager *configurationManager = Shinobu::Configuration::Manager::getInstance();
-    paletteSelector = std::make_unique<Shinobu::Frontend::Palette::Selector>(configurationManager->paletteIndex());
 
     setupSDL(configurationManager->openGLLogLevel() != Common::Logs::Level::NoLog);
 
@@ -39,38 +40,51 @@ Emulator::Emulator() : logger(Common::Logs::Level::Message, ""), currentFrameCyc
     window = std::make_unique<Shinobu::Frontend::SDL2::Window>("しのぶ", width, heigth, configurationManager->shouldLaunchFullscreen());
     setupOpenGL();
 
-    interrupt = std::make_unique<Core::Device::Interrupt::Controller>(configurationManager->interruptLogLevel());
-    DMA = std::make_unique<Core::Device::DirectMemoryAccess::Controller>(configurationManager->DMALogLevel());
-    PPU = std::make_unique<Core::Device::PictureProcessingUnit::Processor>(configurationManager->PPULogLevel(), configurationManager->shouldCorrectColors(), interrupt, paletteSelector, DMA);
+    Core::Machine::Configuration machineConfiguration = Core::Machine::Configuration();
+    machineConfiguration.CPULogLevel = configurationManager->CPULogLevel();
+    machineConfiguration.memoryLogLevel = configurationManager->memoryLogLevel();
+    machineConfiguration.ROMLogLevel = configurationManager->ROMLogLevel();
+    machineConfiguration.PPULogLevel = configurationManager->PPULogLevel();
+    machineConfiguration.serialLogLevel = configurationManager->serialLogLevel();
+    machineConfiguration.disassemblerLogLevel = configurationManager->disassemblerLogLevel();
+    machineConfiguration.interruptLogLevel = configurationManager->interruptLogLevel();
+    machineConfiguration.timerLogLevel = configurationManager->timerLogLevel();
+    machineConfiguration.joypadLogLevel = configurationManager->joypadLogLevel();
+    machineConfiguration.soundLogLevel = configurationManager->soundLogLevel();
+    machineConfiguration.DMALogLevel = configurationManager->DMALogLevel();
+    machineConfiguration.mute = isMuted;
+    machineConfiguration.overrideCGBFlag = configurationManager->shouldOverrideCGBFlag();
+    machineConfiguration.correctColors = configurationManager->shouldCorrectColors();
+    machineConfiguration.paletteIndex = configurationManager->paletteIndex();
+    machineConfiguration.DMGBootstrapROM = configurationManager->DMGBootstrapROM();
+    machineConfiguration.CGBBootstrapROM = configurationManager->CGBBootstrapROM();
+    machine = std::make_unique<Core::Machine::Machine>(machineConfiguration);
+    size_t rewindBufferSize = (size_t)std::max(configurationManager->rewindBufferSize(), 0) * 1024 * 1024;
+    rewindBuffer = std::make_unique<Core::Rewind::Buffer>(Common::Logs::Level::Warning, std::max(configurationManager->rewindSnapshotInterval(), 0), rewindBufferSize);
 
     switch (frontend) {
     case Shinobu::Frontend::Kind::PPU:
-        renderer = std::make_unique<Shinobu::Frontend::Imgui::Renderer>(window, PPU);
+        renderer = std::make_unique<Shinobu::Frontend::Imgui::Renderer>(window, machine->getPPU());
         break;
     case Shinobu::Frontend::Kind::SDL:
-        renderer = std::make_unique<Shinobu::Frontend::SDL2::Renderer>(window, PPU);
+        renderer = std::make_unique<Shinobu::Frontend::SDL2::Renderer>(window, machine->getPPU());
         break;
     case Shinobu::Frontend::Kind::Unknown:
         logger.logError("Unknown frontend configuration");
         break;
     }
-    PPU->setRenderer(renderer.get());
+    machine->getPPU()->setRenderer(renderer.get());
 
-    sound = std::make_unique<Core::Device::Sound::Controller>(configurationManager->soundLogLevel(), isMuted);
-    sound->setSampleRate(SampleRate);
-    timer = std::make_unique<Core::Device::Timer::Controller>(configurationManager->timerLogLevel(), interrupt);
-    joypad = std::make_unique<Core::Device::JoypadInput::Controller>(configurationManager->joypadLogLevel(), interrupt, configurationManager->gameControllerName());
-    cartridge = std::make_unique<Core::ROM::Cartridge>(configurationManager->ROMLogLevel(), configurationManager->shouldOverrideCGBFlag());
-    memoryController = std::make_unique<Core::Memory::Controller>(configurationManager->memoryLogLevel(), cartridge, PPU, sound, interrupt, timer, joypad, DMA);
-    processor = std::make_unique<Core::CPU::Processor>(configurationManager->CPULogLevel(), memoryController, interrupt);
-    disassembler = std::make_unique<Core::CPU::Disassembler::Disassembler>(configurationManager->disassemblerLogLevel(), processor);
-    PPU->setMemoryController(memoryController);
-    DMA->setMemoryController(memoryController);
+    gameController = std::make_unique<Shinobu::Frontend::SDL2::GameController>(Common::Logs::Level::Warning, configurationManager->gameControllerName());
+    machine->getJoypad()->setInputSource(gameController.get());
 
-    soundQueue.start(SampleRate, 2);
+    audioDevice = std::make_unique<Shinobu::Frontend::SDL2::AudioDevice>(configurationManager->soundLogLevel());
 }
 
 Emulator::~Emulator() {
+    machine->getPPU()->setRenderer(nullptr);
+    renderer.reset();
+    audioDevice.reset();
     SDL_Quit();
 }
 
@@ -90,15 +104,30 @@ void Emulator::setupOpenGL() const {
 }
 
 void Emulator::enqueueSound() {
-    static blip_sample_t buffer[AudioBufferSize];
-    long count = sound->readSamples(buffer, AudioBufferSize);
-    soundQueue.write(buffer, count);
+    static blip_sample_t buffer[AudioRingBufferSize];
+    long count = machine->getSound()->readSamples(buffer, AudioRingBufferSize);
+    audioDevice->write(buffer, count);
+    machine->getSound()->setRateAdjustment(audioDevice->rateAdjustment());
 }
 
-void Emulator::updateCurrentFrameCycles(uint8_t cycles) {
+// Emulation is paced by the wall clock one video frame at a time, the
+// audio rate control absorbs the drift between it and the audio device.
+void Emulator::waitForNextFrame() {
+    const std::chrono::nanoseconds frameDuration = std::chrono::nanoseconds((uint64_t)CyclesPerFrame * 1000000000 / CyclesPerSecond);
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    nextFrameTime += frameDuration;
+    // Too far behind to catch up, e.g. after turbo or a stalled window
+    if (nextFrameTime + frameDuration * 4 < now) {
+        nextFrameTime = now;
+        return;
+    }
+    std::this_thread::sleep_until(nextFrameTime);
+}
+
+bool Emulator::updateCurrentFrameCycles(uint8_t cycles) {
     currentFrameCycles += cycles;
     if (currentFrameCycles < CyclesPerFrame) {
-        return;
+        return false;
     }
     currentFrameCycles %= CyclesPerFrame;
     frameCounter++;
@@ -107,13 +136,27 @@ void Emulator::updateCurrentFrameCycles(uint8_t cycles) {
     if (frameCounter >= 60) {
         frameCounter = 0;
         float averageFrameTime = (float)frameTimes / 60.0f;
-        Common::Performance::Frame frame = { averageFrameTime, (float)frameTimes };
+        float framesPerSecond = frameTimes > 0 ? 60000.0f / (float)frameTimes : 0.0f;
+        uint64_t executedInstructions = machine->getExecutedInstructions();
+        float millionInstructionsPerSecond = frameTimes > 0 ? (float)(executedInstructions - frameInstructions) / ((float)frameTimes * 1000.0f) : 0.0f;
+        frameInstructions = executedInstructions;
+        Common::Performance::Frame frame = { averageFrameTime, (float)frameTimes, framesPerSecond, millionInstructionsPerSecond, audioDevice->fillLevel() };
         window->updateWindowTitleWithFramePerformance(frame);
         if (renderer->frontendKind() == Shinobu::Frontend::Kind::SDL) {
             dynamic_cast<Shinobu::Frontend::SDL2::Renderer*>(renderer.get())->setLastPerformanceFrame(frame);
         }
         frameTimes = 0;
     }
+    return true;
+}
+
+void Emulator::setTurbo(bool enabled) {
+    if (turbo == enabled) {
+        return;
+    }
+    turbo = enabled;
+    machine->getSound()->setTurbo(turbo);
+    renderer->setTurbo(turbo);
 }
 
 static void *invalid_mem = (void *)1;
@@ -121,29 +164,64 @@ void Emulator::crash() const {
     memset((char *)invalid_mem, 1, 100);
 }
 
+void Emulator::saveState() const {
+    std::vector<uint8_t> state;
+    machine->saveState(state);
+    std::filesystem::path filePath = machine->getCartridge()->saveStateFilePath();
+    std::ofstream file = std::ofstream();
+    file.open(filePath, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        logger.logWarning("Unable to write save state at path: %s", filePath.string().c_str());
+        return;
+    }
+    file.write(reinterpret_cast<char *>(state.data()), state.size());
+    file.close();
+    logger.logMessage("Saved state to path: %s", filePath.string().c_str());
+}
+
+void Emulator::loadState() {
+    std::filesystem::path filePath = machine->getCartridge()->saveStateFilePath();
+    std::ifstream file = std::ifstream();
+    file.open(filePath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        logger.logWarning("No save state found at path: %s", filePath.string().c_str());
+        return;
+    }
+    std::vector<uint8_t> state = std::vector<uint8_t>(file.tellg());
+    file.seekg(0, file.beg);
+    file.read(reinterpret_cast<char *>(state.data()), state.size());
+    file.close();
+    if (!machine->loadState(state)) {
+        return;
+    }
+    currentFrameCycles = 0;
+    nextFrameTime = std::chrono::steady_clock::now();
+    logger.logMessage("Loaded state from path: %s", filePath.string().c_str());
+}
+
 void Emulator::configure(Shinobu::Program::Configuration configuration) {
-    cartridge->open(configuration.ROMFilePath);
-    PPU->setCGBFlag(cartridge->cgbFlag());
+    machine->load(configuration.ROMFilePath, configuration.skipBootROM);
     window->setROMFilename(configuration.ROMFilePath.filename().string());
-    memoryController->initialize(configuration.skipBootROM);
-    processor->initialize();
     if (configuration.disassemble) {
-        disassembler->configure();
+        machine->getDisassembler()->configure();
     }
+    setTurbo(configuration.turbo);
 }
 
 void Emulator::emulate() {
     try {
-        while (sound->availableSamples() <= AudioBufferSize) {
-            Core::CPU::Instructions::Instruction instruction = processor->fetchInstruction();
-            disassembler->disassembleWhileExecuting(instruction);
-            Core::CPU::Instructions::InstructionHandler<void> handler = processor->decodeInstruction<void>(instruction);
-            handler(processor, instruction);
-            joypad->updateJoypad();
-            processor->checkPendingInterrupts(instruction);
-            updateCurrentFrameCycles(memoryController->elapsedCycles());
+        if (rewinding) {
+            rewindBuffer->rewind(*machine);
+        }
+        while (!updateCurrentFrameCycles(machine->step())) {}
+        if (!rewinding) {
+            rewindBuffer->frame(*machine);
+        }
+        if (turbo) {
+            return;
         }
         enqueueSound();
+        waitForNextFrame();
     } catch(...) {
         stopEmulation = true;
     }
@@ -155,34 +233,50 @@ void Emulator::handleSDLEvent(SDL_Event event) {
         return;
     }
     if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_m) {
-        sound->toggleMute();
+        machine->getSound()->toggleMute();
+        return;
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_t) {
+        setTurbo(!turbo);
         return;
     }
     if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_d) {
-        disassembler->toggleEnabled();
+        machine->getDisassembler()->toggleEnabled();
         return;
     }
     if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_DELETE) {
         crash();
         return;
     }
-    if (joypad->hasGameController()) {
+    if ((event.type == SDL_KEYDOWN || event.type == SDL_KEYUP) && event.key.keysym.sym == SDLK_BACKSPACE) {
+        rewinding = event.type == SDL_KEYDOWN;
+        return;
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F5) {
+        saveState();
+        return;
+    }
+    if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F7) {
+        loadState();
+        return;
+    }
+    if (gameController->hasGameController()) {
         // TODO: Use Controller events API instead of Joypad
         if (event.type == SDL_JOYBUTTONDOWN && (event.button.which == 260 || event.button.which == 262)) {
-            paletteSelector->backwardSelector();
+            machine->getPaletteSelector()->backwardSelector();
             return;
         }
         if (event.type == SDL_JOYBUTTONDOWN && (event.button.which == 261 || event.button.which == 263)) {
-            paletteSelector->forwardSelector();
+            machine->getPaletteSelector()->forwardSelector();
             return;
         }
     } else {
         if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_q) {
-            paletteSelector->backwardSelector();
+            machine->getPaletteSelector()->backwardSelector();
             return;
         }
         if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_e) {
-            paletteSelector->forwardSelector();
+            machine->getPaletteSelector()->forwardSelector();
             return;
         }
     }
@@ -199,7 +293,7 @@ bool Emulator::shouldExit() const {
 }
 
 void Emulator::saveExternalRAM() const {
-    memoryController->saveExternalRAM();
+    machine->getMemoryController()->saveExternalRAM();
 }
 
 void Emulator::flushLogs() const {
@@ -208,12 +302,13 @@ void Emulator::flushLogs() const {
 
 void Emulator::disassemble() {
     std::stringstream stream = std::stringstream();
+    std::unique_ptr<Core::CPU::Disassembler::Disassembler> &disassembler = machine->getDisassembler();
     while (disassembler->canDisassemble()) {
-        Core::CPU::Instructions::Instruction instruction = processor->fetchInstruction();
+        Core::CPU::Instructions::Instruction instruction = machine->getProcessor()->fetchInstruction();
         stream << disassembler->disassemble(instruction);
         stream << std::endl;
     }
-    std::filesystem::path disassemblyFilePath = cartridge->disassemblyFilePath();
+    std::filesystem::path disassemblyFilePath = machine->getCartridge()->disassemblyFilePath();
     std::ofstream logfile = std::ofstream();
     logfile.open(disassemblyFilePath);
     logfile << stream.str();
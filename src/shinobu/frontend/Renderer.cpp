@@ -11,10 +11,19 @@ Kind Shinobu::Frontend::kindWithValue(std::string value) {
     return Kind::Unknown;
 }
 
-Renderer::Renderer(std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window, std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU) : window(window), PPU(PPU) {
+Renderer::Renderer(std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window, std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU) : window(window), PPU(PPU), defaultSwapInterval() {
 
 }
 
 Renderer::~Renderer() {
 
 }
+
+void Renderer::setTurbo(bool enabled) {
+    if (enabled) {
+        defaultSwapInterval = SDL_GL_GetSwapInterval();
+        SDL_GL_SetSwapInterval(0);
+    } else {
+        SDL_GL_SetSwapInterval(defaultSwapInterval);
+    }
+}
@@ -36,6 +36,7 @@ Renderer::~Renderer() {
 }
 
 void Renderer::update() {
+    window->updateViewport();
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplSDL2_NewFrame(window->windowRef());
     ImGui::NewFrame();
@@ -68,9 +69,9 @@ void Renderer::update() {
         }
         ImGui::End();
         if (ImGui::Begin("LCD Output", NULL, ImGuiWindowFlags_NoResize)) {
-            auto textureData = PPU->getLCDData();
+            const Core::Device::PictureProcessingUnit::Framebuffer &textureData = PPU->getLCDData();
             LCDOutputTexture.bind(GL_TEXTURE0);
-            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, HorizontalResolution, VerticalResolution, GL_RGB,  GL_FLOAT, textureData.data());
+            glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, HorizontalResolution, VerticalResolution, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV, textureData.data());
             ImVec2 size = ImVec2(static_cast<float>(HorizontalResolution * PixelScale), static_cast<float>(VerticalResolution * PixelScale));
             ImGui::Image(reinterpret_cast<ImTextureID>(LCDOutputTexture.getObject()), size);
         }
@@ -64,20 +64,25 @@ uint32_t Buffer<T>::remainingCapacity() const {
 
 template <class T>
 void Buffer<T>::draw(GLenum mode) {
+    drawKeepingData(mode);
+    clean();
+}
+
+template <class T>
+void Buffer<T>::drawKeepingData(GLenum mode) const {
     vao->bind();
     program->useProgram();
     glDrawArrays(mode, 0, (GLsizei)size);
-    clean();
 }
 
 template <>
 void Buffer<Vertex>::enableAttributes() const {
     GLuint positionIdx = program->findProgramAttribute("position");
-    glVertexAttribPointer(positionIdx, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(struct Vertex, position));
+    glVertexAttribPointer(positionIdx, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
     glEnableVertexAttribArray(positionIdx);
 
     GLuint colorIdx = program->findProgramAttribute("color");
-    glVertexAttribPointer(colorIdx, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(struct Vertex, color));
+    glVertexAttribPointer(colorIdx, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
     glEnableVertexAttribArray(colorIdx);
 }
 
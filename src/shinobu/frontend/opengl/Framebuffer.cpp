@@ -7,14 +7,23 @@ Framebuffer::Framebuffer(Texture &texture) : Framebuffer(texture.getObject(), te
 
 }
 
-Framebuffer::Framebuffer(GLuint texture, GLsizei width, GLsizei height) {
+Framebuffer::Framebuffer(GLuint texture, GLsizei width, GLsizei height) : width(width), height(height) {
     glGenFramebuffers(1, &object);
     glBindFramebuffer(GL_FRAMEBUFFER, object);
     glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
     glDrawBuffer(GL_COLOR_ATTACHMENT0);
-    glViewport(0, 0, width, height);
+    unbind();
 }
 
 Framebuffer::~Framebuffer() {
     glDeleteFramebuffers(1, &object);
 }
+
+void Framebuffer::bind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, object);
+    glViewport(0, 0, width, height);
+}
+
+void Framebuffer::unbind() const {
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
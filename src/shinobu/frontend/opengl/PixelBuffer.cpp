@@ -0,0 +1,42 @@
+#include "shinobu/frontend/opengl/PixelBuffer.hpp"
+
+using namespace Shinobu::Frontend::OpenGL;
+
+PixelBuffer::PixelBuffer(GLsizeiptr size) : objects(), size(size), current() {
+    glGenBuffers(PixelBufferCount, objects.data());
+    for (const auto& object : objects) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, object);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+PixelBuffer::~PixelBuffer() {
+    glDeleteBuffers(PixelBufferCount, objects.data());
+}
+
+uint8_t *PixelBuffer::map() {
+    current = (current + 1) % PixelBufferCount;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, objects[current]);
+    // Invalidating lets the driver hand out fresh storage instead of waiting
+    // for a pending texture upload that still reads the old contents
+    uint8_t *data = static_cast<uint8_t *>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+    if (data == nullptr) {
+        unbind();
+    }
+    return data;
+}
+
+// The contents are undefined when unmapping fails, e.g. after a video mode
+// change, they can't be uploaded
+bool PixelBuffer::unmap() const {
+    if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_FALSE) {
+        unbind();
+        return false;
+    }
+    return true;
+}
+
+void PixelBuffer::unbind() const {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
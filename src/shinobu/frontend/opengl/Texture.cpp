@@ -2,14 +2,18 @@
 
 using namespace Shinobu::Frontend::OpenGL;
 
-Texture::Texture(GLsizei width, GLsizei height) : width(width), height(height) {
+Texture::Texture(GLsizei width, GLsizei height) : Texture(width, height, GL_RGB5_A1) {
+
+}
+
+Texture::Texture(GLsizei width, GLsizei height, GLenum internalFormat) : width(width), height(height) {
     glGenTextures(1, &object);
     glBindTexture(GL_TEXTURE_2D, object);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGB5_A1, width, height);
+    glTexStorage2D(GL_TEXTURE_2D, 1, internalFormat, width, height);
 }
 
 Texture::~Texture() {
@@ -1,7 +1,8 @@
 #include "shinobu/frontend/opengl/TextureRenderer.hpp"
 #include "shinobu/frontend/opengl/debug/Debugger.hpp"
-#include "shinobu/frontend/opengl/Framebuffer.hpp"
 #include "shinobu/frontend/opengl/Shaders.hpp"
+#include "common/System.hpp"
+#include <cstring>
 
 using namespace Shinobu::Frontend::OpenGL;
 
@@ -14,6 +15,36 @@ TextureRenderer::TextureRenderer(uint32_t width, uint32_t height, bool applyScal
 
     texture = std::make_unique<Texture>(width, height);
     buffer = std::make_unique<Buffer<Texel>>(program, 4);
+    // The quads never change, they are uploaded once and drawn every frame
+    std::array<Texel, 4> data = {
+        Texel({{-1.0f, -1.0f}, {0.0f, 1.0f}}),
+        Texel({{1.0f, -1.0f}, {1.0f, 1.0f}}),
+        Texel({{-1.0f, 1.0f}, {0.0f, 0.0f}}),
+        Texel({{1.0f, 1.0f}, {1.0f, 0.0f}}),
+    };
+    buffer->addData(data.data(), data.size());
+
+    paletteProgram = std::make_unique<Program>(Shaders::textureVertex, Shaders::paletteFragment);
+    paletteProgram->useProgram();
+
+    glUniform1i(paletteProgram->findProgramUniform("colorIndices"), 0);
+    glUniform1i(paletteProgram->findProgramUniform("linePalettes"), 1);
+
+    colorIndexTexture = std::make_unique<Texture>(width, height, GL_R8UI);
+    linePaletteTexture = std::make_unique<Texture>(LinePaletteSize, height, GL_R16UI);
+    paletteBuffer = std::make_unique<Buffer<Texel>>(paletteProgram, 4);
+    std::array<Texel, 4> paletteData = {
+        Texel({{-1.0f, -1.0f}, {0.0f, 0.0f}}),
+        Texel({{1.0f, -1.0f}, {1.0f, 0.0f}}),
+        Texel({{-1.0f, 1.0f}, {0.0f, 1.0f}}),
+        Texel({{1.0f, 1.0f}, {1.0f, 1.0f}}),
+    };
+    paletteBuffer->addData(paletteData.data(), paletteData.size());
+    paletteFramebuffer = std::make_unique<Framebuffer>(*texture);
+
+    pixelBuffer = std::make_unique<PixelBuffer>(width * height * sizeof(uint32_t));
+
+    program->useProgram();
 
     Debug::Debugger *debugger = Debug::Debugger::getInstance();
     debugger->checkForOpenGLErrors();
@@ -22,9 +53,57 @@ TextureRenderer::TextureRenderer(uint32_t width, uint32_t height, bool applyScal
 TextureRenderer::~TextureRenderer() {
 }
 
-void TextureRenderer::addTextureData(std::vector<GLfloat> textureData) const {
+void TextureRenderer::addTextureData(const uint32_t *textureData) const {
+    // Without a mapped pixel buffer the data is uploaded from client memory
+    const void *pixels = textureData;
+    uint8_t *data = pixelBuffer->map();
+    if (data != nullptr) {
+        memcpy(data, textureData, width * height * sizeof(uint32_t));
+        if (pixelBuffer->unmap()) {
+            pixels = nullptr;
+        }
+    }
+    texture->bind(GL_TEXTURE0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGBA, GL_UNSIGNED_INT_8_8_8_8_REV, pixels);
+    pixelBuffer->unbind();
+    Debug::Debugger *debugger = Debug::Debugger::getInstance();
+    debugger->checkForOpenGLErrors();
+}
+
+void TextureRenderer::addColorIndexData(const uint8_t *colorIndices, const uint16_t *linePalettes, const Core::Palette::palette &shades, bool cgbPalettes, bool correctColors) const {
+    // Both uploads share one pixel buffer, the line palettes follow the indices
+    size_t colorIndicesSize = width * height * sizeof(uint8_t);
+    size_t linePalettesSize = LinePaletteSize * height * sizeof(uint16_t);
+    // Without a mapped pixel buffer both are uploaded from client memory
+    const void *colorIndexPixels = colorIndices;
+    const void *linePalettePixels = linePalettes;
+    uint8_t *data = pixelBuffer->map();
+    if (data != nullptr) {
+        memcpy(data, colorIndices, colorIndicesSize);
+        memcpy(data + colorIndicesSize, linePalettes, linePalettesSize);
+        if (pixelBuffer->unmap()) {
+            colorIndexPixels = nullptr;
+            linePalettePixels = reinterpret_cast<const void *>(colorIndicesSize);
+        }
+    }
+    colorIndexTexture->bind(GL_TEXTURE0);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED_INTEGER, GL_UNSIGNED_BYTE, colorIndexPixels);
+    linePaletteTexture->bind(GL_TEXTURE1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, LinePaletteSize, height, GL_RED_INTEGER, GL_UNSIGNED_SHORT, linePalettePixels);
+    pixelBuffer->unbind();
+
+    paletteProgram->useProgram();
+    glUniform3fv(paletteProgram->findProgramUniform("shades"), shades.size(), &shades[0].r);
+    glUniform1i(paletteProgram->findProgramUniform("cgbPalettes"), cgbPalettes);
+    glUniform1i(paletteProgram->findProgramUniform("correctColors"), correctColors);
+
+    // Resolve the colors into the texture sampled by render()
+    paletteFramebuffer->bind();
+    paletteBuffer->drawKeepingData(GL_TRIANGLE_STRIP);
+    paletteFramebuffer->unbind();
+
+    program->useProgram();
     texture->bind(GL_TEXTURE0);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RGB,  GL_FLOAT, textureData.data());
     Debug::Debugger *debugger = Debug::Debugger::getInstance();
     debugger->checkForOpenGLErrors();
 }
@@ -35,14 +114,7 @@ void TextureRenderer::clear() const {
 }
 
 void TextureRenderer::render() const {
-    std::array<Texel, 4> data = {
-        Texel({{-1.0f, -1.0f}, {0.0f, 1.0f}}),
-        Texel({{1.0f, -1.0f}, {1.0f, 1.0f}}),
-        Texel({{-1.0f, 1.0f}, {0.0f, 0.0f}}),
-        Texel({{1.0f, 1.0f}, {1.0f, 0.0f}}),
-    };
-    buffer->addData(data.data(), data.size());
-    buffer->draw(GL_TRIANGLE_STRIP);
+    buffer->drawKeepingData(GL_TRIANGLE_STRIP);
     Debug::Debugger *debugger = Debug::Debugger::getInstance();
     debugger->checkForOpenGLErrors();
 }
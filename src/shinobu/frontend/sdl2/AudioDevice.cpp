@@ -0,0 +1,63 @@
+#include "shinobu/frontend/sdl2/AudioDevice.hpp"
+#include <algorithm>
+#include <cstring>
+
+using namespace Shinobu::Frontend::SDL2;
+
+AudioDevice::AudioDevice(Common::Logs::Level logLevel) : logger(logLevel, "  [Audio]: "), device(), playing(), samples() {
+    SDL_AudioSpec desired = {};
+    desired.freq = SampleRate;
+    desired.format = AUDIO_S16SYS;
+    desired.channels = 2;
+    desired.samples = AudioCallbackFrames;
+    desired.callback = fillAudio;
+    desired.userdata = this;
+    device = SDL_OpenAudioDevice(NULL, 0, &desired, NULL, 0);
+    if (device == 0) {
+        logger.logWarning("Unable to open audio device: %s", SDL_GetError());
+    }
+}
+
+AudioDevice::~AudioDevice() {
+    if (device != 0) {
+        SDL_CloseAudioDevice(device);
+    }
+}
+
+// Runs on the SDL audio thread
+void AudioDevice::fillAudio(void *userdata, Uint8 *stream, int length) {
+    AudioDevice *audioDevice = static_cast<AudioDevice *>(userdata);
+    size_t count = length / sizeof(int16_t);
+    size_t read = audioDevice->samples.read((int16_t *)stream, count);
+    if (read < count) {
+        memset(stream + read * sizeof(int16_t), 0, (count - read) * sizeof(int16_t));
+    }
+}
+
+void AudioDevice::write(const int16_t *buffer, size_t count) {
+    if (device == 0) {
+        return;
+    }
+    // Playback (re)starts once the ring holds the target latency, so the
+    // callback doesn't drain it right away, e.g. after turbo
+    if (playing && samples.size() == 0) {
+        SDL_PauseAudioDevice(device, 1);
+        playing = false;
+    }
+    samples.write(buffer, count);
+    if (!playing && samples.size() >= AudioBufferSize) {
+        SDL_PauseAudioDevice(device, 0);
+        playing = true;
+    }
+}
+
+float AudioDevice::fillLevel() const {
+    return (float)samples.size() / (float)samples.capacity();
+}
+
+// Relative change to the APU output rate that steers the ring towards the
+// target latency: positive (fewer samples) when it holds more than that.
+double AudioDevice::rateAdjustment() const {
+    double deviation = ((double)samples.size() / (double)AudioBufferSize) - 1.0;
+    return std::clamp(deviation, -1.0, 1.0) * MaximumAudioRateDelta;
+}
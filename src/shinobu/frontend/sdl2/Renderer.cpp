@@ -1,5 +1,6 @@
 #include "shinobu/frontend/sdl2/Renderer.hpp"
 #include <limits>
+#include <chrono>
 #include <imgui/sdl/imgui_impl_sdl.h>
 #include <imgui/opengl3/imgui_impl_opengl3.h>
 #include "common/System.hpp"
@@ -9,13 +10,13 @@
 
 using namespace Shinobu::Frontend::SDL2;
 
-Renderer::Renderer(std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window, std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU) : Shinobu::Frontend::Renderer(window, PPU) {
+Renderer::Renderer(std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window, std::unique_ptr<Core::Device::PictureProcessingUnit::Processor> &PPU) : Shinobu::Frontend::Renderer(window, PPU), frameQueue(), eventQueue(), performanceFrameQueue(), turbo(), running(true), droppedFrames(), presentedFrame(), appliedTurbo() {
     Configuration::Manager *configurationManager = Configuration::Manager::getInstance();
     renderer = std::make_unique<Shinobu::Frontend::OpenGL::TextureRenderer>(HorizontalResolution, VerticalResolution, configurationManager->shouldEmulateScreenDoorEffect());
 
     overlayScale = configurationManager->overlayScale();
 
-    frames.assign(PerformancePlotPoints, { 16.0f, 1000.0f });
+    frames.assign(PerformancePlotPoints, { 16.0f, 1000.0f, 60.0f, 0.0f, 0.0f });
 
     IMGUI_CHECKVERSION();
     ImGui::CreateContext();
@@ -23,23 +24,93 @@ Renderer::Renderer(std::unique_ptr<Shinobu::Frontend::SDL2::Window> &window, std
     io->ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange;
     ImGui_ImplSDL2_InitForOpenGL(window->windowRef(), window->GLContext());
     ImGui_ImplOpenGL3_Init();
+
+    SDL_GL_MakeCurrent(window->windowRef(), nullptr);
+    renderThread = std::thread(&Renderer::renderLoop, this);
 }
 
 Renderer::~Renderer() {
+    running.store(false, std::memory_order_release);
+    renderThread.join();
+    SDL_GL_MakeCurrent(window->windowRef(), window->GLContext());
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplSDL2_Shutdown();
     ImGui::DestroyContext();
 }
 
+// Runs on the emulation thread at VBlank, it never waits for the render
+// thread: when no slot is free the frame is dropped
 void Renderer::update() {
+    Shinobu::Frontend::LCDFrame *frame = frameQueue.writeSlot();
+    if (frame == nullptr) {
+        droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    frame->colorIndices = PPU->getLCDColorIndices();
+    frame->linePalettes = PPU->getLCDLinePalettes();
+    frame->shades = PPU->currentPaletteSelection();
+    frame->CGBPalettes = PPU->usesCGBPalettes();
+    frame->correctColors = PPU->correctsColors();
+    frameQueue.commitWrite();
+}
+
+void Renderer::renderLoop() {
+    SDL_GL_MakeCurrent(window->windowRef(), window->GLContext());
+    bool verticalSync = SDL_GL_GetSwapInterval() != 0;
+    while (running.load(std::memory_order_acquire)) {
+        SDL_Event event;
+        while (eventQueue.pop(event)) {
+            processSDLEvent(event);
+        }
+        Common::Performance::Frame performanceFrame;
+        while (performanceFrameQueue.pop(performanceFrame)) {
+            addPerformanceFrame(performanceFrame);
+        }
+        bool enabled = turbo.load(std::memory_order_acquire);
+        if (enabled != appliedTurbo) {
+            appliedTurbo = enabled;
+            Shinobu::Frontend::Renderer::setTurbo(enabled);
+            verticalSync = SDL_GL_GetSwapInterval() != 0;
+        }
+        bool newFrame = acquireLatestFrame();
+        // Presenting the last frame again is paced by vsync, without it the
+        // loop would only spin until the emulation publishes a new one
+        if (frameQueue.readSlot() == nullptr || (!newFrame && !verticalSync)) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        present(newFrame);
+    }
+    SDL_GL_MakeCurrent(window->windowRef(), nullptr);
+}
+
+// Leaves the newest published frame at the head of the queue, frames that
+// were published after it and never presented are dropped
+bool Renderer::acquireLatestFrame() {
+    while (frameQueue.size() > 1) {
+        if (!presentedFrame) {
+            droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+        frameQueue.commitRead();
+        presentedFrame = false;
+    }
+    return frameQueue.readSlot() != nullptr && !presentedFrame;
+}
+
+void Renderer::present(bool upload) {
+    window->updateViewport();
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplSDL2_NewFrame(window->windowRef());
     ImGui::NewFrame();
 
     renderer->clear();
 
-    auto textureData = PPU->getLCDData();
-    renderer->addTextureData(textureData);
+    if (upload) {
+        const Shinobu::Frontend::LCDFrame *frame = frameQueue.readSlot();
+        renderer->addColorIndexData(frame->colorIndices.data(), frame->linePalettes[0].data(), frame->shades, frame->CGBPalettes, frame->correctColors);
+        window->restoreViewport();
+        presentedFrame = true;
+    }
     renderer->render();
 
     if (overlayScale > 0 && frames.size() >= PerformancePlotPoints) {
@@ -49,7 +120,7 @@ void Renderer::update() {
         ImGui::SetWindowPos(ImVec2(0, 0));
         ImGui::SetWindowFontScale(overlayScale);
         Common::Performance::Frame lastFrame = frames.back();
-        ImGui::Text("Avg: %.2f ms\nElaps: %.2f ms", lastFrame.averageFrameTime, lastFrame.elapsedTime);
+        ImGui::Text("Avg: %.2f ms\nElaps: %.2f ms\nFPS: %.1f\nMIPS: %.2f\nDrop: %llu\nAudio: %.0f%%", lastFrame.averageFrameTime, lastFrame.elapsedTime, lastFrame.framesPerSecond, lastFrame.millionInstructionsPerSecond, (unsigned long long)getDroppedFrames(), lastFrame.audioFillLevel * 100.0f);
         static float values[PerformancePlotPoints] = {};
         int i = 0;
         for (Common::Performance::Frame frame : frames) {
@@ -67,7 +138,19 @@ void Renderer::update() {
     SDL_GL_SwapWindow(window->windowRef());
 }
 
+// The render thread drains the queue on every iteration, so a full queue
+// only means a burst of events. Waiting for a free slot keeps quit, resize
+// and key events from being dropped.
 void Renderer::handleSDLEvent(SDL_Event event) {
+    while (!eventQueue.push(event)) {
+        if (!running.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void Renderer::processSDLEvent(SDL_Event event) {
     if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_LSHIFT) {
         renderer->toggleApplyScale();
         return;
@@ -89,7 +172,19 @@ void Renderer::handleSDLEvent(SDL_Event event) {
     ImGui_ImplSDL2_ProcessEvent(&event);
 }
 
+void Renderer::setTurbo(bool enabled) {
+    turbo.store(enabled, std::memory_order_release);
+}
+
 void Renderer::setLastPerformanceFrame(Common::Performance::Frame frame) {
+    performanceFrameQueue.push(frame);
+}
+
+uint64_t Renderer::getDroppedFrames() const {
+    return droppedFrames.load(std::memory_order_relaxed);
+}
+
+void Renderer::addPerformanceFrame(Common::Performance::Frame frame) {
     frames.push_back(frame);
     minValue = std::min(frame.averageFrameTime, minValue);
     maxValue = std::max(frame.averageFrameTime, maxValue);
@@ -5,7 +5,7 @@
 
 using namespace Shinobu::Frontend::SDL2;
 
-Window::Window(std::string title, uint32_t width, uint32_t height, bool fullscreen) : logger(Common::Logs::Level::NoLog, ""), title(title), ROMfilename(""), width(width), height(height), lastFullscreenViewport(std::nullopt) {
+Window::Window(std::string title, uint32_t width, uint32_t height, bool fullscreen) : logger(Common::Logs::Level::NoLog, ""), title(title), ROMfilename(""), width(width), height(height), lastFullscreenViewport(std::nullopt), pendingResize(0) {
     Uint32 flags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE;
     if (fullscreen) {
         flags |= SDL_WINDOW_FULLSCREEN_DESKTOP;
@@ -76,14 +76,34 @@ void Window::handleSDLEvent(SDL_Event event) {
     }
     switch (event.window.event) {
         case SDL_WINDOWEVENT_SIZE_CHANGED: {
-            handleWindowResize(event.window.data1, event.window.data2);
+            pendingResize.store(((uint64_t)(uint32_t)event.window.data1 << 32) | (uint32_t)event.window.data2, std::memory_order_release);
             break;
         }
     }
 }
 
+void Window::updateViewport() {
+    uint64_t size = pendingResize.exchange(0, std::memory_order_acquire);
+    if (size == 0) {
+        return;
+    }
+    handleWindowResize(size >> 32, size & 0xFFFFFFFF);
+}
+
+// Rendering into textures changes the viewport, it's set back from the last
+// resize without querying GL. Before the first resize it covers the window.
+void Window::restoreViewport() const {
+    if (lastFullscreenViewport) {
+        glViewport(std::get<0>(*lastFullscreenViewport), std::get<1>(*lastFullscreenViewport), std::get<2>(*lastFullscreenViewport), std::get<3>(*lastFullscreenViewport));
+        return;
+    }
+    int drawableWidth, drawableHeight;
+    SDL_GL_GetDrawableSize(window, &drawableWidth, &drawableHeight);
+    glViewport(0, 0, drawableWidth, drawableHeight);
+}
+
 void Window::updateWindowTitleWithFramePerformance(Common::Performance::Frame frame) const {
-    std::string updatedTitle = Common::Formatter::format("%s - %s - %.2f ms - %.2f ms", title.c_str(), ROMfilename.c_str(), frame.averageFrameTime, frame.elapsedTime);
+    std::string updatedTitle = Common::Formatter::format("%s - %s - %.2f ms - %.2f ms - %.1f FPS - %.2f MIPS", title.c_str(), ROMfilename.c_str(), frame.averageFrameTime, frame.elapsedTime, frame.framesPerSecond, frame.millionInstructionsPerSecond);
     SDL_SetWindowTitle(window, updatedTitle.c_str());
 }
 
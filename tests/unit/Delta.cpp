@@ -0,0 +1,116 @@
+#include "Test.hpp"
+#include "common/Delta.hpp"
+
+// Deterministic noise, so failures reproduce
+static uint8_t nextByte(uint32_t &seed) {
+    seed = seed * 1103515245 + 12345;
+    return (uint8_t)(seed >> 16);
+}
+
+// Applying the delta turns either buffer into the other one
+static void checkRoundTrip(const std::vector<uint8_t> &previous, const std::vector<uint8_t> &current, std::vector<uint8_t> &delta) {
+    CHECK(previous.size() == current.size());
+    Common::Delta::encode(previous.data(), current.data(), previous.size(), delta);
+    std::vector<uint8_t> forward = previous;
+    CHECK(Common::Delta::apply(delta, forward.data(), forward.size()));
+    CHECK(forward == current);
+    std::vector<uint8_t> backward = current;
+    CHECK(Common::Delta::apply(delta, backward.data(), backward.size()));
+    CHECK(backward == previous);
+}
+
+static void testIdenticalBuffers() {
+    std::vector<uint8_t> buffer = std::vector<uint8_t>(1000, 0x5A);
+    std::vector<uint8_t> delta;
+    checkRoundTrip(buffer, buffer, delta);
+    CHECK(delta.empty());
+}
+
+static void testRandomEdits() {
+    uint32_t seed = 0x1234;
+    std::vector<uint8_t> delta;
+    for (size_t length : { 1, 7, 8, 9, 63, 64, 65, 4096, 25000 }) {
+        std::vector<uint8_t> previous = std::vector<uint8_t>(length);
+        for (uint8_t &byte : previous) {
+            byte = nextByte(seed);
+        }
+        for (size_t edits : { 1, 3, 50 }) {
+            std::vector<uint8_t> current = previous;
+            for (size_t edit = 0; edit < edits; edit++) {
+                current[(nextByte(seed) << 8 | nextByte(seed)) % length] ^= nextByte(seed) | 1;
+            }
+            checkRoundTrip(previous, current, delta);
+        }
+    }
+}
+
+// Short gaps stay inside the changed run, longer ones split it
+static void testUnchangedGaps() {
+    std::vector<uint8_t> delta;
+    for (size_t gap = 0; gap < 12; gap++) {
+        std::vector<uint8_t> previous = std::vector<uint8_t>(64, 0x00);
+        std::vector<uint8_t> current = previous;
+        current[10] = 0xFF;
+        current[11 + gap] = 0xFF;
+        checkRoundTrip(previous, current, delta);
+        size_t changed = gap < Common::Delta::MinimumUnchangedRun ? gap + 2 : 2;
+        CHECK(std::count(delta.begin(), delta.end(), 0xFF) == 2);
+        CHECK(delta.size() == (gap < Common::Delta::MinimumUnchangedRun ? 2 + changed : 6));
+    }
+}
+
+// Lengths are LEB128, 127 fits in a byte and 128 takes two
+static void testLengthEncodingBoundaries() {
+    std::vector<uint8_t> delta;
+    for (size_t run : { 126, 127, 128, 129, 16383, 16384, 16385 }) {
+        std::vector<uint8_t> previous = std::vector<uint8_t>(run * 2 + 16, 0x00);
+        std::vector<uint8_t> current = previous;
+        std::fill(current.begin() + run, current.begin() + run * 2, 0xA5);
+        checkRoundTrip(previous, current, delta);
+        size_t lengthBytes = run < 0x80 ? 1 : (run < 0x4000 ? 2 : 3);
+        CHECK(delta.size() == lengthBytes * 2 + run);
+    }
+}
+
+static void testMalformedDeltas() {
+    std::vector<uint8_t> data = std::vector<uint8_t>(16, 0x00);
+    // Changed run past the end of the data
+    CHECK(!Common::Delta::apply({ 0x0C, 0x08, 1, 2, 3, 4, 5, 6, 7, 8 }, data.data(), data.size()));
+    // Fewer changed bytes than announced
+    CHECK(!Common::Delta::apply({ 0x00, 0x04, 1, 2 }, data.data(), data.size()));
+    // Length that never terminates
+    CHECK(!Common::Delta::apply({ 0x80, 0x80 }, data.data(), data.size()));
+}
+
+// The rewind buffer zero pads the shorter of two states, the delta has to
+// bring back the longer one in full
+static void testPaddedLengths() {
+    uint32_t seed = 0x4321;
+    std::vector<uint8_t> delta;
+    std::vector<uint8_t> shorter = std::vector<uint8_t>(300);
+    for (uint8_t &byte : shorter) {
+        byte = nextByte(seed);
+    }
+    std::vector<uint8_t> longer = shorter;
+    for (size_t extra = 0; extra < 45; extra++) {
+        longer.push_back(nextByte(seed));
+    }
+    longer[5] ^= 0x10;
+    std::vector<uint8_t> padded = shorter;
+    padded.resize(longer.size());
+    checkRoundTrip(padded, longer, delta);
+    std::vector<uint8_t> restored = longer;
+    CHECK(Common::Delta::apply(delta, restored.data(), restored.size()));
+    restored.resize(shorter.size());
+    CHECK(restored == shorter);
+}
+
+int main() {
+    testIdenticalBuffers();
+    testRandomEdits();
+    testUnchangedGaps();
+    testLengthEncodingBoundaries();
+    testMalformedDeltas();
+    testPaddedLengths();
+    return 0;
+}
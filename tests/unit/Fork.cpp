@@ -0,0 +1,125 @@
+#include "Test.hpp"
+
+// Writes INC B and RET to $C000 and keeps calling it, flipping the opcode
+// between INC B and INC C after every call and storing B and C to $C200.
+// B stays equal to C or one ahead, unless a block decoded before the flip
+// gets executed again.
+static const std::vector<uint8_t> SelfModifyingProgram = {
+    0xF3,             // DI
+    0x31, 0xFE, 0xDF, // LD SP,$DFFE
+    0x21, 0x00, 0xC0, // LD HL,$C000
+    0x36, 0x04,       // LD (HL),$04
+    0x2C,             // INC L
+    0x36, 0xC9,       // LD (HL),$C9
+    0x01, 0x00, 0x00, // LD BC,$0000
+    0xCD, 0x00, 0xC0, // CALL $C000
+    0x21, 0x00, 0xC0, // LD HL,$C000
+    0x7E,             // LD A,(HL)
+    0xEE, 0x08,       // XOR $08
+    0x77,             // LD (HL),A
+    0x21, 0x00, 0xC2, // LD HL,$C200
+    0x70,             // LD (HL),B
+    0x2C,             // INC L
+    0x71,             // LD (HL),C
+    0x18, 0xEE,       // JR -18
+};
+
+static uint8_t load(Core::Machine::Machine &machine, uint16_t address) {
+    return machine.getMemoryController()->load(address, false);
+}
+
+static void store(Core::Machine::Machine &machine, uint16_t address, uint8_t value) {
+    machine.getMemoryController()->store(address, value, false);
+}
+
+static void runFrames(Core::Machine::Machine &machine, uint32_t frames) {
+    for (uint32_t frame = 0; frame < frames; frame++) {
+        machine.runFrame();
+    }
+}
+
+// Writes on either side, direct or through echo RAM, stay on that side
+static void testCopyOnWrite() {
+    std::unique_ptr<Core::Machine::Machine> parent = Test::makeMachine("fork-copy-on-write", Test::CounterProgram);
+    runFrames(*parent, 5);
+    store(*parent, 0xD123, 0x11);
+    std::unique_ptr<Core::Machine::Machine> child = parent->fork();
+    CHECK(Test::saveState(*child) == Test::saveState(*parent));
+    CHECK(load(*child, 0xD123) == 0x11);
+
+    store(*child, 0xD123, 0x22);
+    store(*child, 0xE140, 0x33);
+    CHECK(load(*child, 0xD123) == 0x22);
+    CHECK(load(*child, 0xC140) == 0x33);
+    CHECK(load(*parent, 0xD123) == 0x11);
+    CHECK(load(*parent, 0xF123) == 0x11);
+    CHECK(load(*parent, 0xC140) == 0x00);
+
+    store(*parent, 0xD124, 0x44);
+    CHECK(load(*parent, 0xD124) == 0x44);
+    CHECK(load(*child, 0xD124) == 0x00);
+}
+
+// Both sides keep running the same code on their own copy of the pages
+static void testIndependentExecution() {
+    std::unique_ptr<Core::Machine::Machine> parent = Test::makeMachine("fork-execution", Test::CounterProgram);
+    runFrames(*parent, 3);
+    std::vector<uint8_t> page = std::vector<uint8_t>(0x100);
+    for (uint16_t offset = 0; offset < 0x100; offset++) {
+        page[offset] = load(*parent, 0xC000 + offset);
+    }
+    std::unique_ptr<Core::Machine::Machine> child = parent->fork();
+    std::unique_ptr<Core::Machine::Machine> sibling = parent->fork();
+    runFrames(*child, 10);
+    for (uint16_t offset = 0; offset < 0x100; offset++) {
+        CHECK(load(*parent, 0xC000 + offset) == page[offset]);
+    }
+    runFrames(*parent, 10);
+    CHECK(Test::saveState(*parent) == Test::saveState(*child));
+    runFrames(*sibling, 10);
+    CHECK(Test::saveState(*sibling) == Test::saveState(*parent));
+    CHECK(parent->getExecutedInstructions() == child->getExecutedInstructions());
+}
+
+static void checkAlternatingCalls(Core::Machine::Machine &machine) {
+    uint8_t B = load(machine, 0xC200);
+    uint8_t C = load(machine, 0xC201);
+    CHECK(B != 0 || C != 0);
+    CHECK(B == C || B == (uint8_t)(C + 1));
+}
+
+// The code page is shared when the fork happens and gets copied by the
+// first store of either side, blocks decoded before then must not be
+// executed again
+static void testSelfModifyingCode() {
+    std::unique_ptr<Core::Machine::Machine> parent = Test::makeMachine("fork-self-modifying", SelfModifyingProgram);
+    runFrames(*parent, 2);
+    checkAlternatingCalls(*parent);
+    std::unique_ptr<Core::Machine::Machine> child = parent->fork();
+    std::unique_ptr<Core::Machine::Machine> reference = parent->fork();
+
+    for (uint32_t frame = 0; frame < 3; frame++) {
+        runFrames(*child, 1);
+        checkAlternatingCalls(*child);
+        runFrames(*parent, 1);
+        checkAlternatingCalls(*parent);
+    }
+    CHECK(Test::saveState(*parent) == Test::saveState(*child));
+
+    // Flipping the parent's opcode out of turn only changes what the
+    // parent runs
+    store(*parent, 0xC000, load(*parent, 0xC000) ^ 0x08);
+    runFrames(*parent, 1);
+    runFrames(*child, 1);
+    checkAlternatingCalls(*child);
+    runFrames(*reference, 4);
+    CHECK(Test::saveState(*reference) == Test::saveState(*child));
+    CHECK(Test::saveState(*parent) != Test::saveState(*child));
+}
+
+int main() {
+    testCopyOnWrite();
+    testIndependentExecution();
+    testSelfModifyingCode();
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "Test.hpp"
+#include "core/Rewind.hpp"
+
+// Toggling the timer adds and removes its scheduler event, which changes
+// the length of the save state
+static void runFrame(Core::Machine::Machine &machine, uint32_t frame) {
+    machine.getMemoryController()->store(0xFF07, frame % 3 == 0 ? 0x05 : 0x00, false);
+    machine.runFrame();
+}
+
+// Every snapshot comes back in reverse order, across states of different
+// lengths
+static void testRewindOrder() {
+    std::unique_ptr<Core::Machine::Machine> machine = Test::makeMachine("rewind-order", Test::CounterProgram);
+    Core::Rewind::Buffer buffer = Core::Rewind::Buffer(Common::Logs::Level::NoLog, 1, 64 * 1024 * 1024);
+    std::vector<std::vector<uint8_t>> states;
+    size_t shortest = SIZE_MAX;
+    size_t longest = 0;
+    for (uint32_t frame = 0; frame < 30; frame++) {
+        runFrame(*machine, frame);
+        buffer.frame(*machine);
+        states.push_back(Test::saveState(*machine));
+        shortest = std::min(shortest, states.back().size());
+        longest = std::max(longest, states.back().size());
+    }
+    CHECK(shortest != longest);
+    CHECK(buffer.size() == states.size());
+    while (!states.empty()) {
+        CHECK(buffer.rewind(*machine));
+        CHECK(Test::saveState(*machine) == states.back());
+        states.pop_back();
+    }
+    CHECK(buffer.size() == 0);
+    CHECK(!buffer.rewind(*machine));
+}
+
+// Snapshots are only taken every interval frames
+static void testInterval() {
+    std::unique_ptr<Core::Machine::Machine> machine = Test::makeMachine("rewind-interval", Test::CounterProgram);
+    Core::Rewind::Buffer buffer = Core::Rewind::Buffer(Common::Logs::Level::NoLog, 4, 64 * 1024 * 1024);
+    std::vector<uint8_t> captured;
+    for (uint32_t frame = 1; frame <= 10; frame++) {
+        runFrame(*machine, frame);
+        buffer.frame(*machine);
+        if (frame == 8) {
+            captured = Test::saveState(*machine);
+        }
+    }
+    CHECK(buffer.size() == 2);
+    CHECK(buffer.rewind(*machine));
+    CHECK(Test::saveState(*machine) == captured);
+}
+
+// Once the budget is spent the oldest snapshots are dropped, the newest
+// ones keep rewinding correctly however many times the buffer wrapped
+static void testWraparound() {
+    std::unique_ptr<Core::Machine::Machine> machine = Test::makeMachine("rewind-wraparound", Test::CounterProgram);
+    runFrame(*machine, 1);
+    size_t capacity = Test::saveState(*machine).size() * 2;
+    Core::Rewind::Buffer buffer = Core::Rewind::Buffer(Common::Logs::Level::NoLog, 1, capacity);
+    std::vector<std::vector<uint8_t>> states;
+    size_t largest = 0;
+    for (uint32_t frame = 0; frame < 500; frame++) {
+        runFrame(*machine, frame);
+        buffer.frame(*machine);
+        states.push_back(Test::saveState(*machine));
+        CHECK(buffer.usedMemory() <= capacity);
+        largest = std::max(largest, buffer.size());
+    }
+    size_t kept = buffer.size();
+    CHECK(kept > 1);
+    CHECK(kept < states.size());
+    CHECK(largest < states.size());
+    for (size_t index = 0; index < kept; index++) {
+        CHECK(buffer.rewind(*machine));
+        CHECK(Test::saveState(*machine) == states[states.size() - 1 - index]);
+    }
+    CHECK(!buffer.rewind(*machine));
+
+    // Capturing again after running dry starts over from a full state
+    runFrame(*machine, 0);
+    buffer.frame(*machine);
+    std::vector<uint8_t> state = Test::saveState(*machine);
+    CHECK(buffer.size() == 1);
+    CHECK(buffer.rewind(*machine));
+    CHECK(Test::saveState(*machine) == state);
+}
+
+int main() {
+    testRewindOrder();
+    testInterval();
+    testWraparound();
+    return 0;
+}
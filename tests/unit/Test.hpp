@@ -0,0 +1,65 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/Machine.hpp"
+
+// Unit tests are plain programs, the first failed check prints its location
+// and exits with a non-zero status for CTest
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            exit(1); \
+        } \
+    } while (0)
+
+namespace Test {
+    const uint16_t ProgramAddress = 0x150;
+
+    // Increments every byte of the first WRAM page forever, so each frame
+    // leaves a different state behind
+    const std::vector<uint8_t> CounterProgram = {
+        0xF3,             // DI
+        0x31, 0xFE, 0xDF, // LD SP,$DFFE
+        0x21, 0x00, 0xC0, // LD HL,$C000
+        0x34,             // INC (HL)
+        0x2C,             // INC L
+        0x18, 0xFC,       // JR -4
+    };
+
+    // Writes a 32KB DMG cartridge without a mapper whose entry point jumps
+    // straight into program, to a file named after the test
+    static inline std::filesystem::path writeROM(const std::string &name, const std::vector<uint8_t> &program) {
+        std::vector<uint8_t> ROM = std::vector<uint8_t>(0x8000, 0x00);
+        ROM[0x101] = 0xC3;
+        ROM[0x102] = (uint8_t)ProgramAddress;
+        ROM[0x103] = (uint8_t)(ProgramAddress >> 8);
+        std::copy(program.begin(), program.end(), ROM.begin() + ProgramAddress);
+        std::filesystem::path filePath = std::filesystem::temp_directory_path() / ("shinobu-" + name + ".gb");
+        std::ofstream file = std::ofstream(filePath, std::ios::binary);
+        file.write(reinterpret_cast<const char *>(ROM.data()), ROM.size());
+        return filePath;
+    }
+
+    // Headless machine running program, without BOOT ROM nor audio output
+    static inline std::unique_ptr<Core::Machine::Machine> makeMachine(const std::string &name, const std::vector<uint8_t> &program, bool nullAudio = true) {
+        Core::Machine::Configuration configuration = Core::Machine::Configuration();
+        configuration.nullAudio = nullAudio;
+        std::unique_ptr<Core::Machine::Machine> machine = std::make_unique<Core::Machine::Machine>(configuration);
+        machine->load(writeROM(name, program), true);
+        return machine;
+    }
+
+    static inline std::vector<uint8_t> saveState(Core::Machine::Machine &machine) {
+        std::vector<uint8_t> state;
+        machine.saveState(state);
+        return state;
+    }
+};